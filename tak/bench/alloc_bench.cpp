@@ -0,0 +1,85 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <driver.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+//
+// Counts heap allocations made while lexing, parsing and checking a source file,
+// and times the whole thing. Used to judge changes to AST and type layouts.
+//
+// usage: tak_alloc_bench [source file] [iterations]
+//
+
+using namespace tak;
+
+
+static size_t allocation_count = 0;
+static size_t allocation_bytes = 0;
+
+
+void*
+operator new(const size_t size) {
+    ++allocation_count;
+    allocation_bytes += size;
+
+    if(void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const std::string source_file_name = argc > 1 ? argv[1] : "tests/test1.txt";
+    const int         iterations       = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10;
+
+    Samples             samples;
+    size_t              allocations = 0;
+    size_t              bytes       = 0;
+
+    samples.ms.reserve(iterations);
+    for(int i = 0; i < iterations; ++i) {
+
+        Parser parser;
+        Lexer  lexer;
+
+        if(!lexer.init(source_file_name)) {
+            return EXIT_FAILURE;
+        }
+
+        const size_t count_before = allocation_count;
+        const size_t bytes_before = allocation_bytes;
+        const auto   begin        = bench_clock::now();
+
+        if(!do_create_ast(parser, lexer)) {
+            return EXIT_FAILURE;
+        }
+
+        samples.ms.emplace_back(elapsed_ms(begin));
+        allocations = allocation_count - count_before;
+        bytes       = allocation_bytes - bytes_before;
+    }
+
+    print("allocations: {} ({} bytes)", allocations, bytes);
+    print("parse+check: {:.3f} ms (median of {})", samples.median(), iterations);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef BENCH_UTIL_HPP
+#define BENCH_UTIL_HPP
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <format>
+#include <numeric>
+#include <string>
+#include <vector>
+
+//
+// Timing and statistics shared by the benchmarks, and the programs more than one of them generates.
+//
+
+namespace tak {
+
+    using bench_clock = std::chrono::steady_clock;
+
+    inline double elapsed_ms(const bench_clock::time_point begin) {
+        return std::chrono::duration<double, std::milli>(bench_clock::now() - begin).count();
+    }
+
+    inline double elapsed_ns(const bench_clock::time_point begin) {
+        return std::chrono::duration<double, std::nano>(bench_clock::now() - begin).count();
+    }
+
+    struct Samples {
+        std::vector<double> ms;
+
+        double percentile(const double fraction) const { // Nearest rank, 0.5 is the median and 1.0 the maximum.
+            std::vector<double> sorted = ms;
+            std::ranges::sort(sorted);
+            const auto index = static_cast<size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+
+        double median() const {
+            return percentile(0.5);
+        }
+
+        double min() const {
+            return *std::ranges::min_element(ms);
+        }
+
+        double mean() const {
+            return std::accumulate(ms.begin(), ms.end(), 0.0) / static_cast<double>(ms.size());
+        }
+
+        double stddev() const {
+            const double avg = mean();
+            double       sum = 0.0;
+            for(const double sample : ms) sum += (sample - avg) * (sample - avg);
+            return ms.size() > 1 ? std::sqrt(sum / static_cast<double>(ms.size() - 1)) : 0.0;
+        }
+    };
+
+    inline std::string generate_compose_methods(const uint32_t methods) {
+
+        //
+        // A struct with [methods] compose methods, and a procedure that calls every one of them.
+        //
+
+        std::string src = "struct Obj {\n  value : i32;\n}\n\ncompose Obj {\n";
+        for(uint32_t i = 0; i < methods; ++i) {
+            src += std::format("  m{} :: proc(self : Obj^, a : i32) -> i32 {{ ret self.value + a; }}\n", i);
+        }
+
+        src += "}\n\nmain :: proc() -> i32 {\n  obj : Obj;\n  total : i32 = 0;\n";
+        for(uint32_t i = 0; i < methods; ++i) {
+            src += std::format("  total += obj.m{}({});\n", i, i);
+        }
+
+        src += "  ret total;\n}\n";
+        return src;
+    }
+}
+
+#endif //BENCH_UTIL_HPP
@@ -0,0 +1,341 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <driver.hpp>
+#include <cfg.hpp>
+#include <dataflow.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <unordered_map>
+
+//
+// Generates procedures with deeply nested control flow (branches, loops with brk/cont, switches with fallthrough,
+// early returns, dead code), then times building their CFGs, dominator and post-dominator trees, and a definite-initialization
+// dataflow problem over the locals declared without a value.
+//
+// Dominators are checked against the same relation computed the slow way, as a dataflow problem.
+//
+// usage: tak_cfg_bench [statements per procedure] [procedures] [iterations]
+//
+
+using namespace tak;
+
+
+#define CFG_BENCH_LOCALS    8
+#define CFG_BENCH_MAX_DEPTH 6
+#define CFG_BENCH_MAX_CHECK 2048 // The slow dominator check is quadratic, bigger procedures are only timed.
+
+
+
+//
+// Source generation.
+//
+
+struct SourceGenerator {
+    std::mt19937 rng{1234};
+    std::string  src;
+
+    uint32_t pick(const uint32_t bound) { return std::uniform_int_distribution<uint32_t>(0, bound - 1)(rng); }
+    void     indent(const uint32_t depth) { src.append(depth * 2 + 2, ' '); }
+
+    void gen_body(uint32_t depth, uint32_t count, bool in_while);
+    void gen_stmt(uint32_t depth, bool in_while);
+};
+
+void
+SourceGenerator::gen_body(const uint32_t depth, const uint32_t count, const bool in_while) {
+    for(uint32_t i = 0; i < count; ++i) {
+        gen_stmt(depth, in_while);
+    }
+}
+
+void
+SourceGenerator::gen_stmt(const uint32_t depth, const bool in_while) {
+
+    const uint32_t var   = pick(CFG_BENCH_LOCALS);
+    const uint32_t other = pick(CFG_BENCH_LOCALS);
+    const uint32_t kind  = depth >= CFG_BENCH_MAX_DEPTH ? 0 : pick(in_while ? 9 : 8);
+
+    indent(depth);
+    switch(kind) {
+        case 0:
+        case 1:
+            src += std::format("v{} = v{} + a;\n", var, other);
+            break;
+
+        case 2:
+            src += std::format("if a > {} {{\n", pick(100));
+            gen_body(depth + 1, 1 + pick(3), false);
+            indent(depth);
+            src += std::format("}} elif v{} == {} {{\n", other, pick(100));
+            gen_body(depth + 1, 1 + pick(2), false);
+            indent(depth);
+            src += "} else {\n";
+            gen_body(depth + 1, 1 + pick(2), false);
+            indent(depth);
+            src += "}\n";
+            break;
+
+        case 3:
+            src += std::format("while v{} < {} {{\n", var, pick(100));
+            gen_body(depth + 1, 1 + pick(3), true);
+            indent(depth + 1);
+            src += pick(2) == 0 ? "brk;\n" : "cont;\n";
+            indent(depth);
+            src += "}\n";
+            break;
+
+        case 4:
+            src += std::format("for i : i32 = 0; i < a; i += 1 {{\n");
+            gen_body(depth + 1, 1 + pick(3), false);
+            indent(depth);
+            src += "}\n";
+            break;
+
+        case 5:
+            src += "do {\n";
+            gen_body(depth + 1, 1 + pick(3), false);
+            indent(depth);
+            src += std::format("}} while v{} < {};\n", var, pick(100));
+            break;
+
+        case 6:
+            src += "switch a {\n";
+            for(uint32_t i = 0, cases = 1 + pick(4); i < cases; ++i) {
+                indent(depth + 1);
+                src += std::format("{} {} {{\n", pick(3) == 0 ? "fallthrough" : "case", i);
+                gen_body(depth + 2, 1 + pick(2), false);
+                indent(depth + 1);
+                src += "}\n";
+            }
+
+            indent(depth + 1);
+            src += "default {\n";
+            gen_body(depth + 2, 1, false);
+            indent(depth + 1);
+            src += "}\n";
+
+            indent(depth);
+            src += "}\n";
+            break;
+
+        case 7:
+            src += std::format("if v{} == {} {{ ret v{}; }}\n", var, pick(100), other);
+            break;
+
+        default:
+            src += "brk;\n"; // Only allowed directly inside a while body, anything after it is dead.
+            break;
+    }
+}
+
+static std::string
+generate_source(const uint32_t statements, const uint32_t procedures) {
+
+    SourceGenerator gen;
+    for(uint32_t i = 0; i < procedures; ++i) {
+        gen.src += std::format("p{} :: proc(a : i32) -> i32 {{\n", i);
+        for(uint32_t j = 0; j < CFG_BENCH_LOCALS; ++j) {
+            gen.src += j % 2 == 0 ? std::format("  v{} : i32;\n", j) : std::format("  v{} : i32 = {};\n", j, j);
+        }
+
+        gen.gen_body(0, statements, false);
+        gen.src += "  ret v0;\n}\n\n";
+    }
+
+    return gen.src;
+}
+
+
+//
+// Definite initialization: which of the locals declared without a value are assigned on every path.
+//
+
+struct InitProblem {
+    std::unordered_map<uint32_t, size_t> bits;    // Symbol index to bit.
+    DataflowProblem                      problem;
+};
+
+static std::optional<uint32_t>
+assigned_symbol(const AstNode* node) {
+
+    if(const auto* binexpr = dynamic_cast<const AstBinexpr*>(node)) {
+        if(binexpr->_operator == TOKEN_VALUE_ASSIGNMENT && binexpr->left_op->type == NODE_IDENT) {
+            return dynamic_cast<const AstIdentifier*>(binexpr->left_op)->symbol_index;
+        }
+    }
+
+    return std::nullopt;
+}
+
+static InitProblem
+make_init_problem(const ControlFlowGraph& cfg, Parser& parser) {
+
+    InitProblem init;
+    for(const AstNode* node : cfg.proc->body) {
+        if(const auto* decl = dynamic_cast<const AstVardecl*>(node)) {
+            const auto* sym = parser.lookup_unique_symbol(decl->identifier->symbol_index);
+            if(!decl->init_value && sym->type.flags & TYPE_UNINITIALIZED) {
+                init.bits.emplace(sym->symbol_index, init.bits.size());
+            }
+        }
+    }
+
+    init.problem = make_dataflow_problem(cfg, DATAFLOW_FORWARD, DATAFLOW_INTERSECTION, init.bits.size());
+    for(uint32_t block = 0; block < cfg.blocks.size(); ++block) {
+        for(const AstNode* node : cfg.blocks[block].nodes) {
+            const auto symbol = assigned_symbol(node);
+            const auto bit    = symbol ? init.bits.find(*symbol) : init.bits.end();
+            if(bit != init.bits.end()) {
+                init.problem.gen[block].set(bit->second);
+            }
+        }
+    }
+
+    return init;
+}
+
+
+//
+// The slow way: a block's dominators are itself plus whatever dominates all of its predecessors.
+//
+
+static bool
+check_dominators(const ControlFlowGraph& cfg, const DominatorTree& tree, const bool post) {
+
+    auto problem = make_dataflow_problem(cfg, post ? DATAFLOW_BACKWARD : DATAFLOW_FORWARD, DATAFLOW_INTERSECTION, cfg.blocks.size());
+    for(uint32_t block = 0; block < cfg.blocks.size(); ++block) {
+        problem.gen[block].set(block);
+    }
+
+    const auto     result = solve_dataflow(cfg, problem);
+    const uint32_t root   = post ? CFG_EXIT_BLOCK : CFG_ENTRY_BLOCK;
+
+    for(const uint32_t block : cfg.reverse_postorder) {
+        if(post && tree.preorder[block] == INVALID_BLOCK_ID) {
+            continue; // Never reaches the exit.
+        }
+
+        const auto& expected = post ? result.in[block] : result.out[block];
+        for(const uint32_t dominator : cfg.reverse_postorder) {
+            if(post && tree.preorder[dominator] == INVALID_BLOCK_ID && dominator != root) {
+                continue;
+            }
+
+            if(expected.test(dominator) != tree.dominates(dominator, block)) {
+                print("MISMATCH: {}dominance of block {} over block {} in procedure {}.",
+                    post ? "post-" : "", dominator, block, cfg.proc->identifier->symbol_index);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const uint32_t statements = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20;
+    const uint32_t procedures = argc > 2 ? std::max(1, std::atoi(argv[2])) : 100;
+    const int      iterations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+
+    const auto path = std::filesystem::temp_directory_path() / "tak_cfg_bench.tak";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << generate_source(statements, procedures);
+    }
+
+    Parser parser;
+    Lexer  lexer;
+
+    if(!lexer.init(path.string()) || !do_parse(parser, lexer)) {
+        return EXIT_FAILURE;
+    }
+
+    std::vector<const AstProcdecl*> procs;
+    for(const AstNode* decl : parser.toplevel_decls_) {
+        if(const auto* proc = dynamic_cast<const AstProcdecl*>(decl)) {
+            procs.emplace_back(proc);
+        }
+    }
+
+
+    //
+    // Check everything once, then time it.
+    //
+
+    bool     consistent  = true;
+    size_t   num_blocks  = 0;
+    size_t   unreachable = 0;
+    uint32_t uninit      = 0;
+    uint32_t checked     = 0;
+
+    for(const auto* proc : procs) {
+        const auto cfg = build_cfg(proc);
+        num_blocks    += cfg.blocks.size();
+        unreachable   += cfg.blocks.size() - cfg.reverse_postorder.size();
+
+        if(cfg.blocks.size() <= CFG_BENCH_MAX_CHECK) {
+            consistent = consistent
+                && check_dominators(cfg, compute_dominators(cfg), false)
+                && check_dominators(cfg, compute_post_dominators(cfg), true);
+            ++checked;
+        }
+
+        const auto init   = make_init_problem(cfg, parser);
+        const auto result = solve_dataflow(cfg, init.problem);
+        uninit += static_cast<uint32_t>(init.bits.size() - result.in[CFG_EXIT_BLOCK].count());
+    }
+
+    print("procedures: {} ({} checked), blocks: {} ({} unreachable), locals not always initialized at exit: {}",
+        procs.size(), checked, num_blocks, unreachable, uninit);
+
+    Samples  build, dominators, post_dominators, dataflow;
+    uint64_t visits = 0;
+
+    for(int i = 0; i < iterations; ++i) {
+        std::vector<ControlFlowGraph> cfgs;
+        cfgs.reserve(procs.size());
+
+        auto begin = bench_clock::now();
+        for(const auto* proc : procs) cfgs.emplace_back(build_cfg(proc));
+        build.ms.emplace_back(elapsed_ms(begin));
+
+        begin = bench_clock::now();
+        for(const auto& cfg : cfgs) compute_dominators(cfg);
+        dominators.ms.emplace_back(elapsed_ms(begin));
+
+        begin = bench_clock::now();
+        for(const auto& cfg : cfgs) compute_post_dominators(cfg);
+        post_dominators.ms.emplace_back(elapsed_ms(begin));
+
+        std::vector<InitProblem> problems;
+        for(const auto& cfg : cfgs) problems.emplace_back(make_init_problem(cfg, parser));
+
+        begin  = bench_clock::now();
+        visits = 0;
+        for(size_t j = 0; j < cfgs.size(); ++j) visits += solve_dataflow(cfgs[j], problems[j].problem).visits;
+        dataflow.ms.emplace_back(elapsed_ms(begin));
+    }
+
+    print("cfg:             {:.3f} ms", build.median());
+    print("dominators:      {:.3f} ms", dominators.median());
+    print("post-dominators: {:.3f} ms", post_dominators.median());
+    print("dataflow:        {:.3f} ms ({:.2f} visits per block)", dataflow.median(), static_cast<double>(visits) / num_blocks);
+
+    std::filesystem::remove(path);
+    if(!consistent) {
+        return EXIT_FAILURE;
+    }
+
+    print("consistency: OK");
+    return EXIT_SUCCESS;
+}
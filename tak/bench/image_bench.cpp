@@ -0,0 +1,102 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <driver.hpp>
+#include <image.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+
+//
+// Compares how long it takes to load a source file's module image against lexing, parsing and
+// checking the source again. The image goes to a temporary file, tak_image_test checks that it
+// round-trips.
+//
+// usage: tak_image_bench [source file] [iterations]
+//
+
+using namespace tak;
+
+
+static bool
+build_image(const std::string& source_file_name, const std::string& image_path, uint64_t& source_hash) {
+
+    Parser parser;
+    Lexer  lexer;
+
+    if(!lexer.init(source_file_name) || !do_create_ast(parser, lexer)) {
+        return false;
+    }
+
+    source_hash = hash_source({lexer.src_.data(), lexer.src_.size()});
+    if(!write_image_file(parser, source_hash, image_path)) {
+        print("failed to write module image \"{}\".", image_path);
+        return false;
+    }
+
+    return true;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const std::string source_file_name = argc > 1 ? argv[1] : "tests/test1.txt";
+    const int         iterations       = argc > 2 ? std::max(1, std::atoi(argv[2])) : 20;
+    const std::string image_path       = (std::filesystem::temp_directory_path() / "tak_image_bench.timg").string();
+    uint64_t          source_hash      = 0;
+
+    const auto cleanup = [&] {
+        std::error_code ec;
+        std::filesystem::remove(image_path, ec);
+    };
+
+    if(!build_image(source_file_name, image_path, source_hash)) {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    Samples reparse_samples;
+    Samples load_samples;
+
+    for(int i = 0; i < iterations; ++i) {
+        const auto begin = bench_clock::now();
+
+        Parser parser;
+        Lexer  lexer;
+        if(!lexer.init(source_file_name) || !do_create_ast(parser, lexer)) {
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        reparse_samples.ms.emplace_back(elapsed_ms(begin));
+    }
+
+    for(int i = 0; i < iterations; ++i) {
+        const auto begin = bench_clock::now();
+
+        Parser loaded;
+        Lexer  lexer;
+        if(!lexer.init(source_file_name)
+            || !load_image_file(image_path, hash_source({lexer.src_.data(), lexer.src_.size()}), loaded)) {
+            print("failed to load module image \"{}\".", image_path);
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        load_samples.ms.emplace_back(elapsed_ms(begin));
+    }
+
+    cleanup();
+
+    const double reparse = reparse_samples.median();
+    const double load    = load_samples.median();
+
+    print("reparse: {:.3f} ms (median of {})", reparse, iterations);
+    print("load:    {:.3f} ms (median of {})", load, iterations);
+    print("speedup: {:.2f}x", load > 0.0 ? reparse / load : 0.0);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <incremental.hpp>
+#include <io.hpp>
+#include <cstdlib>
+
+//
+// Builds a source file, edits one integer literal inside the declaration in the middle
+// of the file, then compares an incremental rebuild against building the edited source from scratch.
+//
+// usage: tak_incremental_bench [source file]
+//
+
+using namespace tak;
+
+
+static bool
+edit_middle_decl(const IncrementalUnit& unit, Lexer& lexer) {
+
+    //
+    // Bumping the literal by a digit also shifts every declaration after it.
+    //
+
+    const size_t mid   = unit.records_.size() / 2;
+    const size_t begin = unit.records_[mid].begin;
+    const size_t end   = mid + 1 < unit.records_.size() ? unit.records_[mid + 1].begin : lexer.src_.size();
+
+    lexer.current_   = Token();
+    lexer.src_index_ = begin;
+    lexer.curr_line_ = unit.records_[mid].line;
+
+    while(lexer.current() != TOKEN_END_OF_FILE && lexer.current().src_pos < end) {
+        if(lexer.current() == TOKEN_INTEGER_LITERAL) {
+            const size_t pos = lexer.current().src_pos + lexer.current().value.size();
+            lexer.src_.insert(lexer.src_.begin() + static_cast<std::ptrdiff_t>(pos), '1');
+            return true;
+        }
+
+        lexer.advance(1);
+    }
+
+    return false;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const std::string source_file_name = argc > 1 ? argv[1] : "tests/test1.txt";
+
+    IncrementalUnit unit;
+    Lexer           lexer;
+
+    if(!lexer.init(source_file_name) || !incremental_build(unit, lexer) || unit.records_.empty()) {
+        return EXIT_FAILURE;
+    }
+
+    print("initial build: {} toplevel decls", unit.records_.size());
+
+    Lexer edited;
+    edited.source_file_name_ = source_file_name;
+    edited.src_              = lexer.src_;
+
+    if(!edit_middle_decl(unit, edited)) {
+        print("no integer literal found in declaration #{}.", unit.records_.size() / 2);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<char> edited_src = std::move(edited.src_);
+
+
+    //
+    // Incremental rebuild, then the same source from scratch.
+    //
+
+    Lexer rebuild;
+    rebuild.source_file_name_ = source_file_name;
+    rebuild.src_              = edited_src;
+
+    auto         begin             = bench_clock::now();
+    const bool   incremental_state = incremental_build(unit, rebuild);
+    const double incremental_ms    = elapsed_ms(begin);
+
+    IncrementalUnit full;
+    Lexer           full_lexer;
+    full_lexer.source_file_name_ = source_file_name;
+    full_lexer.src_              = edited_src;
+
+    begin                   = bench_clock::now();
+    const bool   full_state = incremental_build(full, full_lexer);
+    const double full_ms    = elapsed_ms(begin);
+
+    const auto& stats = unit.stats_;
+    print("reused: {}, reparsed: {}, invalidated: {}, dropped: {}", stats.reused, stats.reparsed, stats.invalidated, stats.dropped);
+    print("incremental: {:.3f} ms", incremental_ms);
+    print("full:        {:.3f} ms", full_ms);
+    print("speedup:     {:.2f}x", incremental_ms > 0.0 ? full_ms / incremental_ms : 0.0);
+
+    if(incremental_state != full_state
+        || unit.parser_.toplevel_decls_.size() != full.parser_.toplevel_decls_.size()
+        || unit.parser_.sym_table_.size() != full.parser_.sym_table_.size()
+        || unit.parser_.type_table_.size() != full.parser_.type_table_.size()) {
+        print("MISMATCH: incremental rebuild does not agree with a full build.");
+        return EXIT_FAILURE;
+    }
+
+    print("consistency: OK");
+    return EXIT_SUCCESS;
+}
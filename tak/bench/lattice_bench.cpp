@@ -0,0 +1,75 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include "lattice_reference.hpp"
+#include <type_lattice.hpp>
+#include <io.hpp>
+#include <cstdlib>
+
+//
+// Times the primitive type lattice against the branch logic it replaced, over every pair of concrete,
+// non-pointer primitives. That the two agree is checked by tak_lattice_test.
+//
+// usage: tak_lattice_bench [iterations]
+//
+
+using namespace tak;
+
+
+template<typename F>
+static double
+time_queries(const std::vector<TypeData>& operands, const int iterations, F&& query) {
+
+    uint64_t   sink  = 0;
+    const auto begin = bench_clock::now();
+
+    for(int i = 0; i < iterations; ++i) {
+        for(const auto& left : operands) {
+            for(const auto& right : operands) {
+                sink += query(left, right);
+            }
+        }
+    }
+
+    const double elapsed = elapsed_ns(begin);
+    if(sink == UINT64_MAX) print("");  // Keeps the queries from being optimized out.
+
+    return elapsed / (static_cast<double>(iterations) * operands.size() * operands.size());
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const int  iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 200;
+    const auto operands   = reference::make_operands();
+
+
+    //
+    // Only concrete, non-pointer operands, the case the tables actually answer.
+    //
+
+    std::vector<TypeData> primitives;
+    for(const auto& operand : operands) {
+        if(operand.pointer_depth == 0 && !(operand.flags & TYPE_NON_CONCRETE) && reference::has_size(std::get<var_t>(operand.name))) {
+            primitives.emplace_back(operand);
+        }
+    }
+
+    const double old_ns = time_queries(primitives, iterations, [](const TypeData& left, const TypeData& right) {
+        TypeData copy = left;
+        return reference::coercion_permissible(copy, right).value_or(false) + reference::operator_applicable(TOKEN_PLUSEQ, right).value_or(false);
+    });
+
+    const double new_ns = time_queries(primitives, iterations, [](const TypeData& left, const TypeData& right) {
+        TypeData copy = left;
+        return is_type_coercion_permissible(copy, right) + can_operator_be_applied_to(TOKEN_PLUSEQ, right);
+    });
+
+    print("branches: {:.2f} ns per query", old_ns);
+    print("lattice:  {:.2f} ns per query", new_ns);
+    print("speedup:  {:.2f}x", new_ns > 0.0 ? old_ns / new_ns : 0.0);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,348 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include "program_gen.hpp"
+#include <lsp.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+//
+// Replays an editing session against a language server in this process and reports how long every
+// message took to handle, grouped by method. didChange is a keystroke, and the bench fails if the
+// 95th percentile of those goes over [budget ms] (50 by default, meant for optimized builds).
+//
+// Without a session file, one is made up: a generated program of [lines] lines (50'000 by default)
+// is opened, a statement gets typed one character at a time into a procedure in the middle of it
+// and then deleted again, with hovers, go to definitions and document symbol requests in between.
+// Sessions recorded with "tak-lsp --record <path>" can be replayed as they are.
+//
+// Afterwards every document that's still open is opened again in a fresh server, and the
+// diagnostics and document symbols of both have to agree.
+//
+// usage: tak_lsp_bench [lines] [budget ms]
+//        tak_lsp_bench --replay <session.jsonl> [budget ms]
+//        tak_lsp_bench --save <session.jsonl> [lines]
+//
+
+using namespace tak;
+
+
+//
+// Making up a session
+//
+
+struct SessionWriter {
+    std::vector<std::string> messages;
+    uint32_t                 next_id = 1;
+    int64_t                  version = 1;
+    std::string              uri;
+
+    void request(const std::string_view method, const std::string& params) {
+        messages.emplace_back(fmt("{{\"jsonrpc\":\"2.0\",\"id\":{},\"method\":\"{}\",\"params\":{}}}", next_id++, method, params));
+    }
+
+    void notify(const std::string_view method, const std::string& params) {
+        messages.emplace_back(fmt("{{\"jsonrpc\":\"2.0\",\"method\":\"{}\",\"params\":{}}}", method, params));
+    }
+
+    std::string document() const {
+        std::string out = "{\"uri\":";
+        append_json_string(out, uri);
+        out += '}';
+        return out;
+    }
+
+    void change(const size_t line, const size_t character, const size_t end_line, const size_t end_character, const std::string_view text) {
+        std::string params = fmt("{{\"textDocument\":{{\"uri\":\"{}\",\"version\":{}}},\"contentChanges\":[{{\"range\":"
+            "{{\"start\":{{\"line\":{},\"character\":{}}},\"end\":{{\"line\":{},\"character\":{}}}}},\"text\":",
+            uri, ++version, line, character, end_line, end_character);
+
+        append_json_string(params, text);
+        params += "}]}";
+        notify("textDocument/didChange", params);
+    }
+
+    void query(const std::string_view method, const size_t line, const size_t character) {
+        request(method, fmt("{{\"textDocument\":{},\"position\":{{\"line\":{},\"character\":{}}}}}", document(), line, character));
+    }
+};
+
+static size_t
+line_of(const std::string& text, const size_t offset) {
+    return static_cast<size_t>(std::count(text.begin(), text.begin() + static_cast<std::ptrdiff_t>(offset), '\n'));
+}
+
+static std::vector<std::string>
+make_session(const uint64_t lines) {
+
+    ProgramShape shape;
+    shape.lines = lines;
+
+    const std::string  text  = generate_program(shape);
+    const uint64_t     units = std::max<uint64_t>(1, (lines + lines_per_unit(shape) - 1) / lines_per_unit(shape));
+    const uint64_t     mid   = units / 2;
+    const std::string  proc  = fmt("run{} :: proc", mid);
+
+    const size_t proc_pos  = text.find(proc);
+    const size_t hover_pos = text.find("  v.x = ", proc_pos);
+    const size_t call_pos  = text.find("  v.y = ", proc_pos);
+    const size_t type_pos  = text.find('\n', text.find("  total : i32 = 0;", proc_pos)) + 1;
+
+    SessionWriter session;
+    session.uri = "file:///bench/session.tak";
+
+    session.request("initialize", "{\"processId\":null,\"rootUri\":null,\"capabilities\":{}}");
+    session.notify("initialized", "{}");
+
+    std::string open = "{\"textDocument\":{\"uri\":\"file:///bench/session.tak\",\"languageId\":\"tak\",\"version\":1,\"text\":";
+    append_json_string(open, text);
+    open += "}}";
+    session.notify("textDocument/didOpen", open);
+    session.request("textDocument/documentSymbol", fmt("{{\"textDocument\":{}}}", session.document()));
+
+
+    //
+    // Type the statement, then delete it again from the back.
+    //
+
+    static constexpr std::string_view statement = "  total += v.x * 2 + mod0\\add(v.y, n);\n";
+
+    const size_t hover_line = line_of(text, hover_pos);
+    const size_t call_line  = line_of(text, call_pos);
+
+    std::vector<std::pair<size_t, size_t>> typed;
+    size_t line      = line_of(text, type_pos);
+    size_t character = 0;
+
+    const auto queries = [&](const size_t keystroke) {
+        if(keystroke % 5 == 0)  session.query("textDocument/hover", hover_line, 2);
+        if(keystroke % 10 == 0) session.query("textDocument/definition", call_line, 10);
+        if(keystroke % 20 == 0) session.request("textDocument/documentSymbol", fmt("{{\"textDocument\":{}}}", session.document()));
+    };
+
+    size_t keystroke = 0;
+    for(const char c : statement) {
+        session.change(line, character, line, character, std::string_view(&c, 1));
+        typed.emplace_back(line, character);
+        if(c == '\n') {
+            ++line;
+            character = 0;
+        } else {
+            ++character;
+        }
+
+        queries(++keystroke);
+    }
+
+    for(size_t i = typed.size(); i > 0; --i) {
+        session.change(typed[i - 1].first, typed[i - 1].second, line, character, "");
+        line      = typed[i - 1].first;
+        character = typed[i - 1].second;
+        queries(++keystroke);
+    }
+
+    session.request("shutdown", "null");
+    session.notify("exit", "null");
+    return session.messages;
+}
+
+
+//
+// Replaying it
+//
+
+static std::string
+method_of(const std::string& message) {
+    const auto parsed = parse_json(message);
+    return parsed ? std::string((*parsed)["method"].as_string()) : std::string("<invalid>");
+}
+
+static std::string
+published_diagnostics(const std::vector<std::string>& replies, const std::string& uri) {
+
+    //
+    // The last publishDiagnostics for uri, without the version.
+    //
+
+    for(auto it = replies.rbegin(); it != replies.rend(); ++it) {
+        const auto parsed = parse_json(*it);
+        if(!parsed || (*parsed)["method"].as_string() != "textDocument/publishDiagnostics") {
+            continue;
+        }
+
+        const auto& params = (*parsed)["params"];
+        if(params["uri"].as_string() == uri) {
+            return json_to_string(params["diagnostics"]);
+        }
+    }
+
+    return "";
+}
+
+static std::string
+symbols_of(LspServer& server, const std::string& uri) {
+
+    std::string request = "{\"jsonrpc\":\"2.0\",\"id\":0,\"method\":\"textDocument/documentSymbol\",\"params\":{\"textDocument\":{\"uri\":";
+    append_json_string(request, uri);
+    request += "}}}";
+
+    std::vector<std::string> replies;
+    server.handle(request, replies);
+    return replies.empty() ? "" : replies.back();
+}
+
+static bool
+verify_documents(LspServer& server, const std::vector<std::string>& uris, const std::vector<std::string>& replies) {
+
+    for(const auto& uri : uris) {
+        const LspDocument* doc = server.find_document(uri);
+        if(doc == nullptr) {
+            continue;
+        }
+
+        LspServer                fresh;
+        std::vector<std::string> fresh_replies;
+        std::string              open = "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":";
+
+        append_json_string(open, uri);
+        open += ",\"version\":0,\"text\":";
+        append_json_string(open, doc->text);
+        open += "}}}";
+        fresh.handle(open, fresh_replies);
+
+        if(published_diagnostics(replies, uri) != published_diagnostics(fresh_replies, uri)) {
+            print("MISMATCH: diagnostics for {} differ from a fresh server.", uri);
+            return false;
+        }
+
+        if(symbols_of(server, uri) != symbols_of(fresh, uri)) {
+            print("MISMATCH: document symbols for {} differ from a fresh server.", uri);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    std::vector<std::string> session;
+    uint64_t                 lines  = 50'000;
+    double                   budget = 50.0;
+
+    if(argc > 2 && std::string_view(argv[1]) == "--save") {
+        lines = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : lines;
+
+        std::ofstream out(argv[2], std::ios::binary | std::ios::trunc);
+        for(const auto& message : make_session(lines)) {
+            out << message << '\n';
+        }
+
+        return out.good() ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if(argc > 2 && std::string_view(argv[1]) == "--replay") {
+        std::ifstream in(argv[2], std::ios::binary);
+        if(!in.is_open()) {
+            print("Failed to open {}.", argv[2]);
+            return EXIT_FAILURE;
+        }
+
+        for(std::string line; std::getline(in, line);) {
+            if(!line.empty()) session.emplace_back(std::move(line));
+        }
+
+        budget = argc > 3 ? std::strtod(argv[3], nullptr) : budget;
+    }
+    else {
+        lines   = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : lines;
+        budget  = argc > 2 ? std::strtod(argv[2], nullptr) : budget;
+        session = make_session(lines);
+    }
+
+
+    //
+    // Only the server's handling of a message is timed, not reading the session.
+    // Shutting down waits until the documents have been compared.
+    //
+
+    std::ostringstream discarded;
+    redirect_output(&discarded);
+
+    LspServer                                  server;
+    std::vector<std::string>                   replies;
+    std::vector<std::string>                   all_replies;
+    std::vector<std::string>                   uris;
+    std::vector<std::string>                   shutdown;
+    std::map<std::string, Samples>             samples;
+
+    for(const auto& message : session) {
+        const std::string method = method_of(message);
+        if(method == "shutdown" || method == "exit") {
+            shutdown.emplace_back(message);
+            continue;
+        }
+
+        if(method == "textDocument/didOpen") {
+            const auto parsed = parse_json(message);
+            uris.emplace_back((*parsed)["params"]["textDocument"]["uri"].as_string());
+        }
+
+        replies.clear();
+        const auto begin = bench_clock::now();
+        server.handle(message, replies);
+        samples[method].ms.emplace_back(elapsed_ms(begin));
+
+        for(auto& reply : replies) {
+            all_replies.emplace_back(std::move(reply));
+        }
+
+        discarded.str(std::string());
+    }
+
+    const bool consistent = verify_documents(server, uris, all_replies);
+    for(const auto& message : shutdown) {
+        server.handle(message, replies);
+    }
+
+    redirect_output(nullptr);
+
+
+    //
+    // Report
+    //
+
+    print("{} messages", session.size());
+    print("{:<32} {:>7} {:>10} {:>10} {:>10}", "method", "count", "p50 ms", "p95 ms", "max ms");
+    for(const auto& [method, times] : samples) {
+        print("{:<32} {:>7} {:>10.3f} {:>10.3f} {:>10.3f}", method, times.ms.size(), times.median(), times.percentile(0.95), times.percentile(1.0));
+    }
+
+    const auto keystrokes = samples.find("textDocument/didChange");
+    if(keystrokes != samples.end()) {
+        const auto over = std::ranges::count_if(keystrokes->second.ms, [&](const double ms) { return ms > budget; });
+        print("keystrokes over {:.1f} ms: {} of {}", budget, over, keystrokes->second.ms.size());
+    }
+
+    if(!consistent) {
+        return EXIT_FAILURE;
+    }
+
+    print("consistency: OK");
+
+    if(keystrokes != samples.end() && keystrokes->second.percentile(0.95) > budget) {
+        print("FAILED: keystroke p95 is over the {:.1f} ms budget.", budget);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <driver.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+//
+// Generates a struct with a growing number of compose methods plus a procedure that calls each one,
+// then times parsing and checking it. Also times resolving every member name through the type's
+// member table against scanning the member list, which is what lookups used to do, and checks that
+// both find the same member for every name, and nothing for a name that isn't a member.
+//
+// usage: tak_method_bench [max methods] [iterations]
+//
+
+using namespace tak;
+
+
+static const MemberData*
+scan_members(const UserType& type, const std::string& name) {
+    for(const auto& member : type.members) {
+        if(member.name == name) return &member;
+    }
+
+    return nullptr;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const uint32_t max_methods = argc > 1 ? std::max(1, std::atoi(argv[1])) : 4000;
+    const int      iterations  = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+    const auto     path        = std::filesystem::temp_directory_path() / "tak_method_bench.tak";
+
+    for(uint32_t methods = std::min<uint32_t>(max_methods, 250); methods <= max_methods; methods *= 2) {
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << generate_compose_methods(methods);
+        }
+
+        Samples build, table, scan;
+        for(int i = 0; i < iterations; ++i) {
+            Parser parser;
+            Lexer  lexer;
+
+            if(!lexer.init(path.string())) {
+                return EXIT_FAILURE;
+            }
+
+            auto begin = bench_clock::now();
+            if(!do_create_ast(parser, lexer)) {
+                std::filesystem::remove(path);
+                return EXIT_FAILURE;
+            }
+            build.ms.emplace_back(elapsed_ms(begin));
+
+            const UserType* type = parser.lookup_type("\\Obj");
+            std::vector<std::string> names;
+            for(const auto& member : type->members) names.emplace_back(member.name);
+            names.emplace_back("not_a_member");
+
+            size_t found = 0;
+            begin = bench_clock::now();
+            for(const auto& name : names) found += type->find_member(name) != nullptr;
+            table.ms.emplace_back(elapsed_ms(begin));
+
+            begin = bench_clock::now();
+            for(const auto& name : names) found -= scan_members(*type, name) != nullptr;
+            scan.ms.emplace_back(elapsed_ms(begin));
+
+            if(found != 0) {
+                print("MISMATCH: member table and member list find a different number of members.");
+                std::filesystem::remove(path);
+                return EXIT_FAILURE;
+            }
+
+            for(const auto& name : names) {
+                if(type->find_member(name) != scan_members(*type, name)) {
+                    print("MISMATCH: member table and member list disagree on \"{}\".", name);
+                    std::filesystem::remove(path);
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        print("{:>6} methods: parse + check {:>9.3f} ms, lookup all by table {:>7.3f} ms, by scan {:>9.3f} ms",
+            methods, build.median(), table.median(), scan.median());
+    }
+
+    std::filesystem::remove(path);
+    print("consistency: OK");
+    return EXIT_SUCCESS;
+}
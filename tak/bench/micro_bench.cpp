@@ -0,0 +1,234 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <driver.hpp>
+#include <checker.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+//
+// Microbenchmarks for the checker's inner loops, over type shapes taken from a real parsed program:
+// nested arrays, procedures with many parameters, and a chain of structs nested eight deep.
+//
+// Every benchmark body runs in batches that keep doubling until one batch takes [min ms], then five
+// batches of that size are timed and the median time per call is reported. Results are fed into a
+// volatile sink so the calls can't be optimized away.
+//
+// usage: tak_micro_bench [name filter] [min ms]
+//
+
+using namespace tak;
+
+
+struct Microbench {
+    std::string                         name;
+    std::function<uint64_t(uint64_t)>   run;  // Runs the body n times, returns something derived from the results.
+};
+
+static volatile uint64_t sink = 0;
+
+
+static double
+time_batch(const Microbench& bench, const uint64_t iterations) {
+    const auto begin = bench_clock::now();
+    sink = sink + bench.run(iterations);
+    return elapsed_ns(begin);
+}
+
+static void
+run_microbench(const Microbench& bench, const double min_ms) {
+
+    uint64_t iterations = 1;
+    while(time_batch(bench, iterations) < min_ms * 1'000'000.0 && iterations < (1ULL << 40)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> per_call;
+    for(int i = 0; i < 5; ++i) {
+        per_call.emplace_back(time_batch(bench, iterations) / static_cast<double>(iterations));
+    }
+
+    std::ranges::sort(per_call);
+    print("{:<56} {:>12.1f} ns {:>14}", bench.name, per_call[per_call.size() / 2], iterations);
+}
+
+
+static std::string
+generate_source() {
+
+    std::string src = "struct S0 {\n  v : i32;\n  w : f64;\n}\n";
+    for(uint32_t i = 1; i < 8; ++i) {
+        src += std::format("struct S{} {{\n  pad : u8;\n  inner : S{};\n}}\n", i, i - 1);
+    }
+
+    std::string params;
+    std::string param_types;
+    for(uint32_t i = 0; i < 16; ++i) {
+        params      += std::format("{}a{} : {}", i == 0 ? "" : ", ", i, i % 2 == 0 ? "i32" : "f64^");
+        param_types += std::format("{}{}", i == 0 ? "" : ", ", i % 2 == 0 ? "i32" : "f64^");
+    }
+
+    src += std::format("wide :: proc({}) -> i32 {{\n  ret 0;\n}}\n", params);
+    src += std::format("wide2 :: proc({}) -> i32 {{\n  ret 1;\n}}\n", params);
+    src += std::format("wide_ptr : proc^({}) -> i32;\n", param_types);
+    src += "grid : i32[4][8][16];\n";
+    src += "grid2 : i32[4][8][16];\n";
+    src += "deep : S7;\n";
+    src += "deep_ptr : S7^;\n";
+    src += "small : i32;\n";
+    src += "large : i64;\n";
+    src += "address : u64;\n";
+    return src;
+}
+
+static const TypeData&
+symbol_type(Parser& parser, const std::string& name) {
+    for(const auto& [index, sym] : parser.sym_table_) {
+        if(sym.name == name) return sym.type;
+    }
+
+    print("Missing symbol {}.", name);
+    std::exit(EXIT_FAILURE);
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const std::string_view filter = argc > 1 ? argv[1] : "";
+    const double           min_ms = argc > 2 ? std::max(1.0, std::atof(argv[2])) : 50.0;
+    const auto             path   = std::filesystem::temp_directory_path() / "tak_micro_bench.tak";
+
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << generate_source();
+    }
+
+    Parser parser;
+    Lexer  lexer;
+
+    const bool parsed = lexer.init(path.string()) && do_create_ast(parser, lexer);
+    std::filesystem::remove(path);
+    if(!parsed) {
+        return EXIT_FAILURE;
+    }
+
+    const TypeData& wide     = symbol_type(parser, "\\wide");
+    const TypeData& wide2    = symbol_type(parser, "\\wide2");
+    const TypeData& wide_ptr = symbol_type(parser, "\\wide_ptr");
+    const TypeData& grid     = symbol_type(parser, "\\grid");
+    const TypeData& grid2    = symbol_type(parser, "\\grid2");
+    const TypeData& deep     = symbol_type(parser, "\\deep");
+    const TypeData& deep_ptr = symbol_type(parser, "\\deep_ptr");
+    const TypeData& small    = symbol_type(parser, "\\small");
+    const TypeData& large    = symbol_type(parser, "\\large");
+    const TypeData& address  = symbol_type(parser, "\\address");
+
+    const std::string deep_name = std::get<std::string>(deep.name);
+    const std::string deep_path = "inner.inner.inner.inner.inner.inner.inner.w";
+
+
+    //
+    // Name lookups run on a separate parser with scopes and namespaces set up by hand,
+    // as they'd look halfway through parsing something deeply nested.
+    //
+
+    Parser scopes;
+    for(uint32_t depth = 0; depth < 32; ++depth) {
+        scopes.push_scope();
+        for(uint32_t i = 0; i < 8; ++i) {
+            scopes.scope_stack_.back().emplace(std::format("\\local{}_{}", depth, i), depth * 8 + i);
+        }
+    }
+
+    std::string qualified = "\\";
+    for(uint32_t depth = 0; depth < 16; ++depth) {
+        scopes.enter_namespace(std::format("ns{}", depth));
+        qualified += std::format("ns{}\\", depth);
+    }
+
+    scopes.scope_stack_.front().emplace(qualified + "target", 1);
+
+
+    const auto identical = [](const TypeData& first, const TypeData& second) {
+        return [&first, &second](const uint64_t n) {
+            uint64_t hits = 0;
+            for(uint64_t i = 0; i < n; ++i) hits += types_are_identical(first, second);
+            return hits;
+        };
+    };
+
+    const auto coercible = [](const TypeData& left, const TypeData& right) {
+        return [&left, &right](const uint64_t n) {
+            uint64_t hits = 0;
+            TypeData copy = left;
+            for(uint64_t i = 0; i < n; ++i) hits += is_type_coercion_permissible(copy, right);
+            return hits;
+        };
+    };
+
+    const auto castable = [](const TypeData& from, const TypeData& to) {
+        return [&from, &to](const uint64_t n) {
+            uint64_t hits = 0;
+            for(uint64_t i = 0; i < n; ++i) hits += is_type_cast_permissible(from, to);
+            return hits;
+        };
+    };
+
+    const auto to_str = [](const TypeData& type) {
+        return [&type](const uint64_t n) {
+            uint64_t length = 0;
+            for(uint64_t i = 0; i < n; ++i) length += typedata_to_str_msg(type).size();
+            return length;
+        };
+    };
+
+    const std::vector<Microbench> benches = {
+        {"types_are_identical/nested_array",            identical(grid, grid2)},
+        {"types_are_identical/proc_16_params",          identical(wide, wide2)},
+        {"types_are_identical/proc_vs_proc_pointer",    identical(wide, wide_ptr)},
+        {"types_are_identical/struct",                  identical(deep, deep)},
+        {"is_type_coercion_permissible/i32_to_i64",     coercible(large, small)},
+        {"is_type_coercion_permissible/nested_array",   coercible(grid, grid2)},
+        {"is_type_coercion_permissible/proc_pointer",   coercible(wide_ptr, wide)},
+        {"is_type_cast_permissible/pointer_to_u64",     castable(deep_ptr, address)},
+        {"is_type_cast_permissible/proc_pointer",       castable(wide_ptr, wide_ptr)},
+        {"typedata_to_str_msg/nested_array",            to_str(grid)},
+        {"typedata_to_str_msg/proc_16_params",          to_str(wide)},
+        {"get_struct_member_type_data/depth_8", [&](const uint64_t n) {
+            uint64_t found = 0;
+            for(uint64_t i = 0; i < n; ++i) found += get_struct_member_type_data(deep_path, deep_name, parser).has_value();
+            return found;
+        }},
+        {"get_canonical_name/namespace_depth_16", [&](const uint64_t n) {
+            uint64_t length = 0;
+            for(uint64_t i = 0; i < n; ++i) length += scopes.get_canonical_name("target", true).size();
+            return length;
+        }},
+        {"lookup_scoped_symbol/outermost_of_32", [&](const uint64_t n) {
+            uint64_t sum = 0;
+            for(uint64_t i = 0; i < n; ++i) sum += scopes.lookup_scoped_symbol("\\local0_3");
+            return sum;
+        }},
+        {"lookup_scoped_symbol/innermost_of_32", [&](const uint64_t n) {
+            uint64_t sum = 0;
+            for(uint64_t i = 0; i < n; ++i) sum += scopes.lookup_scoped_symbol("\\local31_3");
+            return sum;
+        }},
+    };
+
+    print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("{:<56} {:>15} {:>14}", "benchmark", "time per call", "iterations");
+    for(const auto& bench : benches) {
+        if(bench.name.find(filter) != std::string::npos) {
+            run_microbench(bench, min_ms);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
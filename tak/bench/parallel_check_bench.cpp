@@ -0,0 +1,150 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include "program_gen.hpp"
+#include <driver.hpp>
+#include <checker.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+//
+// Times the checker alone on a source file, serially and then with a growing number of threads,
+// and makes sure every run ends up with the same error/warning counts, node types and constants.
+// Meant for files with thousands of procedures. Without a source file (or with "-"), a program of
+// 20'000 lines is generated with program_gen.hpp, which has method calls in every unit.
+//
+// usage: tak_parallel_check_bench [source file] [iterations] [max threads]
+//
+
+using namespace tak;
+
+
+struct CheckResult {
+    double   median_ms = 0.0;
+    uint32_t errors    = 0;
+    uint32_t warnings  = 0;
+    bool     truncated = false;
+    uint64_t type_sum  = 0;  // Every node's type and constant ID mixed with its position, to compare annotations between runs.
+};
+
+
+static bool
+run_check(const std::string& source_file_name, const int iterations, const uint32_t num_threads, CheckResult& result) {
+
+    Samples samples;
+    samples.ms.reserve(iterations);
+
+    for(int i = 0; i < iterations; ++i) {
+
+        Parser parser;
+        Lexer  lexer;
+
+        if(!lexer.init(source_file_name) || !do_parse(parser, lexer)) {
+            return false;
+        }
+
+        CheckerContext ctx(lexer, parser);
+        const auto     begin = bench_clock::now();
+
+        if(num_threads > 1) {
+            visit_toplevel_parallel(ctx, num_threads);
+        } else {
+            for(auto* decl : parser.toplevel_decls_) {
+                if(!ctx.truncated_ && NODE_NEEDS_VISITING(decl->type)) {
+                    visit_node(decl, ctx);
+                }
+            }
+        }
+
+        samples.ms.emplace_back(elapsed_ms(begin));
+
+        uint64_t type_sum = 0;
+        for(auto* decl : parser.toplevel_decls_) {
+            walk_ast(decl, [&](const AstNode* node) {
+                type_sum = type_sum * 31 + (static_cast<uint64_t>(node->type_id) ^ node->pos);
+                type_sum = type_sum * 31 + node->const_id;
+            });
+        }
+
+        result.errors    = ctx.error_count_;
+        result.warnings  = ctx.warning_count_;
+        result.truncated = ctx.truncated_;
+        result.type_sum  = type_sum;
+    }
+
+    result.median_ms = samples.median();
+    return true;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const bool        generate         = argc < 2 || std::string_view(argv[1]) == "-";
+    const auto        generated_path   = std::filesystem::temp_directory_path() / "tak_parallel_check_bench.tak";
+    const std::string source_file_name = generate ? generated_path.string() : argv[1];
+    const int         iterations       = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    if(generate) {
+        ProgramShape shape;
+        shape.lines = 20'000;
+
+        std::ofstream file(generated_path, std::ios::binary | std::ios::trunc);
+        file << generate_program(shape);
+    }
+
+    const auto cleanup = [&] {
+        if(generate) std::filesystem::remove(generated_path);
+    };
+    const uint32_t    max_threads      = argc > 3
+        ? std::max(1, std::atoi(argv[3]))
+        : std::max(1u, std::thread::hardware_concurrency());
+
+    CheckResult serial;
+    if(!run_check(source_file_name, iterations, 1, serial)) {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    print("threads: 1, check: {:.3f} ms, errors: {}, warnings: {}", serial.median_ms, serial.errors, serial.warnings);
+
+    bool consistent = true;
+    for(uint32_t num_threads = 2; num_threads <= max_threads; num_threads *= 2) {
+
+        CheckResult parallel;
+        if(!run_check(source_file_name, iterations, num_threads, parallel)) {
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        print("threads: {}, check: {:.3f} ms, speedup: {:.2f}x",
+            num_threads,
+            parallel.median_ms,
+            parallel.median_ms > 0.0 ? serial.median_ms / parallel.median_ms : 0.0
+        );
+
+        //
+        // Past the error limit each mode stops checking at a different point, so only the counts have to agree.
+        //
+
+        const bool types_match = serial.truncated || parallel.type_sum == serial.type_sum;
+        if(parallel.errors != serial.errors || parallel.warnings != serial.warnings || !types_match) {
+            print("MISMATCH: {} threads gave {} errors, {} warnings.", num_threads, parallel.errors, parallel.warnings);
+            consistent = false;
+        }
+    }
+
+    cleanup();
+    if(!consistent) {
+        return EXIT_FAILURE;
+    }
+
+    print("consistency: OK");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "program_gen.hpp"
+#include <algorithm>
+#include <format>
+
+
+static std::string
+deep_expression(const uint32_t depth, const uint32_t unit) {
+
+    std::string expr = "total";
+    for(uint32_t i = 0; i < depth; ++i) {
+        switch((unit + i) % 4) {
+            case 0:  expr = std::format("({} + {})", expr, i + 1);          break;
+            case 1:  expr = std::format("({} * (v.x - {}))", expr, i % 3);   break;
+            case 2:  expr = std::format("({} - v.y / {})", expr, i % 5 + 1); break;
+            default: expr = std::format("({} % {} + n)", expr, i + 7);       break;
+        }
+    }
+
+    return expr;
+}
+
+static void
+append_unit(std::string& out, const uint32_t unit, const tak::ProgramShape& shape) {
+
+    out += std::format(
+        "struct Vec{0} {{\n"
+        "  x : i32;\n"
+        "  y : i32;\n"
+        "}}\n"
+        "\n"
+        "@alias Index{0} = u64;\n"
+        "\n"
+        "enum Color{0}, u8 {{\n"
+        "  Red,\n"
+        "  Green = 5,\n"
+        "  Blue\n"
+        "}}\n"
+        "\n"
+        "namespace mod{0} {{\n"
+        "  add :: proc(a : i32, b : i32) -> i32 {{\n"
+        "    ret a + b;\n"
+        "  }}\n"
+        "  scale : i32 = {1};\n"
+        "}}\n"
+        "\n"
+        "compose Vec{0} {{\n"
+        "  length :: proc(self : Vec{0}^) -> i32 {{\n"
+        "    ret self.x * self.x + self.y * self.y;\n"
+        "  }}\n"
+        "}}\n"
+        "\n"
+        "run{0} :: proc(n : i32) -> i32 {{\n"
+        "  v : Vec{0};\n"
+        "  v.x = {2};\n"
+        "  v.y = mod{0}\\add(2, 3);\n"
+        "  total : i32 = 0;\n"
+        "  i : Index{0} = 0;\n"
+        "  while total < n {{\n"
+        "    total += v.length();\n"
+        "    if total > 100 {{\n"
+        "      total = total - 1;\n"
+        "    }} elif total == 3 {{\n"
+        "      total = 4;\n"
+        "    }} else {{\n"
+        "      total += 2;\n"
+        "    }}\n"
+        "  }}\n"
+        "  for k : i32 = 0; k < n; k += 1 {{\n"
+        "    total = {3};\n"
+        "  }}\n"
+        "  switch total {{\n"
+        "    case 1 {{ total = 2; }}\n"
+        "    fallthrough 2 {{ total = 3; }}\n"
+        "    default {{ total = 0; }}\n"
+        "  }}\n"
+        "  c : Color{0} = Color{0}\\Green;\n",
+        unit, unit % 7 + 1, unit % 13, deep_expression(shape.expression_depth, unit));
+
+    if(unit > 0) {
+        out += std::format("  total += run{}(n - 1);\n", unit - 1);
+    }
+
+    out += std::format("  ret total + mod{}\\scale;\n}}\n\n", unit);
+}
+
+
+uint32_t
+tak::lines_per_unit(const ProgramShape& shape) {
+    std::string unit;
+    append_unit(unit, 1, shape);
+    return static_cast<uint32_t>(std::ranges::count(unit, '\n'));
+}
+
+std::string
+tak::generate_program(const ProgramShape& shape) {
+
+    const uint32_t per_unit = lines_per_unit(shape);
+    const uint64_t units    = std::max<uint64_t>(1, (shape.lines + per_unit - 1) / per_unit);
+
+    std::string out;
+    out.reserve(units * per_unit * 32);
+
+    for(uint64_t unit = 0; unit < units; ++unit) {
+        append_unit(out, static_cast<uint32_t>(unit), shape);
+    }
+
+    return out;
+}
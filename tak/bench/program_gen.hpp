@@ -0,0 +1,28 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef PROGRAM_GEN_HPP
+#define PROGRAM_GEN_HPP
+#include <cstdint>
+#include <string>
+
+//
+// Generates valid Tak programs of any size for benchmarks. A program is a sequence of units, each one
+// a struct with a compose method, an alias, an enum, a namespace with a procedure and a global, and a
+// driver procedure with loops, a switch and a deep expression. Every driver calls the one before it,
+// so nothing is unreachable from the last unit's driver.
+//
+
+namespace tak {
+
+    struct ProgramShape {
+        uint64_t lines            = 10'000;  // Roughly, the output is a whole number of units.
+        uint32_t expression_depth = 8;       // Nesting of the parenthesized expression in every driver.
+    };
+
+    std::string generate_program(const ProgramShape& shape);
+    uint32_t    lines_per_unit(const ProgramShape& shape);
+}
+
+#endif //PROGRAM_GEN_HPP
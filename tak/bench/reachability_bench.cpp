@@ -0,0 +1,100 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <driver.hpp>
+#include <reachability.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+//
+// Generates a large "library" of procedures of which a program only uses a few, then times parsing and
+// checking all of it against checking only what's reachable from main, with eager and lazy procedure bodies.
+// Each library procedure calls the one before it, so main reaches exactly the first [used] of them.
+//
+// usage: tak_reachability_bench [library procedures] [used procedures] [iterations]
+//
+
+using namespace tak;
+
+
+static std::string
+generate_source(const uint32_t procedures, const uint32_t used) {
+
+    std::string src = "lib0 :: proc(a : i32) -> i32 {\n  ret a;\n}\n\n";
+    for(uint32_t i = 1; i < procedures; ++i) {
+        src += std::format("lib{} :: proc(a : i32) -> i32 {{\n", i);
+        src += "  total : i32 = 0;\n";
+        src += "  for j : i32 = 0; j < a; j += 1 {\n";
+        src += std::format("    if j % {} == 0 {{ total += j * 3; }} else {{ total -= 1; }}\n", 2 + i % 7);
+        src += "  }\n";
+        src += std::format("  ret lib{}(total + a);\n}}\n\n", i - 1);
+    }
+
+    src += std::format("main :: proc() -> i32 {{\n  ret lib{}(10);\n}}\n", used - 1);
+    return src;
+}
+
+static bool
+run_build(const std::string& path, const CompileOptions& options, double& ms) {
+
+    Parser parser;
+    Lexer  lexer;
+
+    parser.lazy_proc_bodies_ = options.lazy_proc_bodies;
+    if(!lexer.init(path)) {
+        return false;
+    }
+
+    const auto begin = bench_clock::now();
+    const bool ok    = do_create_ast(parser, lexer, options);
+
+    ms = elapsed_ms(begin);
+    return ok;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const uint32_t procedures = argc > 1 ? std::max(2, std::atoi(argv[1])) : 20000;
+    const uint32_t used       = argc > 2 ? std::clamp<uint32_t>(std::atoi(argv[2]), 1, procedures) : 100;
+    const int      iterations = argc > 3 ? std::max(1, std::atoi(argv[3])) : 5;
+
+    const auto path = std::filesystem::temp_directory_path() / "tak_reachability_bench.tak";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << generate_source(procedures, used);
+    }
+
+    print("library procedures: {}, used by main: {}", procedures, used);
+
+    bool ok = true;
+    for(const bool lazy : {false, true}) {
+        for(const bool from_main : {false, true}) {
+            CompileOptions options;
+            options.lazy_proc_bodies = lazy;
+            if(from_main) {
+                options.entry_points.emplace_back("main");
+            }
+
+            Samples samples;
+            for(int i = 0; i < iterations && ok; ++i) {
+                ok = run_build(path.string(), options, samples.ms.emplace_back());
+            }
+
+            if(!ok) {
+                break;
+            }
+
+            print("{:<6} {:<14} {:.3f} ms", lazy ? "lazy" : "eager", from_main ? "from main" : "everything", samples.median());
+        }
+    }
+
+    std::filesystem::remove(path);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
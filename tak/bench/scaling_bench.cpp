@@ -0,0 +1,223 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include <driver.hpp>
+#include <checker.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+//
+// Sweeps one input dimension at a time over pathological programs and fits the growth rate of
+// the compile time, as the slope of log(time) against log(size). Linear comes out close to 1,
+// n log n a little above it, and quadratic close to 2. Fails if any dimension is steeper than [max slope].
+//
+// Every program does a fixed amount of work besides the dimension being swept, so a linear path
+// stays linear: e.g. the scope depth sweep always does the same number of lookups, just from deeper down.
+//
+// usage: tak_scaling_bench [dimension or "all"] [iterations] [max slope]
+//
+
+using namespace tak;
+
+
+struct Dimension {
+    std::string_view name;
+    std::string_view path;          // What's being exercised.
+    uint32_t         first_size;    // Doubled [steps] times.
+    bool             check;         // Check as well as parse.
+    bool             should_fail;   // The program has an error in it on purpose.
+    std::string    (*generate)(uint32_t size);
+};
+
+static constexpr uint32_t steps = 5;
+
+
+static std::string
+gen_scope_depth(const uint32_t depth) {
+
+    std::string src = "main :: proc() -> i32 {\n  v0 : i32 = 0;\n";
+    for(uint32_t i = 0; i < depth; ++i) src += "  blk {\n";
+    for(uint32_t i = 0; i < 2000; ++i)  src += "  v0 += 1;\n";
+    for(uint32_t i = 0; i < depth; ++i) src += "  }\n";
+
+    src += "  ret v0;\n}\n";
+    return src;
+}
+
+static std::string
+gen_namespace_depth(const uint32_t depth) {
+
+    std::string src;
+    for(uint32_t i = 0; i < depth; ++i) src += std::format("namespace n{} {{\n", i);
+
+    src += "g : i32 = 1;\np0 :: proc() -> i32 {\n  ret g;\n}\n";
+    for(uint32_t i = 1; i < 200; ++i) {
+        src += std::format("p{} :: proc() -> i32 {{\n  ret p{}() + g;\n}}\n", i, i - 1);
+    }
+
+    for(uint32_t i = 0; i < depth; ++i) src += "}\n";
+    return src;
+}
+
+static std::string
+gen_expression_length(const uint32_t terms) {
+
+    static constexpr std::string_view operators[] = {" + ", " * ", " - ", " / ", " % "};
+
+    std::string src = "total : i32 = 1";
+    for(uint32_t i = 0; i < terms; ++i) {
+        src += operators[i % std::size(operators)];
+        src += std::to_string(i % 9 + 1);
+    }
+
+    src += ";\n";
+    return src;
+}
+
+static std::string
+gen_error_line_length(const uint32_t length) {
+    return "x : i32 = 1;" + std::string(length, ' ') + ")\ny : i32 = 2;\n";
+}
+
+static constexpr Dimension dimensions[] = {
+    {"scope_depth",       "lookup_scoped_symbol",      128,     true,  false, gen_scope_depth},
+    {"namespace_depth",   "get_canonical_name",        16,      true,  false, gen_namespace_depth},
+    {"expression_length", "parse_binary_expression",   2048,    false, false, gen_expression_length},
+    {"member_count",      "compose_add_type_method",   250,     true,  false, generate_compose_methods},
+    {"error_line_length", "Lexer::_raise_error_impl",  1 << 16, false, true,  gen_error_line_length},
+};
+
+
+static bool
+time_compile(const Dimension& dim, const std::string& path, double& ms) {
+
+    Parser parser;
+    Lexer  lexer;
+
+    if(!lexer.init(path)) {
+        return false;
+    }
+
+    std::ostringstream discarded;
+    redirect_output(&discarded);
+
+    const auto begin    = bench_clock::now();
+    bool       compiled = do_parse(parser, lexer);
+
+    if(compiled && dim.check) {
+        CheckerContext ctx(lexer, parser);
+        visit_toplevel(ctx);
+        compiled = ctx.error_count_ == 0;
+    }
+
+    ms = elapsed_ms(begin);
+    redirect_output(nullptr);
+    return compiled != dim.should_fail;
+}
+
+//
+// Least squares fit of log(ms) = slope * log(size) + c, over the largest [points] sizes only.
+// The fixed work in every program flattens the curve at the small end.
+//
+
+static double
+fit_slope(const std::vector<double>& sizes, const std::vector<double>& ms, const size_t points) {
+
+    const size_t first = sizes.size() - std::min(points, sizes.size());
+    const double n     = static_cast<double>(sizes.size() - first);
+    double sum_x = 0.0, sum_y = 0.0, sum_xx = 0.0, sum_xy = 0.0;
+
+    for(size_t i = first; i < sizes.size(); ++i) {
+        const double x = std::log(sizes[i]);
+        const double y = std::log(std::max(ms[i], 1e-6));
+        sum_x  += x;
+        sum_y  += y;
+        sum_xx += x * x;
+        sum_xy += x * y;
+    }
+
+    return (n * sum_xy - sum_x * sum_y) / (n * sum_xx - sum_x * sum_x);
+}
+
+static bool
+run_dimension(const Dimension& dim, const int iterations, const double max_slope) {
+
+    const auto          path = std::filesystem::temp_directory_path() / "tak_scaling_bench.tak";
+    std::vector<double> sizes, medians;
+
+    print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("{} ({})", dim.name, dim.path);
+    for(uint32_t step = 0, size = dim.first_size; step < steps; ++step, size *= 2) {
+        {
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file << dim.generate(size);
+        }
+
+        Samples samples;
+        for(int i = 0; i < iterations; ++i) {
+            double ms = 0.0;
+            if(!time_compile(dim, path.string(), ms)) {
+                print("  FAILED: size {} did not compile the way it should have.", size);
+                std::filesystem::remove(path);
+                return false;
+            }
+
+            samples.ms.emplace_back(ms);
+        }
+
+        sizes.emplace_back(size);
+        medians.emplace_back(samples.median());
+        print("  {:>9} {:>12.3f} ms", size, medians.back());
+    }
+
+    std::filesystem::remove(path);
+
+    const double slope  = fit_slope(sizes, medians, 3);
+    const bool   passed = slope <= max_slope;
+
+    if(passed) {
+        print<TFG_GREEN, TBG_NONE, TSTYLE_NONE>("  slope {:.2f}, ok", slope);
+    } else {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("  slope {:.2f}, worse than {:.2f}", slope, max_slope);
+    }
+
+    return passed;
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const std::string_view only       = argc > 1 ? argv[1] : "all";
+    const int              iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    const double           max_slope  = argc > 3 ? std::atof(argv[3]) : 1.35;
+
+    bool passed = true;
+    bool ran    = false;
+
+    for(const auto& dim : dimensions) {
+        if(only == "all" || only == dim.name) {
+            passed = run_dimension(dim, iterations, max_slope) && passed;
+            ran    = true;
+        }
+    }
+
+    if(!ran) {
+        print("Unknown dimension \"{}\".", only);
+        return EXIT_FAILURE;
+    }
+
+    if(!passed) {
+        print("scaling: FAILED");
+        return EXIT_FAILURE;
+    }
+
+    print("scaling: OK");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,154 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "bench_util.hpp"
+#include "program_gen.hpp"
+#include <driver.hpp>
+#include <checker.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+//
+// End to end benchmark: generates a program with program_gen.hpp, then lexes, parses and checks it
+// [iterations] times and reports the median, mean, standard deviation and minimum of every stage,
+// along with lines and tokens per second. Fails if the generated program doesn't check cleanly.
+//
+// With --emit, just writes the generated program to [path] so it can be fed to tak itself.
+//
+// usage: tak_bench [lines] [iterations] [expression depth]
+//        tak_bench --emit [path] [lines] [expression depth]
+//
+
+using namespace tak;
+
+
+static uint64_t
+lex_all(const std::string& path, Samples& samples) {
+
+    Lexer lexer;
+    if(!lexer.init(path)) {
+        return 0;
+    }
+
+    uint64_t   tokens = 0;
+    const auto begin  = bench_clock::now();
+
+    for(lexer.advance(1); lexer.current() != TOKEN_END_OF_FILE && lexer.current() != TOKEN_ILLEGAL; lexer.advance(1)) {
+        ++tokens;
+    }
+
+    samples.ms.emplace_back(elapsed_ms(begin));
+    return lexer.current() == TOKEN_END_OF_FILE ? tokens : 0;
+}
+
+static bool
+parse_and_check(const std::string& path, Samples& parse, Samples& check) {
+
+    Parser parser;
+    Lexer  lexer;
+
+    if(!lexer.init(path)) {
+        return false;
+    }
+
+    auto begin = bench_clock::now();
+    if(!do_parse(parser, lexer)) {
+        return false;
+    }
+    parse.ms.emplace_back(elapsed_ms(begin));
+
+    CheckerContext ctx(lexer, parser);
+    begin = bench_clock::now();
+    visit_toplevel(ctx);
+    check.ms.emplace_back(elapsed_ms(begin));
+
+    if(ctx.error_count_ != 0 || ctx.warning_count_ != 0) {
+        emit_checker_diagnostics(ctx, DIAG_FORMAT_TEXT);
+        return false;
+    }
+
+    return true;
+}
+
+static void
+print_stage(const std::string_view name, const Samples& samples, const uint64_t lines, const uint64_t tokens) {
+    const double seconds = samples.median() / 1'000.0;
+    print("{:<8} median {:>10.3f} ms  mean {:>10.3f} ms  stddev {:>8.3f} ms  min {:>10.3f} ms  {:>12.0f} lines/s  {:>12.0f} tokens/s",
+        name,
+        samples.median(),
+        samples.mean(),
+        samples.stddev(),
+        samples.min(),
+        static_cast<double>(lines) / seconds,
+        static_cast<double>(tokens) / seconds
+    );
+}
+
+
+int
+main(const int argc, char** argv) {
+
+    const bool   emit      = argc > 1 && std::string_view(argv[1]) == "--emit";
+    const int    lines_arg = emit ? 3 : 1;
+    const int    depth_arg = emit ? 4 : 3;
+    ProgramShape shape;
+
+    shape.lines = argc > lines_arg ? std::max(1LL, std::atoll(argv[lines_arg])) : 100'000;
+    if(argc > depth_arg) {
+        shape.expression_depth = std::max(0, std::atoi(argv[depth_arg]));
+    }
+
+    const std::string source = generate_program(shape);
+    const uint64_t    lines  = std::ranges::count(source, '\n');
+
+    if(emit) {
+        if(argc < 3) {
+            print("usage: tak_bench --emit [path] [lines] [expression depth]");
+            return EXIT_FAILURE;
+        }
+
+        std::ofstream file(argv[2], std::ios::binary | std::ios::trunc);
+        if(!file.write(source.data(), static_cast<std::streamsize>(source.size()))) {
+            print("Could not write {}.", argv[2]);
+            return EXIT_FAILURE;
+        }
+
+        print("wrote {} lines ({} bytes) to {}", lines, source.size(), argv[2]);
+        return EXIT_SUCCESS;
+    }
+
+    const int  iterations = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+    const auto path       = std::filesystem::temp_directory_path() / "tak_bench.tak";
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(source.data(), static_cast<std::streamsize>(source.size()));
+    }
+
+    print("{} lines, {} bytes, expression depth {}, {} iterations", lines, source.size(), shape.expression_depth, iterations);
+
+    Samples  lex, parse, check, total;
+    uint64_t tokens = 0;
+
+    for(int i = 0; i < iterations; ++i) {
+        tokens = lex_all(path.string(), lex);
+        if(tokens == 0 || !parse_and_check(path.string(), parse, check)) {
+            print("FAILED: the generated program did not compile cleanly.");
+            std::filesystem::remove(path);
+            return EXIT_FAILURE;
+        }
+
+        total.ms.emplace_back(parse.ms.back() + check.ms.back());
+    }
+
+    print_stage("lex",   lex,   lines, tokens);
+    print_stage("parse", parse, lines, tokens);
+    print_stage("check", check, lines, tokens);
+    print_stage("total", total, lines, tokens);
+
+    std::filesystem::remove(path);
+    return EXIT_SUCCESS;
+}
@@ -54,9 +54,11 @@ namespace tak {
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     struct AstNode {
-        node_t                   type   = NODE_NONE;
-        std::optional<AstNode*>  parent = std::nullopt;
-        size_t                   pos    = 0;
+        node_t                   type     = NODE_NONE;
+        uint32_t                 type_id  = INVALID_TYPE_ID;     // Resolved type of an expression, set by the checker.
+        uint32_t                 const_id = INVALID_CONSTANT_ID; // Folded value of a constant expression, also set by the checker.
+        std::optional<AstNode*>  parent   = std::nullopt;
+        size_t                   pos      = 0;
 
         virtual ~AstNode() = default;
         explicit AstNode(const node_t type) : type(type) {}
@@ -87,8 +89,8 @@ namespace tak {
     };
 
     struct AstIf final : AstNode {
-        std::vector<AstNode*> body;
-        AstNode*              condition = nullptr;
+        SmallVector<AstNode*, 4> body;
+        AstNode*                 condition = nullptr;
 
         ~AstIf() override;
         AstIf() : AstNode(NODE_IF) {}
@@ -157,10 +159,19 @@ namespace tak {
         AstVardecl() : AstNode(NODE_VARDECL) {}
     };
 
+    struct DeferredBody {                                // Unparsed procedure body (lazy mode).
+        Token                    open;                   // The opening '{'.
+        size_t                   src_index = 0;          // Lexer index right after the opening brace.
+        uint32_t                 line      = 1;
+        size_t                   end_pos   = 0;          // Position of the matching '}'.
+        std::vector<std::string> namespaces;             // Namespace stack at the declaration.
+    };
+
     struct AstProcdecl final : AstNode {
-        AstIdentifier*           identifier = nullptr;
-        std::vector<AstVardecl*> parameters;
-        std::vector<AstNode*>    body;
+        AstIdentifier*              identifier = nullptr;
+        SmallVector<AstVardecl*, 4> parameters;
+        std::vector<AstNode*>       body;
+        std::optional<DeferredBody> deferred_body = std::nullopt; // Set until the body gets parsed.
 
         ~AstProcdecl() override;
         AstProcdecl() : AstNode(NODE_PROCDECL) {}
@@ -174,8 +185,8 @@ namespace tak {
     };
 
     struct AstCall final : AstNode {
-        AstNode*              target = nullptr;
-        std::vector<AstNode*> arguments;                   // Can be empty, if the procedure is "paramless".
+        AstNode*                 target = nullptr;
+        SmallVector<AstNode*, 4> arguments;                // Can be empty, if the procedure is "paramless".
 
         ~AstCall() override;
         AstCall() : AstNode(NODE_CALL) {}
@@ -0,0 +1,114 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef CALL_GRAPH_HPP
+#define CALL_GRAPH_HPP
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <parser.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define TAK_CALL_GRAPH_MAGIC   0x4743414BU // "KACG"
+#define TAK_CALL_GRAPH_VERSION 1
+#define INVALID_CALL_NODE      UINT32_MAX
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Whole-program call graph, built from the checked AST. The checker rewrites method calls into
+// plain calls of the method's symbol, so after checking every direct call is an AstCall whose target
+// is an identifier naming a procedure. Anything else (a procedure pointer, a call result, a member of
+// procedure type) is an indirect call and goes to INVALID_CALL_NODE.
+//
+// Strongly connected components come out of Tarjan's algorithm in bottom-up order:
+// every component only calls into itself and the components before it.
+//
+// Procedures that were never checked (see --entry) still get a node, but their calls aren't resolved.
+//
+
+namespace tak {
+
+    enum call_kind_t : uint8_t {
+        CALL_DIRECT,
+        CALL_METHOD,
+        CALL_INDIRECT,
+    };
+
+    enum call_node_flags : uint32_t {
+        CALL_NODE_FLAGS_NONE    = 0,
+        CALL_NODE_RECURSIVE     = 1,      // Part of a cycle, or calls itself.
+        CALL_NODE_ADDRESS_TAKEN = 1 << 1, // Used as a value somewhere, so it might be called indirectly.
+        CALL_NODE_INDIRECT      = 1 << 2, // Makes at least one indirect call.
+        CALL_NODE_METHOD        = 1 << 3,
+    };
+
+    struct CallEdge {
+        uint32_t    callee = INVALID_CALL_NODE;
+        call_kind_t kind   = CALL_DIRECT;
+        uint32_t    count  = 0;               // Call sites in the caller's body.
+    };
+
+    struct CallGraphNode {
+        const AstProcdecl*    proc         = nullptr;
+        uint32_t              symbol_index = INVALID_SYMBOL_INDEX;
+        uint32_t              flags        = CALL_NODE_FLAGS_NONE;
+        uint32_t              scc          = 0;
+        std::vector<CallEdge> calls;        // One per callee, in order of first call.
+    };
+
+    struct CallGraph {
+        std::vector<CallGraphNode>             nodes;   // In source order.
+        std::vector<std::vector<uint32_t>>     sccs;    // Bottom-up.
+        std::unordered_map<uint32_t, uint32_t> node_of; // Symbol index -> node.
+    };
+
+
+    //
+    // Binary export. The file is a CallGraphHeader followed by five arrays:
+    // nodes (CallGraphNodeRecord), edges (CallGraphEdgeRecord, grouped by caller), component sizes (uint32, bottom-up),
+    // component members (uint32 node indices, in the same order), and the procedure names as raw bytes.
+    //
+
+    struct CallGraphHeader {
+        uint32_t magic        = TAK_CALL_GRAPH_MAGIC;
+        uint16_t version      = TAK_CALL_GRAPH_VERSION;
+        uint16_t _pad         = 0;
+        uint32_t node_count   = 0;
+        uint32_t edge_count   = 0;
+        uint32_t scc_count    = 0;
+        uint32_t strings_size = 0;
+    };
+
+    struct CallGraphNodeRecord {
+        uint32_t name_offset = 0;
+        uint32_t name_length = 0;
+        uint32_t first_edge  = 0;
+        uint32_t edge_count  = 0;
+        uint32_t scc         = 0;
+        uint32_t flags       = CALL_NODE_FLAGS_NONE;
+    };
+
+    struct CallGraphEdgeRecord {
+        uint32_t callee = INVALID_CALL_NODE;
+        uint32_t kind   = CALL_DIRECT;
+        uint32_t count  = 0;
+    };
+
+    static_assert(std::is_trivially_copyable_v<CallGraphHeader>);
+    static_assert(std::is_trivially_copyable_v<CallGraphNodeRecord>);
+    static_assert(std::is_trivially_copyable_v<CallGraphEdgeRecord>);
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    CallGraph build_call_graph(Parser& parser);
+    void      compute_call_graph_sccs(CallGraph& graph);
+    bool      write_call_graph_dot(const CallGraph& graph, Parser& parser, const std::string& path);
+    bool      write_call_graph_binary(const CallGraph& graph, Parser& parser, const std::string& path);
+}
+
+#endif //CALL_GRAPH_HPP
@@ -0,0 +1,66 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef CFG_HPP
+#define CFG_HPP
+#include <cstdint>
+#include <vector>
+#include <parser.hpp>
+#include <small_vector.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CFG_ENTRY_BLOCK  0
+#define CFG_EXIT_BLOCK   1
+#define INVALID_BLOCK_ID UINT32_MAX
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Control flow graph of a single procedure body.
+//
+// Blocks hold the statements that run in them, in order. A block that ends in a branch also holds
+// the condition (or switch target) as its last node. Expressions are never split up, so
+// "a && b" is a single node even though it short-circuits.
+//
+// Block 0 is the entry and block 1 is the exit, every "ret" and the end of the body lead to the exit.
+// "defer" nodes stay where they were written, the calls they register run on the way into the exit block.
+//
+
+namespace tak {
+
+    struct BasicBlock {
+        SmallVector<AstNode*, 4> nodes;
+        SmallVector<uint32_t, 2> succs;
+        SmallVector<uint32_t, 2> preds;
+    };
+
+    struct ControlFlowGraph {
+        const AstProcdecl*      proc = nullptr;
+        std::vector<BasicBlock> blocks;
+        std::vector<uint32_t>   reverse_postorder;   // Only blocks reachable from the entry.
+        std::vector<uint32_t>   rpo_index;           // Position of each block in reverse_postorder, INVALID_BLOCK_ID if unreachable.
+
+        bool is_reachable(const uint32_t block) const { return rpo_index[block] != INVALID_BLOCK_ID; }
+    };
+
+    struct DominatorTree {
+        uint32_t              root = CFG_ENTRY_BLOCK;
+        std::vector<uint32_t> idom;                  // Immediate dominator, INVALID_BLOCK_ID for the root and unreachable blocks.
+        std::vector<uint32_t> preorder;              // Position in a preorder walk of the tree.
+        std::vector<uint32_t> subtree_end;           // One past the last preorder position in the subtree.
+
+        bool dominates(uint32_t dominator, uint32_t block) const;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    ControlFlowGraph      build_cfg(const AstProcdecl* proc);
+    DominatorTree         compute_dominators(const ControlFlowGraph& cfg);
+    DominatorTree         compute_post_dominators(const ControlFlowGraph& cfg);
+    std::vector<uint32_t> cfg_reverse_postorder(const ControlFlowGraph& cfg, uint32_t root, bool backward);
+    void                  dump_cfg(const ControlFlowGraph& cfg, Parser& parser);
+}
+
+#endif //CFG_HPP
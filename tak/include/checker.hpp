@@ -10,7 +10,12 @@
 #include <string>
 #include <utility>
 #include <typeindex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <concepts>
 #include <parser.hpp>
+#include <diagnostics.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -27,19 +32,57 @@
 
 namespace tak {
 
+    struct CheckerTypeBuffer {
+        std::vector<TypeData>                       types;      // Local type IDs, handed out in first-use order.
+        std::unordered_multimap<uint64_t, uint32_t> type_ids;
+        std::vector<ConstantValue>                  constants;  // Folded values, AstNode::const_id - 1 indexes into this until merged.
+    };
+
     class CheckerContext {
     public:
 
         uint32_t error_count_   = 0;
         uint32_t warning_count_ = 0;
+        bool     truncated_     = false; // MAX_ERROR_COUNT was hit, nothing else gets recorded.
         Lexer&   lxr_;
         Parser&  parser_;
 
-        void raise_error(const std::string& message, size_t position);
-        void raise_warning(const std::string& message, size_t position);
+        std::vector<Diagnostic> diagnostics_;
+        CheckerTypeBuffer*      type_buffer_ = nullptr; // If set, node types and constants are recorded here instead of in the parser.
+
+        template<typename ... Args>
+        void report(const diag_code_t code, const size_t position, const Args&... args) {
+            if(truncated_) {
+                return;
+            }
+
+            Diagnostic diag;
+            diag.code     = code;
+            diag.position = position;
+            diag.args.reserve(sizeof...(Args));
+
+            (diag.args.emplace_back(to_diag_arg(args)), ...);
+            add_diagnostic(std::move(diag));
+        }
+
+        void     add_diagnostic(Diagnostic&& diag);
+        void     annotate(AstNode* node, const TypeData& type);
+        uint32_t intern_type(const TypeData& type);
+
+        void                 record_constant(AstNode* node, const ConstantValue& value);
+        const ConstantValue* lookup_constant(const AstNode* node);
+        const TypeData*      lookup_type(const AstNode* node);
 
         explicit CheckerContext(Lexer& lxr, Parser& parser) : lxr_(lxr), parser_(parser) {}
         ~CheckerContext() = default;
+
+    private:
+        DiagArg to_diag_arg(const TypeData& type)     { return DiagArg{DIAG_ARG_TYPE, intern_type(type), {}}; }
+        DiagArg to_diag_arg(const token_t token)      { return DiagArg{DIAG_ARG_TOKEN, static_cast<uint64_t>(token), {}}; }
+        DiagArg to_diag_arg(const std::string& text)  { return DiagArg{DIAG_ARG_STRING, 0, text}; }
+
+        template<std::integral T>
+        DiagArg to_diag_arg(const T value)            { return DiagArg{DIAG_ARG_INTEGER, static_cast<uint64_t>(value), {}}; }
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -63,12 +106,16 @@ namespace tak {
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+    void visit_toplevel(CheckerContext& ctx, const std::unordered_set<const AstNode*>* reachable = nullptr);
+    void visit_toplevel_parallel(CheckerContext& ctx, uint32_t num_threads, const std::unordered_set<const AstNode*>* reachable = nullptr);
+    std::optional<ConstantValue> fold_constant(const AstNode* node, const TypeData& type, CheckerContext& ctx);
+    bool emit_checker_diagnostics(CheckerContext& ctx, diag_format_t format, const std::string& output_path = "");
     std::optional<TypeData> visit_node(AstNode* node, CheckerContext& ctx);
     std::optional<TypeData> checker_handle_arraydecl(Symbol* sym, const AstVardecl* decl, CheckerContext& ctx);
     std::optional<TypeData> checker_handle_inferred_decl(Symbol* sym, const AstVardecl* decl, CheckerContext& ctx);
     std::optional<TypeData> visit_member_access(const AstMemberAccess* node, CheckerContext& ctx);
     std::optional<TypeData> visit_vardecl(const AstVardecl* node, CheckerContext& ctx);
-    std::optional<TypeData> visit_procdecl(const AstProcdecl* node, CheckerContext& ctx);
+    std::optional<TypeData> visit_procdecl(AstProcdecl* node, CheckerContext& ctx);
     std::optional<TypeData> visit_call(AstCall* node, CheckerContext& ctx);
     std::optional<TypeData> visit_switch(const AstSwitch* node, CheckerContext& ctx);
     std::optional<TypeData> visit_cast(const AstCast* node, CheckerContext& ctx);
@@ -0,0 +1,80 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef DATAFLOW_HPP
+#define DATAFLOW_HPP
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <cfg.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// A generic worklist solver for bit-vector dataflow problems over a ControlFlowGraph.
+//
+// A problem describes each block with a gen and a kill set, the transfer function is always
+// out = gen | (in & ~kill). Facts are merged with union ("may" problems like liveness or reaching definitions)
+// or intersection ("must" problems like definite initialization or available expressions).
+// Only blocks reachable from the entry take part. The others keep their initial value.
+//
+
+namespace tak {
+
+    enum dataflow_direction_t : uint8_t {
+        DATAFLOW_FORWARD,
+        DATAFLOW_BACKWARD,
+    };
+
+    enum dataflow_meet_t : uint8_t {
+        DATAFLOW_UNION,
+        DATAFLOW_INTERSECTION,
+    };
+
+    class BitVector {
+    public:
+
+        bool test(const size_t bit) const   { return words_[bit / 64] >> (bit % 64) & 1; }
+        void set(const size_t bit)          { words_[bit / 64] |= uint64_t{1} << (bit % 64); }
+        void reset(const size_t bit)        { words_[bit / 64] &= ~(uint64_t{1} << (bit % 64)); }
+        size_t size() const                 { return size_; }
+
+        void set_all();
+        void reset_all();
+        size_t count() const;
+        void union_with(const BitVector& other);
+        void intersect_with(const BitVector& other);
+        void subtract(const BitVector& other);
+
+        bool operator==(const BitVector& other) const = default;
+
+        explicit BitVector(const size_t size = 0) : words_((size + 63) / 64, 0), size_(size) {}
+
+    private:
+        std::vector<uint64_t> words_;
+        size_t                size_ = 0;
+    };
+
+    struct DataflowProblem {
+        dataflow_direction_t   direction = DATAFLOW_FORWARD;
+        dataflow_meet_t        meet      = DATAFLOW_UNION;
+        size_t                 num_bits  = 0;
+        std::vector<BitVector> gen;       // One per block.
+        std::vector<BitVector> kill;      // One per block.
+        BitVector              boundary;  // Value flowing into the entry (forward) or out of the exit (backward).
+    };
+
+    struct DataflowResult {
+        std::vector<BitVector> in;        // In program order, "in" is always the value at the top of the block.
+        std::vector<BitVector> out;
+        uint32_t               visits = 0; // Blocks taken off the worklist, for benchmarking.
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    DataflowProblem make_dataflow_problem(const ControlFlowGraph& cfg, dataflow_direction_t direction, dataflow_meet_t meet, size_t num_bits);
+    DataflowResult  solve_dataflow(const ControlFlowGraph& cfg, const DataflowProblem& problem);
+}
+
+#endif //DATAFLOW_HPP
@@ -0,0 +1,145 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef DIAGNOSTICS_HPP
+#define DIAGNOSTICS_HPP
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <parser.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Checker diagnostics are recorded as a code, a source position and a list of arguments.
+// Types are passed as node type IDs, nothing gets turned into text until the diagnostics are emitted.
+// Emitting sorts them by position, drops duplicates and writes everything out in one go.
+//
+
+namespace tak {
+
+    enum diag_code_t : uint16_t {
+        DIAG_OPERANDS_UNTYPED,
+        DIAG_LOGICAL_OPERATOR_LEFT,
+        DIAG_LOGICAL_OPERATOR_RIGHT,
+        DIAG_OPERATOR_LEFT,
+        DIAG_RIGHT_COERCION,
+        DIAG_UNARY_OPERATOR,
+        DIAG_UNARY_MINUS,
+        DIAG_BITWISE_NOT,
+        DIAG_INCREMENT_DECREMENT,
+        DIAG_LOGICAL_NOT,
+        DIAG_DEREFERENCE,
+        DIAG_ADDRESS_OF,
+        DIAG_UNINITIALIZED_SYMBOL,
+        DIAG_RIGHT_UNDEDUCED,
+        DIAG_ARRAY_MISMATCH,
+        DIAG_ASSIGNED_UNTYPED,
+        DIAG_INFERRED_CONTEXT,
+        DIAG_INFERRED_ARRAY_UNASSIGNED,
+        DIAG_RIGHT_UNTYPED,
+        DIAG_ASSIGNMENT_MISMATCH,
+        DIAG_INVALID_CAST,
+        DIAG_METHOD_ARGUMENT_COUNT,
+        DIAG_NAMED_METHOD_ARGUMENT_COUNT,
+        DIAG_ARGUMENT_UNTYPED,
+        DIAG_ARGUMENT_CONVERSION,
+        DIAG_CALL_TARGET_UNTYPED,
+        DIAG_NOT_CALLABLE,
+        DIAG_CALL_ARGUMENT_COUNT,
+        DIAG_RETURN_MISMATCH,
+        DIAG_RETURN_COERCION,
+        DIAG_MEMBER_ACCESS_UNTYPED,
+        DIAG_MEMBER_ACCESS_TYPE,
+        DIAG_NO_SUCH_MEMBER,
+        DIAG_DEFER_IF_UNTYPED,
+        DIAG_NOT_LOGICAL,
+        DIAG_EXPRESSION_UNTYPED,
+        DIAG_BRANCH_UNTYPED,
+        DIAG_FOR_INIT_UNTYPED,
+        DIAG_FOR_CONDITION_UNTYPED,
+        DIAG_FOR_CONDITION_TYPE,
+        DIAG_SWITCH_TARGET_UNTYPED,
+        DIAG_SWITCH_TARGET_TYPE,
+        DIAG_CASE_UNTYPED,
+        DIAG_CASE_COERCION,
+        DIAG_WHILE_CONDITION_UNTYPED,
+        DIAG_WHILE_CONDITION_TYPE,
+        DIAG_SUBSCRIPT_VALUE_UNTYPED,
+        DIAG_SUBSCRIPT_OPERAND_UNTYPED,
+        DIAG_SUBSCRIPT_VALUE_TYPE,
+        DIAG_SUBSCRIPT_OPERAND_TYPE,
+        DIAG_BRACED_STRUCT_TYPE,
+        DIAG_BRACED_MEMBER_COUNT,
+        DIAG_BRACED_ELEMENT_UNTYPED,
+        DIAG_BRACED_ELEMENT_COERCION,
+        DIAG_CONSTANT_DIVISION_BY_ZERO,
+        DIAG_CONSTANT_SHIFT_RANGE,
+        DIAG_CONSTANT_TRUNCATED,
+        DIAG_UNREACHABLE_DECLARATION,
+        DIAG_CODE_COUNT,
+    };
+
+    enum diag_severity_t : uint8_t {
+        DIAG_SEVERITY_ERROR,
+        DIAG_SEVERITY_WARNING,
+    };
+
+    enum diag_arg_t : uint8_t {
+        DIAG_ARG_TYPE,     // A node type ID.
+        DIAG_ARG_TOKEN,    // A token_t, printed as the token itself.
+        DIAG_ARG_INTEGER,
+        DIAG_ARG_STRING,
+    };
+
+    enum diag_format_t : uint8_t {
+        DIAG_FORMAT_TEXT,
+        DIAG_FORMAT_JSON,
+        DIAG_FORMAT_SARIF,
+    };
+
+    struct DiagArg {
+        diag_arg_t  kind  = DIAG_ARG_INTEGER;
+        uint64_t    value = 0;  // Type ID, token or integer, depending on the kind.
+        std::string text;
+
+        bool operator==(const DiagArg&) const = default;
+    };
+
+    struct Diagnostic {
+        diag_code_t          code     = DIAG_CODE_COUNT;
+        size_t               position = 0;
+        std::vector<DiagArg> args;
+
+        bool operator==(const Diagnostic&) const = default;
+    };
+
+    struct DiagInfo {
+        std::string_view name;      // Stable ID, used as the rule ID in JSON and SARIF output.
+        diag_severity_t  severity;
+        std::string_view format;    // Each "{}" gets replaced by the next argument.
+    };
+
+    struct DiagSummary {
+        uint32_t errors    = 0;
+        uint32_t warnings  = 0;
+        bool     truncated = false; // The error limit was hit, anything after it was never recorded.
+    };
+
+    const DiagInfo& get_diag_info(diag_code_t code);
+    std::string     format_diagnostic(const Diagnostic& diag, Parser& parser);
+    DiagSummary     sort_diagnostics(std::vector<Diagnostic>& diagnostics, bool truncated);
+
+    bool emit_diagnostics(
+        const std::vector<Diagnostic>& diagnostics,
+        const DiagSummary& summary,
+        Lexer& lxr,
+        Parser& parser,
+        diag_format_t format,
+        const std::string& output_path = ""
+    );
+}
+
+#endif //DIAGNOSTICS_HPP
@@ -0,0 +1,52 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef DRIVER_HPP
+#define DRIVER_HPP
+#include <string>
+#include <cstdint>
+#include <vector>
+#include <parser.hpp>
+#include <lexer.hpp>
+#include <diagnostics.hpp>
+#include <time_report.hpp>
+#include <dump.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace tak {
+
+    struct CompileOptions {
+        bool lazy_proc_bodies = false; // Skip procedure bodies during parsing, parse them when first needed.
+        bool use_image_cache  = false; // Load/store a module image next to the source file.
+        bool mem_report       = false; // Print AST and table memory usage once the AST is complete.
+        bool layout_report    = false; // Print the size, field offsets and padding of every struct.
+
+        uint32_t      jobs               = 1;                // Source files compiled at the same time.
+        uint32_t      check_threads      = 1;                // Threads used to check procedure bodies, 1 checks everything serially.
+        diag_format_t diagnostics_format = DIAG_FORMAT_TEXT; // Text, JSON or SARIF.
+        std::string   diagnostics_path;                      // Where checker diagnostics get written, stdout if empty.
+
+        std::vector<std::string> entry_points;              // If any are given, only what they can reach gets checked.
+        bool                     warn_unreachable = false;  // Warn about every procedure and global that was skipped.
+
+        std::string call_graph_dot;   // Where to write the call graph as DOT, if anywhere.
+        std::string call_graph_path;  // Same, in the binary format from call_graph.hpp.
+
+        bool        time_report      = false; // Print per-phase timings and counters once the file is done.
+        bool        time_report_json = false; // As JSON instead of a table.
+        std::string time_report_path;         // Where the JSON report gets written, stdout if empty.
+
+        uint8_t       dumps       = DUMP_NONE;        // dump_flags, what to dump once the file is checked.
+        dump_format_t dump_format = DUMP_FORMAT_TEXT; // The tree from dump.cpp, JSON, or binary.
+        std::string   dump_path;                      // Where dumps get written, stdout if empty.
+    };
+
+    bool do_parse(Parser& parser, Lexer& lexer, TimeReport* times = nullptr);
+    bool do_create_ast(Parser& parser, Lexer& lexer, const CompileOptions& options = {}, TimeReport* times = nullptr);
+    bool do_compile(const std::string& source_file_name, const CompileOptions& options);
+    bool do_compile_files(const std::vector<std::string>& source_file_names, const CompileOptions& options);
+}
+
+#endif //DRIVER_HPP
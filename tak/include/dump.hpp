@@ -0,0 +1,148 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef DUMP_HPP
+#define DUMP_HPP
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <parser.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define TAK_DUMP_MAGIC   0x4D44414BU // "KADM"
+#define TAK_DUMP_VERSION 1
+#define INVALID_DUMP_REF UINT32_MAX
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Dumps of the AST, symbol table and type table, as the human readable tree, JSON, or a compact binary file.
+// Everything goes through one DumpWriter, which collects output in a buffer and writes it in large chunks.
+//
+
+namespace tak {
+
+    enum dump_format_t : uint8_t {
+        DUMP_FORMAT_TEXT,
+        DUMP_FORMAT_JSON,
+        DUMP_FORMAT_BINARY,
+    };
+
+    enum dump_flags : uint8_t {
+        DUMP_NONE    = 0,
+        DUMP_AST     = 1,
+        DUMP_SYMBOLS = 1 << 1,
+        DUMP_TYPES   = 1 << 2,
+    };
+
+    class DumpWriter {
+    public:
+
+        static constexpr size_t flush_threshold = 64 * 1024;
+
+        explicit DumpWriter(std::ostream& out, bool styled = false); // Styled output gets the same escape sequences as print.
+        ~DumpWriter();
+
+        template<typename ... Args>
+        void line(const std::format_string<Args...> fmt, Args&&... args) {
+            std::format_to(std::back_inserter(buffer_), fmt, std::forward<Args>(args)...);
+            buffer_ += '\n';
+            if(buffer_.size() >= flush_threshold) flush();
+        }
+
+        void write(std::string_view str);
+        void write(const void* data, size_t size);
+        void spaces(uint32_t count);
+        void heading(std::string_view text, uint16_t style);
+        void flush();
+        bool good() const;
+
+        DumpWriter(const DumpWriter&)            = delete;
+        DumpWriter& operator=(const DumpWriter&) = delete;
+
+    private:
+        std::ostream& out_;
+        std::string   buffer_;
+        bool          styled_;
+    };
+
+
+    //
+    // Binary dump. The file is a DumpHeader followed by five arrays: nodes (DumpNodeRecord, in pre-order),
+    // symbols (DumpSymbolRecord, by symbol index), types (DumpTypeRecord, by name), members (DumpMemberRecord,
+    // grouped by type), and a string pool. Sections that weren't asked for are empty. Types are stored as the
+    // same strings the checker uses in its messages.
+    //
+
+    struct DumpHeader {
+        uint32_t magic        = TAK_DUMP_MAGIC;
+        uint16_t version      = TAK_DUMP_VERSION;
+        uint16_t sections     = DUMP_NONE;
+        uint32_t node_count   = 0;
+        uint32_t symbol_count = 0;
+        uint32_t type_count   = 0;
+        uint32_t member_count = 0;
+        uint32_t strings_size = 0;
+    };
+
+    struct DumpNodeRecord {
+        uint64_t pos         = 0;
+        uint32_t parent      = INVALID_DUMP_REF;     // Node index, INVALID_DUMP_REF at the toplevel.
+        uint32_t symbol      = INVALID_SYMBOL_INDEX; // Identifiers only.
+        uint32_t type_id     = INVALID_TYPE_ID;
+        uint32_t const_id    = INVALID_CONSTANT_ID;
+        uint32_t text_offset = 0;                    // Literal value, name or path, depending on the node.
+        uint32_t text_length = 0;
+        uint16_t kind        = NODE_NONE;
+        uint16_t token       = TOKEN_NONE;           // Operator or literal type.
+        uint32_t _pad        = 0;
+    };
+
+    struct DumpSymbolRecord {
+        uint64_t src_pos     = 0;
+        uint32_t index       = INVALID_SYMBOL_INDEX;
+        uint32_t flags       = SYM_FLAGS_NONE;
+        uint32_t line        = 0;
+        uint32_t name_offset = 0;
+        uint32_t name_length = 0;
+        uint32_t type_offset = 0;
+        uint32_t type_length = 0;
+        uint32_t _pad        = 0;
+    };
+
+    struct DumpTypeRecord {
+        uint32_t name_offset  = 0;
+        uint32_t name_length  = 0;
+        uint32_t first_member = 0;
+        uint32_t member_count = 0;
+        uint32_t placeholder  = 0;
+    };
+
+    struct DumpMemberRecord {
+        uint32_t name_offset = 0;
+        uint32_t name_length = 0;
+        uint32_t type_offset = 0;
+        uint32_t type_length = 0;
+        uint32_t symbol      = INVALID_SYMBOL_INDEX; // Methods only.
+    };
+
+    static_assert(std::is_trivially_copyable_v<DumpHeader>);
+    static_assert(std::is_trivially_copyable_v<DumpNodeRecord>);
+    static_assert(std::is_trivially_copyable_v<DumpSymbolRecord>);
+    static_assert(std::is_trivially_copyable_v<DumpTypeRecord>);
+    static_assert(std::is_trivially_copyable_v<DumpMemberRecord>);
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void dump_json(Parser& parser, uint8_t sections, DumpWriter& out);
+    void dump_binary(Parser& parser, uint8_t sections, DumpWriter& out);
+    bool write_dumps(Parser& parser, uint8_t sections, dump_format_t format, const std::string& path = "");
+}
+
+#endif //DUMP_HPP
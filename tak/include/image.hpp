@@ -0,0 +1,89 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <type_traits>
+#include <parser.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define TAK_IMAGE_MAGIC     0x494B4154U // "TAKI"
+#define TAK_IMAGE_VERSION   4
+#define TAK_IMAGE_EXTENSION ".timg"
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// A module image holds everything the parser and checker leave behind, so that an unchanged
+// source file can skip lexing, parsing and checking. The file starts with an ImageHeader,
+// followed by the sections it describes. Every offset is relative to the start of the file,
+// and no section contains pointers:
+//
+// strings  - raw bytes, referenced everywhere else as a {uint32 offset, uint32 length} pair.
+// nodes    - the AST as a preorder stream. Each node is a uint16 node_t followed by its position,
+//            type ID, constant ID and fields. Child nodes are written inline, NODE_NONE stands in for a null child.
+// toplevel - one uint64 offset into the node section per toplevel declaration.
+// symbols  - the symbol table, ordered by symbol index.
+// types    - the type table, ordered by name.
+// aliases  - type aliases, ordered by name.
+// globals  - the global scope, if the parser kept it around.
+// node_types - interned expression types, in type ID order.
+// node_constants - folded constant values, in constant ID order.
+//
+// Loading maps the file into memory, validates the header and rebuilds the objects from the
+// sections (parent pointers and the like get fixed up on the way).
+//
+
+namespace tak {
+
+    enum image_flags : uint16_t {
+        IMAGE_FLAGS_NONE        = 0,
+        IMAGE_HAS_GLOBAL_SCOPE  = 1,
+    };
+
+    struct ImageSection {
+        uint64_t offset = 0;
+        uint64_t size   = 0;
+        uint32_t count  = 0;
+        uint32_t _pad   = 0;
+    };
+
+    struct ImageHeader {
+        uint32_t     magic          = TAK_IMAGE_MAGIC;
+        uint16_t     version        = TAK_IMAGE_VERSION;
+        uint16_t     flags          = IMAGE_FLAGS_NONE;
+        uint64_t     source_hash    = 0;
+        uint32_t     curr_sym_index = INVALID_SYMBOL_INDEX;
+        uint32_t     _pad           = 0;
+
+        ImageSection strings;
+        ImageSection nodes;
+        ImageSection toplevel;
+        ImageSection symbols;
+        ImageSection types;
+        ImageSection aliases;
+        ImageSection globals;
+        ImageSection node_types;
+        ImageSection node_constants;
+    };
+
+    static_assert(std::is_trivially_copyable_v<ImageHeader>);
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    uint64_t    hash_source(std::string_view source);
+    std::string get_image_path(const std::string& source_file_name);
+
+    bool write_image(Parser& parser, uint64_t source_hash, std::vector<uint8_t>& out);
+    bool write_image_file(Parser& parser, uint64_t source_hash, const std::string& image_path);
+    bool read_image(const uint8_t* data, size_t size, uint64_t source_hash, Parser& parser);
+    bool load_image_file(const std::string& image_path, uint64_t source_hash, Parser& parser);
+}
+
+#endif //IMAGE_HPP
@@ -0,0 +1,84 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef INCREMENTAL_HPP
+#define INCREMENTAL_HPP
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <parser.hpp>
+#include <lexer.hpp>
+#include <diagnostics.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Incremental rebuilds. Every toplevel declaration gets fingerprinted by a hash over its tokens.
+// On a rebuild the source is scanned from the top, and a declaration whose fingerprint shows up
+// again keeps its AST and symbols (they just get moved to the new position). Everything else is
+// parsed from scratch.
+//
+// Declarations that weren't touched but depend on something that changed (a symbol, a struct
+// type or a type alias owned by an edited declaration) are reparsed as well. Only reparsed
+// declarations get checked again.
+//
+// A caller that knows where the source changed (an editor does) can pass the edit along.
+// Declarations that end before it are kept without lexing them again, and the ones after it
+// are moved over without being lexed either, as long as the lexer lands right where they begin.
+//
+
+namespace tak {
+
+    struct DeclFingerprint {
+        uint64_t key         = 0;       // Hash of the first two tokens, used to look up candidates.
+        uint64_t hash        = 0;       // Hash of every token in the declaration.
+        uint32_t token_count = 0;
+    };
+
+    struct DeclRecord {
+        DeclFingerprint fingerprint;
+        size_t          begin       = 0;       // Position of the first token.
+        uint32_t        line        = 1;
+        bool            check_clean = false;   // Checked without errors, required for reuse.
+
+        std::vector<uint32_t>    owned_symbols;    // Everything declared within, including locals.
+        std::vector<uint32_t>    used_symbols;     // Referenced, but declared somewhere else.
+        std::vector<std::string> defined_types;
+        std::vector<std::string> defined_aliases;
+        std::string              composed_type;    // Only set for "compose" blocks.
+        std::vector<std::string> used_types;       // Includes struct types reachable through members.
+        std::vector<std::string> used_aliases;
+
+        std::vector<Symbol>                    symbol_interface; // Owned globals right after parsing.
+        std::vector<std::vector<MemberData>>   type_interface;   // Data members of each defined type.
+        std::vector<std::pair<bool, uint32_t>> layout_interface; // @packed and @align of each defined type.
+        std::vector<TypeData>                  alias_interface;
+    };
+
+    struct IncrementalStats {
+        uint32_t reused      = 0;   // Fingerprint matched, AST and symbols were kept.
+        uint32_t reparsed    = 0;   // New or edited, parsed from the source.
+        uint32_t invalidated = 0;   // Unchanged, but reparsed because a dependency changed.
+        uint32_t dropped     = 0;   // Previous declarations that no longer exist in the source.
+    };
+
+    struct SourceEdit {
+        size_t begin   = 0;   // First byte that differs from the source of the previous build.
+        size_t old_end = 0;   // End of the replaced bytes in the previous source.
+        size_t new_end = 0;   // End of what replaced them in the new source.
+    };
+
+    struct IncrementalUnit {
+        Parser                  parser_;
+        std::vector<DeclRecord> records_;       // Parallel to parser_.toplevel_decls_.
+        std::vector<Diagnostic> diagnostics_;   // Checker diagnostics from the last build, sorted by position.
+        IncrementalStats        stats_;
+        size_t                  live_constants_ = 0; // Size of parser_.node_constants_ after it was last compacted.
+    };
+
+    bool incremental_build(IncrementalUnit& unit, Lexer& lxr, const SourceEdit* edit = nullptr);
+    void reset_incremental_unit(IncrementalUnit& unit);
+}
+
+#endif //INCREMENTAL_HPP
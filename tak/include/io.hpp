@@ -5,7 +5,9 @@
 #ifndef IO_HPP
 #define IO_HPP
 #include <string>
+#include <string_view>
 #include <format>
+#include <iterator>
 #include <iostream>
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -43,6 +45,12 @@ namespace tak {
         TSTYLE_UNDERLINE = 1 << 2,
     };
 
+    enum color_mode_t : uint8_t {
+        COLOR_AUTO,   // Only when stdout is a terminal and NO_COLOR isn't set.
+        COLOR_ALWAYS,
+        COLOR_NEVER,
+    };
+
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     void try_enable_windows_virtual_terminal_sequences(); // Enables Windows virtual terminal escape sequences
@@ -50,6 +58,17 @@ namespace tak {
     void term_set_bg(termcolor_bg_t background);          // Sets the terminal background color.
     void term_set_style(uint16_t style_mask);              // Sets the terminal text style (underline, bold, etc).
     void term_reset();                                    // Resets any escape sequences applied.
+    void append_term_codes(std::string& out, termcolor_fg_t foreground, termcolor_bg_t background, uint16_t style_mask);
+
+    void set_color_mode(color_mode_t mode);                // Defaults to COLOR_AUTO.
+    bool output_colors_enabled();                          // Whether escape sequences should be written at all.
+
+    std::ostream& output_stream();                         // Where this thread's output goes, buffered stdout unless redirected.
+    void redirect_output(std::ostream* stream);            // Redirects this thread's output, nullptr goes back to stdout.
+    void write_output(std::string_view text);              // Writes text to this thread's output in one piece.
+    void flush_output();                                   // Pushes anything buffered for stdout to the file descriptor.
+    void write_panic(std::string_view text);               // Flushes stdout, then writes to stderr, wherever this thread's output goes.
+    std::string& format_buffer();                          // Scratch buffer reused by print, one per thread.
 
     /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -72,24 +91,38 @@ namespace tak {
     template<termcolor_fg_t fg = TFG_NONE, termcolor_bg_t bg = TBG_NONE, uint16_t s = TSTYLE_NONE, typename ... Args>
     static void print(const std::format_string<Args...> fmt, Args... args) {
 
-        std::string output;
-        bool term_changed = false;
+        //
+        // The whole line, escape sequences included, is built in this thread's buffer
+        // and handed over in one write, so lines from different threads never interleave.
+        //
+
+        std::string& output = format_buffer();
+        const bool   styled = (fg != TFG_NONE || bg != TBG_NONE || s != TSTYLE_NONE) && output_colors_enabled();
+
+        output.clear();
+        if(styled) {
+            append_term_codes(output, fg, bg, s);
+        }
+
+        const size_t text_begin = output.size();
 
         try {
-            output = std::vformat(fmt.get(), std::make_format_args(args...));
+            std::vformat_to(std::back_inserter(output), fmt.get(), std::make_format_args(args...));
         } catch(const std::format_error& e) {
-            output = std::string("FORMAT ERROR: ") + e.what();
+            output.resize(text_begin);
+            output += "FORMAT ERROR: ";
+            output += e.what();
         } catch(...) {
-            output = "UNKNOWN FORMATTING ERROR";
+            output.resize(text_begin);
+            output += "UNKNOWN FORMATTING ERROR";
         }
 
-        if(fg != TFG_NONE)   { term_set_fg(fg);   term_changed = true; }
-        if(bg != TBG_NONE)   { term_set_bg(bg);   term_changed = true; }
-        if(s != TSTYLE_NONE) { term_set_style(s); term_changed = true; }
-
-        std::cout << output << std::endl;
+        output += '\n';
+        if(styled) {
+            output += "\x1b[m";
+        }
 
-        if(term_changed) term_reset();
+        write_output(output);
     }
 
     template<typename ... Args>
@@ -0,0 +1,51 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef JSON_HPP
+#define JSON_HPP
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Just enough JSON to read what other programs send us (the language server's messages).
+// Writing JSON is done by hand everywhere else, with append_json_string for strings.
+//
+
+namespace tak {
+
+    enum json_kind_t : uint8_t {
+        JSON_NULL,
+        JSON_BOOL,
+        JSON_NUMBER,
+        JSON_STRING,
+        JSON_ARRAY,
+        JSON_OBJECT,
+    };
+
+    struct JsonValue {
+        json_kind_t                                    kind    = JSON_NULL;
+        bool                                           boolean = false;
+        double                                         number  = 0.0;
+        std::string                                    string;
+        std::vector<JsonValue>                         elements;  // Arrays.
+        std::vector<std::pair<std::string, JsonValue>> members;   // Objects, in the order they were written.
+
+        const JsonValue& operator[](std::string_view key) const;  // A null value if there's no such member.
+        bool             has(std::string_view key) const;
+
+        int64_t          as_integer(int64_t otherwise = 0) const;
+        std::string_view as_string() const;                       // Empty unless this is a string.
+    };
+
+    std::optional<JsonValue> parse_json(std::string_view text);
+    std::string              json_to_string(const JsonValue& value);  // Compact, used to echo request IDs back.
+}
+
+#endif //JSON_HPP
@@ -0,0 +1,35 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef LAYOUT_HPP
+#define LAYOUT_HPP
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <parser.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define MAX_STRUCT_ALIGNMENT 4096
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Struct layouts follow the usual C rules: every member is placed at the next offset that fits its
+// alignment, and the size is rounded up to the alignment of the whole struct. @packed drops the padding,
+// @align(N) raises the alignment of the struct to at least N.
+//
+// Layouts are computed on first use and cached in Parser::type_layouts_. Types that can't be laid out
+// (unresolved, or containing themselves by value) never get an entry.
+//
+
+namespace tak {
+    const TypeLayout*       get_type_layout(const std::string& name, Parser& parser);
+    std::optional<uint64_t> get_type_size(const TypeData& type, Parser& parser);
+    std::optional<uint32_t> get_type_alignment(const TypeData& type, Parser& parser);
+    void                    compute_type_layouts(Parser& parser);
+    void                    print_layout_report(Parser& parser);
+}
+
+#endif //LAYOUT_HPP
@@ -21,6 +21,14 @@
 
 namespace tak {
 
+    struct LexerError {
+        std::string message;
+        size_t      position = 0;
+        uint32_t    line     = 0;
+    };
+
+    void capture_lexer_errors(std::vector<LexerError>* errors); // Per thread, errors go here instead of being printed. nullptr prints them again.
+
     class Lexer {
     public:
 
@@ -0,0 +1,95 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef LSP_HPP
+#define LSP_HPP
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <incremental.hpp>
+#include <json.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Language server. Speaks LSP (JSON-RPC with Content-Length headers) and answers diagnostics,
+// hover, go to definition and document symbols for every open document.
+//
+// Every document keeps an IncrementalUnit. On a change, the edit is worked out by comparing the
+// new text against what the unit was last built from, and passed to incremental_build, so that
+// untouched toplevel declarations are reused without even being lexed again and only the affected
+// ones get checked. Before that, the toplevel declarations around the edit are parsed on their own
+// in a scratch parser. While they don't parse (which is most of the time while typing) only those
+// syntax errors are reported and the unit is left alone, so that the next keystroke can still be
+// incremental instead of starting over from nothing.
+//
+// Positions are converted to and from UTF-16 code units, which is what LSP counts in by default.
+//
+
+namespace tak {
+
+    struct LspDocument {
+        std::string         uri;
+        std::string         path;           // Shows up as the file name in messages.
+        int64_t             version = 0;
+        std::string         text;           // What the editor has.
+        std::vector<size_t> line_starts;    // Of text.
+
+        IncrementalUnit     unit;
+        std::string         built_text;     // What unit was last built from, empty if there is no usable build.
+    };
+
+    class LspServer {
+    public:
+
+        void handle(std::string_view payload, std::vector<std::string>& replies);  // Replies are JSON payloads, without headers.
+        bool exited() const;
+        int  exit_code() const;
+
+        const LspDocument* find_document(std::string_view uri) const;
+
+        LspServer()  = default;
+        ~LspServer() = default;
+
+        LspServer(const LspServer&)            = delete;
+        LspServer& operator=(const LspServer&) = delete;
+
+    private:
+
+        void dispatch(const JsonValue& message, std::vector<std::string>& replies);
+        void did_open(const JsonValue& params, std::vector<std::string>& replies);
+        void did_change(const JsonValue& params, std::vector<std::string>& replies);
+        void did_close(const JsonValue& params, std::vector<std::string>& replies);
+
+        LspDocument* document(const JsonValue& params);
+
+        std::unordered_map<std::string, std::unique_ptr<LspDocument>> documents_;
+        bool shutdown_ = false;
+        bool exited_   = false;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    std::string lsp_frame(std::string_view payload);
+    std::string uri_to_path(std::string_view uri);
+    std::string path_to_uri(const std::string& path);
+
+    size_t      lsp_offset(const LspDocument& doc, const JsonValue& position);  // LSP position to an offset into doc.text.
+    std::string lsp_position(const LspDocument& doc, size_t offset);
+    std::string lsp_range(const LspDocument& doc, size_t begin, size_t end);
+
+    void        set_document_text(LspDocument& doc, std::string&& text);
+    bool        apply_document_change(LspDocument& doc, const JsonValue& change);
+    std::string analyze_document(LspDocument& doc);     // Returns the publishDiagnostics notification.
+    SourceEdit  diff_source(std::string_view before, std::string_view after);
+
+    std::string hover_json(LspDocument& doc, const JsonValue& position);
+    std::string definition_json(LspDocument& doc, const JsonValue& position);
+    std::string document_symbols_json(LspDocument& doc);
+}
+
+#endif //LSP_HPP
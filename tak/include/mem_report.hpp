@@ -0,0 +1,38 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef MEM_REPORT_HPP
+#define MEM_REPORT_HPP
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <parser.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Front-end memory accounting. "shallow" is the size of the object itself (the node, or the table entry
+// plus the table's buckets), "heap" is everything it owns through vectors, strings and shared_ptrs.
+// Hash table entry sizes are estimates, the exact node layout is up to the standard library.
+//
+
+namespace tak {
+
+    struct MemReportRow {
+        std::string name;
+        size_t      count   = 0;
+        size_t      shallow = 0;
+        size_t      heap    = 0;
+    };
+
+    struct MemReport {
+        std::vector<MemReportRow> nodes;   // One row per node type that occurs in the AST.
+        std::vector<MemReportRow> tables;  // sym_table_, type_table_, type_aliases_, node_types_.
+    };
+
+    MemReport collect_memory_report(Parser& parser);
+    void      print_memory_report(const MemReport& report);
+}
+
+#endif //MEM_REPORT_HPP
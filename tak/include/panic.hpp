@@ -9,9 +9,8 @@
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-#define panic(message)                                    \
-    tak::print("PANIC :: {}", message);                   \
-    tak::print("FILE: {}\nLINE: {}", __FILE__, __LINE__); \
-    exit(1);                                              \
+#define panic(message)                                                                          \
+    tak::write_panic(tak::fmt("PANIC :: {}\nFILE: {}\nLINE: {}\n", message, __FILE__, __LINE__)); \
+    exit(1);                                                                                    \
 
 #endif //PANIC_HPP
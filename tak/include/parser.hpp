@@ -6,6 +6,7 @@
 #define PARSER_HPP
 #include <ast_types.hpp>
 #include <unordered_map>
+#include <functional>
 #include <lexer.hpp>
 #include <io.hpp>
 #include <panic.hpp>
@@ -72,11 +73,16 @@
 
 namespace tak {
 
+    class DumpWriter;
+
     class Parser {
     public:
 
         uint32_t curr_sym_index_ = INVALID_SYMBOL_INDEX;
         uint16_t inside_parenthesized_expression_ = 0;
+        bool     lazy_proc_bodies_ = false;
+
+        std::vector<std::string>* alias_log_ = nullptr; // If set, every type alias that gets looked up is recorded here.
 
         std::vector<std::string> namespace_stack_;
         std::vector<AstNode*>    toplevel_decls_;
@@ -86,6 +92,11 @@ namespace tak {
         std::unordered_map<std::string, UserType>              type_table_;
         std::unordered_map<std::string, TypeData>              type_aliases_;
 
+        std::vector<TypeData>                       node_types_;     // Interned expression types, AstNode::type_id - 1 indexes into this.
+        std::unordered_multimap<uint64_t, uint32_t> node_type_ids_;  // Type hash -> type ID.
+        std::vector<ConstantValue>                  node_constants_; // Folded constants, AstNode::const_id - 1 indexes into this.
+        std::unordered_map<std::string, TypeLayout> type_layouts_;   // Cache for get_type_layout, cleared when the type table changes.
+
         void push_scope();
         void pop_scope();
 
@@ -110,9 +121,9 @@ namespace tak {
         );
 
 
-        void dump_symbols();
-        void dump_nodes();
-        void dump_types();
+        void dump_symbols(DumpWriter& out);
+        void dump_nodes(DumpWriter& out);
+        void dump_types(DumpWriter& out);
 
         bool enter_namespace(const std::string& name);
         bool namespace_exists(const std::string& name);
@@ -135,22 +146,34 @@ namespace tak {
         bool     create_type_alias(const std::string& name, const TypeData& data);
         bool     type_alias_exists(const std::string& name);
 
+        uint32_t        intern_node_type(const TypeData& type);
+        const TypeData* lookup_node_type(uint32_t type_id);
+        const TypeData* lookup_node_type(const AstNode* node);
+
+        uint32_t             add_node_constant(const ConstantValue& value);
+        const ConstantValue* lookup_node_constant(uint32_t const_id);
+        const ConstantValue* lookup_node_constant(const AstNode* node);
+
         Parser() = default;
         ~Parser();
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-    void display_node_data(AstNode* node, uint32_t depth, Parser& parser);
+    void display_node_data(AstNode* node, uint32_t depth, Parser& parser, DumpWriter& out);
+    void for_each_child(AstNode* node, const std::function<void(AstNode*)>& callback);
+    void walk_ast(AstNode* node, const std::function<void(AstNode*)>& callback);
     std::string format_type_data(const TypeData& type, uint16_t num_tabs = 0);
     std::optional<TypeData> parse_type(Parser& parser, Lexer& lxr);
     std::optional<std::vector<uint32_t>> parse_array_data(Lexer& lxr);
     std::optional<std::string> get_namespaced_identifier(Lexer& lxr);
+    uint32_t intern_type(std::vector<TypeData>& types, std::unordered_multimap<uint64_t, uint32_t>& type_ids, const TypeData& type);
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     AstNode* parse_type_alias(Parser& parser, Lexer& lxr);
     AstNode* parse_callconv(Parser& parser, Lexer& lxr);
+    AstNode* parse_struct_attributes(Parser& parser, Lexer& lxr);
     AstNode* parse_compiler_directive(Parser& parser, Lexer& lxr);
     AstNode* parse_defer(Parser& parser, Lexer& lxr);
     AstNode* parse_defer_if(Parser& parser, Lexer& lxr);
@@ -175,6 +198,7 @@ namespace tak {
     AstNode* parse_inferred_decl(Symbol* var, Parser& parser, Lexer& lxr);
     AstNode* parse_vardecl(Symbol* var, Parser& parser, Lexer& lxr);
     AstNode* parse_procdecl(Symbol* proc, Parser& parser, Lexer& lxr);
+    bool     parse_deferred_body(AstProcdecl* node, Parser& parser, Lexer& lxr);
     AstNode* parse_usertype_decl(Symbol* sym, Parser& parser, Lexer& lxr);
     AstVardecl* parse_parameterized_vardecl(Parser& parser, Lexer& lxr);
     AstNode* parse_proc_ptr(Symbol* proc, Parser& parser, Lexer& lxr);
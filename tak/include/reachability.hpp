@@ -0,0 +1,33 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef REACHABILITY_HPP
+#define REACHABILITY_HPP
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <parser.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Finds the procedures and globals a program can actually reach from a set of entry points,
+// following every identifier in their bodies and initializers. Using a value of a struct type
+// keeps all of that struct's methods, since method calls don't go through identifiers.
+//
+// In lazy mode, bodies are parsed as they're reached, so unreachable ones are never parsed at all.
+//
+
+namespace tak {
+
+    struct Reachability {
+        std::unordered_set<const AstNode*> reachable;    // Procedure and global declarations.
+        std::vector<uint32_t>              unreachable;  // Symbol indices of the declarations left over, in source order.
+    };
+
+    std::optional<Reachability> compute_reachability(Parser& parser, Lexer& lxr, const std::vector<std::string>& entry_points);
+}
+
+#endif //REACHABILITY_HPP
@@ -0,0 +1,51 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef SERVER_HPP
+#define SERVER_HPP
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include <driver.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define TAK_SERVER_MAGIC   0x5653414BU          // "KASV"
+#define TAK_SERVER_VERSION 1
+#define MAX_SERVER_MESSAGE (64U * 1024U * 1024U)
+#define SERVER_RECV_TIMEOUT 5                    // Seconds the server waits on a client that stops sending.
+
+//
+// Compile server. "tak --server" listens on a Unix domain socket and keeps an IncrementalUnit
+// alive for every file it has been asked to compile, so nothing starts cold. "tak --connect"
+// sends the files to compile and writes out whatever comes back, so it looks like a normal compile.
+//
+// A file whose content hash (and display name) didn't change since the last request isn't touched,
+// its previous output and result are sent back as they are. Anything else goes through incremental_build,
+// which only reparses and rechecks the declarations that changed.
+//
+// Every message is a uint32_t length followed by that many bytes. A request is:
+//     uint32_t magic, uint16_t version, uint8_t server_request_t, uint8_t colored, uint32_t file count,
+//     then for every file its display name and absolute path, each as a uint32_t length plus the bytes.
+// A response is a uint8_t result (1 if everything compiled) followed by the output.
+//
+// Only plain compiles can go through the server, see server_can_compile. Unix only.
+//
+
+namespace tak {
+
+    enum server_request_t : uint8_t {
+        SERVER_REQUEST_COMPILE = 1,
+        SERVER_REQUEST_STOP    = 2,
+    };
+
+    std::string         default_server_socket_path();
+    bool                server_can_compile(const CompileOptions& options);
+    bool                run_compile_server(const std::string& socket_path);
+    bool                stop_compile_server(const std::string& socket_path);
+    std::optional<bool> compile_with_server(const std::string& socket_path, const std::vector<std::string>& source_file_names);
+}
+
+#endif //SERVER_HPP
@@ -0,0 +1,236 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// A vector that keeps up to N elements inline, and only goes to the heap once it grows past that.
+// Most child lists in the AST (call arguments, parameters, if bodies) and most array length lists
+// hold a handful of elements, so this saves an allocation per node in the common case.
+// Iterators are plain pointers, and are invalidated by anything that grows the vector.
+//
+
+namespace tak {
+
+    template<typename T, size_t N>
+    class SmallVector {
+        static_assert(N > 0, "SmallVector needs room for at least one inline element.");
+    public:
+        using value_type      = T;
+        using size_type       = size_t;
+        using reference       = T&;
+        using const_reference = const T&;
+        using iterator        = T*;
+        using const_iterator  = const T*;
+
+        T*       begin()        { return data_; }
+        T*       end()          { return data_ + size_; }
+        const T* begin()  const { return data_; }
+        const T* end()    const { return data_ + size_; }
+        const T* cbegin() const { return data_; }
+        const T* cend()   const { return data_ + size_; }
+
+        T*       data()           { return data_; }
+        const T* data()     const { return data_; }
+        size_t   size()     const { return size_; }
+        size_t   capacity() const { return capacity_; }
+        bool     empty()    const { return size_ == 0; }
+        bool     is_inline() const { return data_ == inline_data(); }
+
+        T&       operator[](const size_t index)       { assert(index < size_); return data_[index]; }
+        const T& operator[](const size_t index) const { assert(index < size_); return data_[index]; }
+
+        T&       front()       { assert(size_ != 0); return data_[0]; }
+        const T& front() const { assert(size_ != 0); return data_[0]; }
+        T&       back()        { assert(size_ != 0); return data_[size_ - 1]; }
+        const T& back()  const { assert(size_ != 0); return data_[size_ - 1]; }
+
+        template<typename ... Args>
+        T& emplace_back(Args&&... args) {
+            if(size_ == capacity_) {
+                return grow_and_emplace(std::forward<Args>(args)...);
+            }
+
+            T* elem = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+            ++size_;
+            return *elem;
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value)      { emplace_back(std::move(value)); }
+
+        void pop_back() {
+            assert(size_ != 0);
+            std::destroy_at(data_ + --size_);
+        }
+
+        T* insert(const T* pos, T value) {
+            const size_t index = pos - data_;
+            assert(index <= size_);
+
+            emplace_back(std::move(value));
+            std::rotate(data_ + index, data_ + size_ - 1, data_ + size_);
+            return data_ + index;
+        }
+
+        T* erase(const T* pos) {
+            return erase(pos, pos + 1);
+        }
+
+        T* erase(const T* first, const T* last) {
+            T* const dest  = data_ + (first - data_);
+            T* const src   = data_ + (last - data_);
+            const size_t n = last - first;
+
+            std::move(src, end(), dest);
+            std::destroy(end() - n, end());
+            size_ -= static_cast<uint32_t>(n);
+            return dest;
+        }
+
+        template<typename It>
+        void assign(It first, const It last) {
+            clear();
+            for(; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+
+        void reserve(const size_t new_capacity) {
+            if(new_capacity > capacity_) {
+                reallocate(new_capacity);
+            }
+        }
+
+        void resize(const size_t new_size) {
+            reserve(new_size);
+            while(size_ < new_size) { emplace_back(); }
+            while(size_ > new_size) { pop_back(); }
+        }
+
+        void clear() {
+            std::destroy(begin(), end());
+            size_ = 0;
+        }
+
+        friend bool operator==(const SmallVector& lhs, const SmallVector& rhs) {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        SmallVector() = default;
+        SmallVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+        SmallVector(const SmallVector& other) {
+            reserve(other.size_);
+            std::uninitialized_copy(other.begin(), other.end(), data_);
+            size_ = other.size_;
+        }
+
+        SmallVector(SmallVector&& other) noexcept {
+            take(std::move(other));
+        }
+
+        SmallVector& operator=(const SmallVector& other) {
+            if(this != &other) {
+                clear();
+                reserve(other.size_);
+                std::uninitialized_copy(other.begin(), other.end(), data_);
+                size_ = other.size_;
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept {
+            if(this != &other) {
+                clear();
+                release();
+                take(std::move(other));
+            }
+            return *this;
+        }
+
+        ~SmallVector() {
+            clear();
+            release();
+        }
+
+    private:
+        T*       data_     = inline_data();
+        uint32_t size_     = 0;
+        uint32_t capacity_ = N;
+        alignas(T) unsigned char inline_[sizeof(T) * N];
+
+        T*       inline_data()       { return reinterpret_cast<T*>(inline_); }
+        const T* inline_data() const { return reinterpret_cast<const T*>(inline_); }
+
+        void reallocate(const size_t new_capacity) {
+            T* new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+            std::uninitialized_move(begin(), end(), new_data);
+            std::destroy(begin(), end());
+            release();
+
+            data_     = new_data;
+            capacity_ = static_cast<uint32_t>(new_capacity);
+        }
+
+        template<typename ... Args>
+        T& grow_and_emplace(Args&&... args) {
+
+            //
+            // The new element is constructed before the old ones move,
+            // the arguments might refer to something inside this vector.
+            //
+
+            const size_t new_capacity = capacity_ * 2;
+            T* new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
+            T* elem     = std::construct_at(new_data + size_, std::forward<Args>(args)...);
+
+            std::uninitialized_move(begin(), end(), new_data);
+            std::destroy(begin(), end());
+            release();
+
+            data_     = new_data;
+            capacity_ = static_cast<uint32_t>(new_capacity);
+            ++size_;
+            return *elem;
+        }
+
+        void release() {
+            if(!is_inline()) {
+                ::operator delete(data_);
+                data_     = inline_data();
+                capacity_ = N;
+            }
+        }
+
+        void take(SmallVector&& other) {
+            if(other.is_inline()) {
+                std::uninitialized_move(other.begin(), other.end(), data_);
+                size_ = other.size_;
+                other.clear();
+                return;
+            }
+
+            data_           = other.data_;
+            size_           = other.size_;
+            capacity_       = other.capacity_;
+            other.data_     = other.inline_data();
+            other.size_     = 0;
+            other.capacity_ = N;
+        }
+    };
+}
+
+#endif //SMALL_VECTOR_HPP
@@ -10,6 +10,7 @@
 #include <optional>
 #include <cassert>
 #include <var_types.hpp>
+#include <ast_types.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -29,6 +30,13 @@ namespace tak {
     uint16_t precedence_of(token_t _operator);
     var_t token_to_var_t(token_t tok_t);
     std::string var_t_to_string(var_t type);
+    std::string_view node_type_name(node_t type);
+    ConstantValue make_int_constant(var_t type, uint64_t bits);
+    ConstantValue make_float_constant(var_t type, double value);
+    ConstantValue convert_constant(const ConstantValue& value, var_t to);
+    double constant_to_double(const ConstantValue& value);
+    std::string constant_to_string(const ConstantValue& value);
+    void append_json_string(std::string& out, std::string_view str);
 }
 
 #endif //UTILS_HPP
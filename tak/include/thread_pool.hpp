@@ -0,0 +1,62 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// A fixed set of worker threads, each with its own task queue. Tasks are handed out round-robin,
+// a worker takes from the back of its own queue and steals from the front of the others once it runs dry.
+// Tasks must not throw. submit() and wait() are meant to be called from the thread that owns the pool.
+//
+
+namespace tak {
+
+    class ThreadPool {
+    public:
+
+        void   submit(std::function<void()> task);
+        void   wait();
+        size_t size() const { return workers_.size(); }
+
+        explicit ThreadPool(size_t num_threads);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+    private:
+
+        struct WorkQueue {
+            std::mutex                        lock;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<WorkQueue>> queues_;
+        std::vector<std::thread>                workers_;
+
+        std::mutex              state_lock_;
+        std::condition_variable work_available_;
+        std::condition_variable work_finished_;
+        size_t                  queued_     = 0;  // Submitted, not yet picked up by a worker.
+        size_t                  unfinished_ = 0;  // Submitted, not yet finished.
+        size_t                  next_queue_ = 0;
+        bool                    stopping_   = false;
+
+        bool take_task(size_t index, std::function<void()>& task);
+        void worker_loop(size_t index);
+    };
+}
+
+#endif //THREAD_POOL_HPP
@@ -0,0 +1,71 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef TIME_REPORT_HPP
+#define TIME_REPORT_HPP
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Per-phase wall and CPU time for one compiled file, plus throughput counters and peak memory.
+//
+// CPU time is the compiling thread's, so files compiled at the same time with -j don't show up
+// in each other's reports. Procedure bodies checked on worker threads with --check-threads
+// aren't counted either. Peak memory is the whole process's, and is left out when -j compiles
+// more than one file at once. Lexing is timed in a separate pass after compiling, and shows up
+// as a nested entry so it isn't counted twice.
+//
+
+namespace tak {
+
+    struct PhaseTime {
+        std::string name;
+        double      wall_ms = 0.0;
+        double      cpu_ms  = 0.0;
+        bool        nested  = false;  // Already counted as part of another phase.
+    };
+
+    struct TimeReport {
+        std::string            file;
+        std::vector<PhaseTime> phases;          // In the order they ran.
+
+        uint64_t bytes       = 0;
+        uint64_t tokens      = 0;
+        uint64_t nodes       = 0;
+        uint64_t symbols     = 0;
+        uint64_t types       = 0;
+        uint64_t diagnostics = 0;
+        uint64_t peak_rss    = 0;               // Process-wide, in bytes. 0 if unknown or shared with other files.
+    };
+
+    class PhaseTimer {
+    public:
+
+        PhaseTimer(TimeReport* report, std::string_view name);  // Does nothing if report is null.
+        ~PhaseTimer();
+
+        PhaseTimer(const PhaseTimer&)            = delete;
+        PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+    private:
+        TimeReport*                           report_;
+        std::string_view                      name_;
+        std::chrono::steady_clock::time_point wall_begin_;
+        double                                cpu_begin_ = 0.0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    double      thread_cpu_ms();
+    uint64_t    peak_rss_bytes();
+    void        print_time_report(const TimeReport& report);
+    std::string time_report_json(const TimeReport& report);
+}
+
+#endif //TIME_REPORT_HPP
@@ -0,0 +1,50 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Scoped trace events, written out in the Chrome trace-event format (chrome://tracing, ui.perfetto.dev).
+//
+// Every TraceScope becomes one complete ("X") event on the thread it was created on, so scopes nest
+// the same way they do in the code. While tracing is off a scope costs one atomic load, and its name
+// never gets copied. Tracing is process-wide: every file compiled with -j ends up in the same trace.
+//
+
+namespace tak {
+
+    class TraceScope {
+    public:
+
+        TraceScope(std::string_view category, std::string_view name); // Category must outlive the trace.
+        ~TraceScope();
+
+        void set_name(std::string_view name);  // For scopes that only know what they were about at the end.
+        void cancel();                         // Drops the event.
+
+        TraceScope(const TraceScope&)            = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        bool                                  active_ = false;
+        std::string_view                      category_;
+        std::string                           name_;
+        std::chrono::steady_clock::time_point begin_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    void start_tracing();
+    bool tracing_enabled();
+    bool write_trace(const std::string& path); // Stops tracing.
+}
+
+#endif //TRACE_HPP
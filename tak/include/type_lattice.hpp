@@ -0,0 +1,161 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef TYPE_LATTICE_HPP
+#define TYPE_LATTICE_HPP
+#include <cstdint>
+#include <token.hpp>
+#include <var_types.hpp>
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#define VAR_T_COUNT   (tak::VAR_VOID + 1)
+#define TOKEN_T_COUNT (tak::TOKEN_ARROW + 1)
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+//
+// Every rule the checker has for primitive (non-pointer, non-array) operands, computed once at compile time.
+// The functions in verify.cpp and convert.cpp still handle pointers, structs and procedures themselves,
+// but as soon as both sides are plain primitives the answer is a single lookup into one of these tables.
+//
+// If a rule changes, it changes here. tak_lattice_test checks the tables against the original branch logic.
+//
+
+namespace tak {
+
+    enum operator_rule_t : uint8_t {
+        OPERATOR_RULE_NONE,      // Not an operator the checker knows about.
+        OPERATOR_RULE_ILLEGAL,
+        OPERATOR_RULE_LEGAL,
+        OPERATOR_RULE_MUTABLE,   // Legal, but the operand can't be a constant or an rvalue (assignments).
+    };
+
+    struct PromotionRule {
+        var_t result = VAR_NONE; // VAR_NONE if the non-concrete value can't be coerced at all.
+        bool  widens = false;    // The concrete type is wider, the non-concrete side takes it over entirely.
+    };
+
+    struct TypeLattice {
+        bool            coercible[VAR_T_COUNT][VAR_T_COUNT]       = {}; // [left][right], right assigned to a concrete left.
+        PromotionRule   promotions[VAR_T_COUNT][VAR_T_COUNT]      = {}; // [left][right], left is non-concrete.
+        bool            castable[VAR_T_COUNT][VAR_T_COUNT]        = {}; // [from][to]
+        bool            pointer_castable[VAR_T_COUNT]             = {}; // Can be cast to or from a pointer.
+        operator_rule_t operators[TOKEN_T_COUNT][VAR_T_COUNT]     = {};
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    constexpr uint8_t
+    lattice_size_of(const var_t type) {
+        switch(type) {
+            case VAR_BOOLEAN:
+            case VAR_U8:
+            case VAR_I8:      return 1;
+            case VAR_U16:
+            case VAR_I16:     return 2;
+            case VAR_U32:
+            case VAR_I32:
+            case VAR_F32:     return 4;
+            case VAR_U64:
+            case VAR_I64:
+            case VAR_F64:     return 8;
+            default:          return 0; // VAR_NONE and VAR_VOID don't have a size.
+        }
+    }
+
+    constexpr var_t
+    lattice_to_signed(const var_t type) {
+        switch(type) {
+            case VAR_U8:  return VAR_I8;
+            case VAR_U16: return VAR_I16;
+            case VAR_U32: return VAR_I32;
+            case VAR_U64: return VAR_I64;
+            default:      return type;
+        }
+    }
+
+    constexpr operator_rule_t
+    lattice_operator_rule(const token_t _operator, const var_t type) {
+
+        const auto legal_if = [](const bool condition, const operator_rule_t rule) {
+            return condition ? rule : OPERATOR_RULE_ILLEGAL;
+        };
+
+        const bool arithmetic = type != VAR_VOID;
+        const bool bitwise    = type != VAR_VOID && !PRIMITIVE_IS_FLOAT(type);
+
+        if(_operator == TOKEN_VALUE_ASSIGNMENT)   return OPERATOR_RULE_MUTABLE;
+        if(TOKEN_OP_IS_ARITH_ASSIGN(_operator))   return legal_if(arithmetic, OPERATOR_RULE_MUTABLE);
+        if(TOKEN_OP_IS_ARITHMETIC(_operator))     return legal_if(arithmetic, OPERATOR_RULE_LEGAL);
+        if(TOKEN_OP_IS_BW_ASSIGN(_operator))      return legal_if(bitwise, OPERATOR_RULE_MUTABLE);
+        if(TOKEN_OP_IS_BITWISE(_operator))        return legal_if(bitwise, OPERATOR_RULE_LEGAL);
+        if(TOKEN_OP_IS_LOGICAL(_operator))        return OPERATOR_RULE_LEGAL;
+
+        return OPERATOR_RULE_NONE;
+    }
+
+    constexpr TypeLattice
+    make_type_lattice() {
+
+        TypeLattice lattice;
+        for(uint16_t i = 0; i < VAR_T_COUNT; ++i) {
+            const auto left = static_cast<var_t>(i);
+
+            for(uint16_t j = 0; j < VAR_T_COUNT; ++j) {
+                const auto right     = static_cast<var_t>(j);
+                const bool has_sizes = lattice_size_of(left) != 0 && lattice_size_of(right) != 0;
+
+
+                //
+                // A float can't be assigned to an integer, and nothing can be assigned to a narrower type.
+                // A non-concrete left side (a literal) has no width of its own, so it only follows the float rule,
+                // and becomes signed if either side is.
+                //
+
+                const bool float_to_int = PRIMITIVE_IS_FLOAT(right) && !PRIMITIVE_IS_FLOAT(left);
+
+                lattice.coercible[i][j] = has_sizes && !float_to_int && lattice_size_of(right) <= lattice_size_of(left);
+
+                if(has_sizes && !float_to_int) {
+                    auto& promotion  = lattice.promotions[i][j];
+                    promotion.widens = lattice_size_of(right) > lattice_size_of(left);
+                    promotion.result = promotion.widens ? right : left;
+
+                    if(PRIMITIVE_IS_SIGNED(left) || PRIMITIVE_IS_SIGNED(right)) {
+                        promotion.result = lattice_to_signed(promotion.result);
+                    }
+                }
+
+
+                //
+                // Any primitive can be cast to any other.
+                //
+
+                lattice.castable[i][j] = true;
+            }
+
+            lattice.pointer_castable[i] = left == VAR_U64;
+            for(uint32_t tok = 0; tok < TOKEN_T_COUNT; ++tok) {
+                lattice.operators[tok][i] = lattice_operator_rule(static_cast<token_t>(tok), left);
+            }
+        }
+
+        return lattice;
+    }
+
+    inline constexpr TypeLattice type_lattice = make_type_lattice();
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    static_assert(type_lattice.coercible[VAR_I64][VAR_I32]  && !type_lattice.coercible[VAR_I32][VAR_I64]);
+    static_assert(type_lattice.coercible[VAR_F64][VAR_U32]  && !type_lattice.coercible[VAR_U64][VAR_F32]);
+    static_assert(type_lattice.promotions[VAR_U8][VAR_I32].result == VAR_I32);
+    static_assert(type_lattice.promotions[VAR_U16][VAR_U8].result == VAR_U16 && !type_lattice.promotions[VAR_U16][VAR_U8].widens);
+    static_assert(type_lattice.operators[TOKEN_BITWISE_AND][VAR_F32] == OPERATOR_RULE_ILLEGAL);
+    static_assert(type_lattice.operators[TOKEN_PLUSEQ][VAR_I32] == OPERATOR_RULE_MUTABLE);
+    static_assert(type_lattice.operators[TOKEN_SEMICOLON][VAR_I32] == OPERATOR_RULE_NONE);
+}
+
+#endif //TYPE_LATTICE_HPP
@@ -9,10 +9,14 @@
 #include <string>
 #include <cstdint>
 #include <variant>
+#include <unordered_map>
+#include <small_vector.hpp>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #define INVALID_SYMBOL_INDEX 0
+#define INVALID_TYPE_ID      0
+#define INVALID_CONSTANT_ID  0
 #define MAXIMUM_SYMBOL_COUNT 10000 // unused
 
 #define PRIMITIVE_IS_SIGNED(var_type) \
@@ -28,6 +32,10 @@
     || var_type == VAR_F64                                  \
 )                                                           \
 
+#define PRIMITIVE_IS_INTEGER(var_type) (var_type >= tak::VAR_U8 \
+    && var_type <= tak::VAR_I64                                 \
+)                                                               \
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 namespace tak {
@@ -84,7 +92,7 @@ namespace tak {
         type_kind_t kind           = TYPE_KIND_NONE;
         uint32_t    sym_ref        = INVALID_SYMBOL_INDEX;
 
-        std::vector<uint32_t>                  array_lengths;          // Only multiple elements if matrix
+        SmallVector<uint32_t, 4>               array_lengths;          // Only multiple elements if matrix
         std::shared_ptr<std::vector<TypeData>> parameters  = nullptr;  // Can be null, only used for procedures.
         std::shared_ptr<TypeData>              return_type = nullptr;  // Can be null, only used for procedures.
 
@@ -94,14 +102,22 @@ namespace tak {
         ~TypeData() = default;
     };
 
+    struct ConstantValue {
+        var_t    type = VAR_NONE;  // VAR_NONE if the value isn't known at compile time.
+        uint64_t bits = 0;         // Integers are sign or zero extended to 64 bits, floats are stored as a double.
+
+        bool operator==(const ConstantValue&) const = default;
+    };
+
     struct Symbol {
         uint32_t symbol_index  = INVALID_SYMBOL_INDEX;
         uint32_t flags         = SYM_FLAGS_NONE;
         uint32_t line_number   = 0;
         size_t   src_pos       = 0;
 
-        std::string name;
-        TypeData    type;
+        std::string   name;
+        TypeData      type;
+        ConstantValue constant;    // Only ever set for constants and enum members.
 
         ~Symbol() = default;
         Symbol()  = default;
@@ -118,13 +134,37 @@ namespace tak {
     };
 
     struct UserType {
-        std::vector<MemberData> members;
+        std::vector<MemberData>                   members;
+        std::unordered_map<std::string, uint32_t> member_indices;   // Member and method names -> index into members.
+
         bool     is_placeholder  = false;   // Only set if not resolved yet.
+        bool     is_packed       = false;   // @packed, members are laid out without any padding.
+        uint32_t alignment       = 0;       // @align(N), 0 if the natural alignment is used.
         size_t   pos_first_used  = 0;       // Only used for error handling
         uint32_t line_first_used = 1;       // Only used for error handling
 
+        const MemberData* find_member(const std::string& name) const;
+        bool              add_member(MemberData&& member);  // False if a member or method already has the name.
+        void              reindex_members();                // Call after editing members directly.
+
         ~UserType() = default;
         UserType()  = default;
     };
+
+    struct MemberLayout {
+        uint32_t index   = 0;  // Into UserType::members. Methods don't take up any space, so they don't get one.
+        uint32_t padding = 0;  // Bytes of padding in front of this member.
+        uint64_t offset  = 0;
+        uint64_t size    = 0;
+    };
+
+    struct TypeLayout {
+        uint64_t size         = 0;
+        uint32_t alignment    = 1;
+        uint64_t padding      = 0;  // Every padding byte, including the ones at the end.
+        uint64_t tail_padding = 0;
+
+        std::vector<MemberLayout> members;
+    };
 }
 #endif //SYM_TYPES_HPP
@@ -0,0 +1,364 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <call_graph.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <unordered_set>
+
+using namespace tak;
+
+
+static void
+collect_decls(AstNode* node, std::vector<AstProcdecl*>& procs, std::vector<AstVardecl*>& globals) {
+    if(const auto* nmspace = dynamic_cast<AstNamespaceDecl*>(node)) {
+        for(auto* child : nmspace->children) collect_decls(child, procs, globals);
+    } else if(const auto* compose = dynamic_cast<AstComposeDecl*>(node)) {
+        for(auto* child : compose->children) collect_decls(child, procs, globals);
+    } else if(auto* proc = dynamic_cast<AstProcdecl*>(node)) {
+        procs.emplace_back(proc);
+    } else if(auto* global = dynamic_cast<AstVardecl*>(node)) {
+        globals.emplace_back(global);
+    }
+}
+
+static void
+add_call(CallGraphNode& caller, const uint32_t callee, const call_kind_t kind) {
+
+    const auto edge = std::ranges::find_if(caller.calls, [&](const CallEdge& e) {
+        return e.callee == callee && e.kind == kind;
+    });
+
+    if(edge != caller.calls.end()) {
+        ++edge->count;
+        return;
+    }
+
+    CallEdge& added = caller.calls.emplace_back();
+    added.callee = callee;
+    added.kind   = kind;
+    added.count  = 1;
+}
+
+//
+// Adds the calls made inside of a declaration to its node (if it has one),
+// and flags every procedure it refers to without calling it.
+//
+
+static void
+scan_decl(AstNode* decl, const AstIdentifier* own_identifier, CallGraphNode* caller, CallGraph& graph) {
+
+    std::unordered_set<const AstNode*> call_targets;
+
+    walk_ast(decl, [&](AstNode* node) {
+        if(const auto* call = dynamic_cast<AstCall*>(node)) {
+            const auto* ident  = dynamic_cast<const AstIdentifier*>(call->target);
+            const auto  callee = ident != nullptr ? graph.node_of.find(ident->symbol_index) : graph.node_of.end();
+
+            if(callee == graph.node_of.end()) {
+                if(caller != nullptr) {
+                    add_call(*caller, INVALID_CALL_NODE, CALL_INDIRECT);
+                    caller->flags |= CALL_NODE_INDIRECT;
+                }
+                return;
+            }
+
+            call_targets.emplace(ident);
+            if(caller != nullptr) {
+                add_call(*caller, callee->second, graph.nodes[callee->second].flags & CALL_NODE_METHOD ? CALL_METHOD : CALL_DIRECT);
+            }
+        }
+
+        else if(const auto* ident = dynamic_cast<AstIdentifier*>(node)) {
+            if(ident == own_identifier || call_targets.contains(ident)) {
+                return;
+            }
+
+            if(const auto referenced = graph.node_of.find(ident->symbol_index); referenced != graph.node_of.end()) {
+                graph.nodes[referenced->second].flags |= CALL_NODE_ADDRESS_TAKEN;
+            }
+        }
+    });
+}
+
+
+tak::CallGraph
+tak::build_call_graph(Parser& parser) {
+
+    CallGraph                 graph;
+    std::vector<AstProcdecl*> procs;
+    std::vector<AstVardecl*>  globals;
+
+    for(auto* decl : parser.toplevel_decls_) {
+        collect_decls(decl, procs, globals);
+    }
+
+    graph.nodes.resize(procs.size());
+    for(uint32_t i = 0; i < procs.size(); ++i) {
+        const auto* sym = parser.lookup_unique_symbol(procs[i]->identifier->symbol_index);
+        assert(sym != nullptr);
+
+        graph.nodes[i].proc         = procs[i];
+        graph.nodes[i].symbol_index = sym->symbol_index;
+        graph.nodes[i].flags        = sym->type.flags & TYPE_PROC_METHOD ? CALL_NODE_METHOD : CALL_NODE_FLAGS_NONE;
+        graph.node_of.emplace(sym->symbol_index, i);
+    }
+
+    for(uint32_t i = 0; i < procs.size(); ++i) {
+        scan_decl(procs[i], procs[i]->identifier, &graph.nodes[i], graph);
+    }
+
+    for(auto* global : globals) {
+        scan_decl(global, global->identifier, nullptr, graph);
+    }
+
+    compute_call_graph_sccs(graph);
+    return graph;
+}
+
+
+//
+// Tarjan's algorithm, with an explicit stack so that long call chains can't overflow the real one.
+//
+
+void
+tak::compute_call_graph_sccs(CallGraph& graph) {
+
+    constexpr uint32_t unvisited = UINT32_MAX;
+
+    struct Frame {
+        uint32_t node = 0;
+        uint32_t edge = 0;
+    };
+
+    std::vector<uint32_t> index(graph.nodes.size(), unvisited);
+    std::vector<uint32_t> lowlink(graph.nodes.size(), 0);
+    std::vector<bool>     on_stack(graph.nodes.size(), false);
+    std::vector<uint32_t> stack;
+    std::vector<Frame>    frames;
+    uint32_t              next_index = 0;
+
+    graph.sccs.clear();
+
+    for(uint32_t root = 0; root < graph.nodes.size(); ++root) {
+        if(index[root] != unvisited) {
+            continue;
+        }
+
+        frames.push_back({root, 0});
+        index[root] = lowlink[root] = next_index++;
+        stack.emplace_back(root);
+        on_stack[root] = true;
+
+        while(!frames.empty()) {
+            auto&       frame = frames.back();
+            const auto& calls = graph.nodes[frame.node].calls;
+
+            if(frame.edge < calls.size()) {
+                const uint32_t callee = calls[frame.edge++].callee;
+                if(callee == INVALID_CALL_NODE) {
+                    continue;
+                }
+
+                if(index[callee] == unvisited) {
+                    index[callee] = lowlink[callee] = next_index++;
+                    stack.emplace_back(callee);
+                    on_stack[callee] = true;
+                    frames.push_back({callee, 0});
+                } else if(on_stack[callee]) {
+                    lowlink[frame.node] = std::min(lowlink[frame.node], index[callee]);
+                }
+
+                continue;
+            }
+
+            const uint32_t node = frame.node;
+            frames.pop_back();
+
+            if(!frames.empty()) {
+                lowlink[frames.back().node] = std::min(lowlink[frames.back().node], lowlink[node]);
+            }
+
+            if(lowlink[node] != index[node]) {
+                continue;
+            }
+
+            auto&          scc = graph.sccs.emplace_back();
+            const uint32_t id  = static_cast<uint32_t>(graph.sccs.size() - 1);
+            uint32_t       member;
+
+            do {
+                member = stack.back();
+                stack.pop_back();
+                on_stack[member] = false;
+                graph.nodes[member].scc = id;
+                scc.emplace_back(member);
+            } while(member != node);
+
+            std::ranges::reverse(scc);
+        }
+    }
+
+    for(uint32_t i = 0; i < graph.nodes.size(); ++i) {
+        auto& node = graph.nodes[i];
+        const bool calls_itself = std::ranges::any_of(node.calls, [&](const CallEdge& edge) { return edge.callee == i; });
+
+        if(graph.sccs[node.scc].size() > 1 || calls_itself) {
+            node.flags |= CALL_NODE_RECURSIVE;
+        } else {
+            node.flags &= ~CALL_NODE_RECURSIVE;
+        }
+    }
+}
+
+
+//
+// Export.
+//
+
+static std::string
+dot_escape(const std::string& str) {
+
+    std::string escaped;
+    escaped.reserve(str.size());
+
+    for(const char c : str) {
+        if(c == '\\' || c == '"') escaped += '\\';
+        escaped += c;
+    }
+
+    return escaped;
+}
+
+bool
+tak::write_call_graph_dot(const CallGraph& graph, Parser& parser, const std::string& path) {
+
+    std::ofstream output(path, std::ios::trunc);
+    if(!output.is_open()) {
+        print("Could not open call graph \"{}\" for writing.", path);
+        return false;
+    }
+
+    bool has_indirect = false;
+    output << "digraph calls {\n";
+    output << "  node [shape=box, fontname=\"monospace\"];\n";
+
+    for(uint32_t i = 0; i < graph.nodes.size(); ++i) {
+        const auto& node = graph.nodes[i];
+        const auto* sym  = parser.lookup_unique_symbol(node.symbol_index);
+
+        output << fmt("  n{} [label=\"{}\"{}];\n", i, dot_escape(sym->name),
+            node.flags & CALL_NODE_RECURSIVE ? ", style=filled, fillcolor=\"#f4cccc\"" : "");
+
+        has_indirect = has_indirect || node.flags & CALL_NODE_INDIRECT;
+    }
+
+    if(has_indirect) {
+        output << "  indirect [shape=diamond, label=\"indirect\"];\n";
+    }
+
+    for(uint32_t i = 0; i < graph.sccs.size(); ++i) {
+        if(graph.sccs[i].size() < 2) {
+            continue;
+        }
+
+        output << fmt("  subgraph cluster_{} {{\n    label=\"recursive component {}\";\n   ", i, i);
+        for(const uint32_t member : graph.sccs[i]) {
+            output << fmt(" n{};", member);
+        }
+        output << "\n  }\n";
+    }
+
+    for(uint32_t i = 0; i < graph.nodes.size(); ++i) {
+        for(const auto& edge : graph.nodes[i].calls) {
+            std::string attributes;
+            if(edge.kind == CALL_METHOD)   attributes += "style=dashed";
+            if(edge.kind == CALL_INDIRECT) attributes += "style=dotted";
+            if(edge.count > 1) {
+                attributes += fmt("{}label=\"x{}\"", attributes.empty() ? "" : ", ", edge.count);
+            }
+
+            output << fmt("  n{} -> {}", i, edge.callee == INVALID_CALL_NODE ? "indirect" : fmt("n{}", edge.callee));
+            output << (attributes.empty() ? ";\n" : fmt(" [{}];\n", attributes));
+        }
+    }
+
+    output << "}\n";
+    if(!output) {
+        print("Failed to write call graph \"{}\".", path);
+        return false;
+    }
+
+    return true;
+}
+
+template<typename T>
+static void
+write_array(std::ofstream& output, const std::vector<T>& values) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    output.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+bool
+tak::write_call_graph_binary(const CallGraph& graph, Parser& parser, const std::string& path) {
+
+    CallGraphHeader                  header;
+    std::vector<CallGraphNodeRecord> nodes;
+    std::vector<CallGraphEdgeRecord> edges;
+    std::vector<uint32_t>            members;
+    std::vector<char>                strings;
+
+    for(const auto& node : graph.nodes) {
+        const auto* sym    = parser.lookup_unique_symbol(node.symbol_index);
+        auto&       record = nodes.emplace_back();
+
+        record.name_offset = static_cast<uint32_t>(strings.size());
+        record.name_length = static_cast<uint32_t>(sym->name.size());
+        record.first_edge  = static_cast<uint32_t>(edges.size());
+        record.edge_count  = static_cast<uint32_t>(node.calls.size());
+        record.scc         = node.scc;
+        record.flags       = node.flags;
+
+        strings.insert(strings.end(), sym->name.begin(), sym->name.end());
+        for(const auto& edge : node.calls) {
+            auto& edge_record  = edges.emplace_back();
+            edge_record.callee = edge.callee;
+            edge_record.kind   = edge.kind;
+            edge_record.count  = edge.count;
+        }
+    }
+
+    std::vector<uint32_t> scc_sizes;
+    for(const auto& scc : graph.sccs) {
+        scc_sizes.emplace_back(static_cast<uint32_t>(scc.size()));
+        members.insert(members.end(), scc.begin(), scc.end());
+    }
+
+    header.node_count   = static_cast<uint32_t>(nodes.size());
+    header.edge_count   = static_cast<uint32_t>(edges.size());
+    header.scc_count    = static_cast<uint32_t>(graph.sccs.size());
+    header.strings_size = static_cast<uint32_t>(strings.size());
+
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    if(!output.is_open()) {
+        print("Could not open call graph \"{}\" for writing.", path);
+        return false;
+    }
+
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(output, nodes);
+    write_array(output, edges);
+    write_array(output, scc_sizes);
+    write_array(output, members);
+    write_array(output, strings);
+
+    if(!output) {
+        print("Failed to write call graph \"{}\".", path);
+        return false;
+    }
+
+    return true;
+}
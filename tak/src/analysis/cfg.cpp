@@ -0,0 +1,339 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <cfg.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <algorithm>
+
+using namespace tak;
+
+
+struct LoopTargets {
+    uint32_t brk  = INVALID_BLOCK_ID;
+    uint32_t cont = INVALID_BLOCK_ID;
+};
+
+struct CfgBuilder {
+    ControlFlowGraph&        cfg;
+    std::vector<LoopTargets> loops;
+    uint32_t                 current = CFG_ENTRY_BLOCK; // INVALID_BLOCK_ID right after a ret, brk or cont.
+
+    explicit CfgBuilder(ControlFlowGraph& cfg) : cfg(cfg) {}
+};
+
+
+static uint32_t
+new_block(CfgBuilder& builder) {
+    builder.cfg.blocks.emplace_back();
+    return static_cast<uint32_t>(builder.cfg.blocks.size() - 1);
+}
+
+static void
+add_edge(CfgBuilder& builder, const uint32_t from, const uint32_t to) {
+
+    if(from == INVALID_BLOCK_ID) {
+        return;
+    }
+
+    auto& succs = builder.cfg.blocks[from].succs;
+    if(std::find(succs.begin(), succs.end(), to) == succs.end()) {
+        succs.emplace_back(to);
+        builder.cfg.blocks[to].preds.emplace_back(from);
+    }
+}
+
+static void
+append_node(CfgBuilder& builder, AstNode* node) {
+
+    //
+    // Anything after a ret, brk or cont still gets a block, it just has no predecessors.
+    //
+
+    if(builder.current == INVALID_BLOCK_ID) {
+        builder.current = new_block(builder);
+    }
+
+    builder.cfg.blocks[builder.current].nodes.emplace_back(node);
+}
+
+static void visit_stmt(CfgBuilder& builder, AstNode* node);
+
+template<typename T>
+static void
+visit_body(CfgBuilder& builder, const T& body) {
+    for(AstNode* node : body) {
+        visit_stmt(builder, node);
+    }
+}
+
+
+static void
+visit_branch(CfgBuilder& builder, const AstBranch* node) {
+
+    const uint32_t join = new_block(builder);
+    for(AstIf* _if : node->conditions) {
+        append_node(builder, _if->condition);
+
+        const uint32_t cond = builder.current;
+        const uint32_t then = new_block(builder);
+        const uint32_t next = new_block(builder);
+
+        add_edge(builder, cond, then);
+        add_edge(builder, cond, next);
+
+        builder.current = then;
+        visit_body(builder, _if->body);
+        add_edge(builder, builder.current, join);
+        builder.current = next;
+    }
+
+    if(node->_else) {
+        visit_body(builder, (*node->_else)->body);
+    }
+
+    add_edge(builder, builder.current, join);
+    builder.current = join;
+}
+
+static void
+visit_while(CfgBuilder& builder, const AstWhile* node) {
+
+    const uint32_t header = new_block(builder);
+    const uint32_t body   = new_block(builder);
+    const uint32_t after  = new_block(builder);
+
+    add_edge(builder, builder.current, header);
+    builder.cfg.blocks[header].nodes.emplace_back(node->condition);
+    add_edge(builder, header, body);
+    add_edge(builder, header, after);
+
+    builder.loops.emplace_back(LoopTargets{after, header});
+    builder.current = body;
+    visit_body(builder, node->body);
+    add_edge(builder, builder.current, header);
+    builder.loops.pop_back();
+
+    builder.current = after;
+}
+
+static void
+visit_dowhile(CfgBuilder& builder, const AstDoWhile* node) {
+
+    const uint32_t body  = new_block(builder);
+    const uint32_t cond  = new_block(builder);
+    const uint32_t after = new_block(builder);
+
+    add_edge(builder, builder.current, body);
+
+    builder.loops.emplace_back(LoopTargets{after, cond});
+    builder.current = body;
+    visit_body(builder, node->body);
+    add_edge(builder, builder.current, cond);
+    builder.loops.pop_back();
+
+    builder.cfg.blocks[cond].nodes.emplace_back(node->condition);
+    add_edge(builder, cond, body);
+    add_edge(builder, cond, after);
+
+    builder.current = after;
+}
+
+static void
+visit_for(CfgBuilder& builder, const AstFor* node) {
+
+    if(node->init) {
+        append_node(builder, *node->init);
+    }
+
+    const uint32_t header = new_block(builder);
+    const uint32_t body   = new_block(builder);
+    const uint32_t update = new_block(builder);
+    const uint32_t after  = new_block(builder);
+
+    add_edge(builder, builder.current, header);
+    add_edge(builder, header, body);
+
+    if(node->condition) {
+        builder.cfg.blocks[header].nodes.emplace_back(*node->condition);
+        add_edge(builder, header, after);
+    }
+
+    builder.loops.emplace_back(LoopTargets{after, update});
+    builder.current = body;
+    visit_body(builder, node->body);
+    add_edge(builder, builder.current, update);
+    builder.loops.pop_back();
+
+    if(node->update) {
+        builder.cfg.blocks[update].nodes.emplace_back(*node->update);
+    }
+
+    add_edge(builder, update, header);
+    builder.current = after;
+}
+
+static void
+visit_switch(CfgBuilder& builder, const AstSwitch* node) {
+
+    //
+    // A case declared with "fallthrough" runs into the next case (or the default) once its body ends.
+    // Switches don't catch brk or cont, those belong to the enclosing loop.
+    //
+
+    append_node(builder, node->target);
+
+    const uint32_t dispatch = builder.current;
+    const uint32_t after    = new_block(builder);
+
+    std::vector<uint32_t> targets;
+    for(size_t i = 0; i < node->cases.size(); ++i) {
+        targets.emplace_back(new_block(builder));
+    }
+
+    const uint32_t _default = node->_default != nullptr ? new_block(builder) : after;
+    for(const uint32_t target : targets) {
+        add_edge(builder, dispatch, target);
+    }
+
+    add_edge(builder, dispatch, _default);
+    for(size_t i = 0; i < node->cases.size(); ++i) {
+        builder.current = targets[i];
+        visit_body(builder, node->cases[i]->body);
+
+        if(node->cases[i]->fallthrough) {
+            add_edge(builder, builder.current, i + 1 < targets.size() ? targets[i + 1] : _default);
+        } else {
+            add_edge(builder, builder.current, after);
+        }
+    }
+
+    if(node->_default != nullptr) {
+        builder.current = _default;
+        visit_body(builder, node->_default->body);
+        add_edge(builder, builder.current, after);
+    }
+
+    builder.current = after;
+}
+
+static void
+visit_stmt(CfgBuilder& builder, AstNode* node) {
+
+    switch(node->type) {
+        case NODE_BRANCH:  visit_branch(builder, dynamic_cast<AstBranch*>(node)); break;
+        case NODE_WHILE:   visit_while(builder, dynamic_cast<AstWhile*>(node)); break;
+        case NODE_DOWHILE: visit_dowhile(builder, dynamic_cast<AstDoWhile*>(node)); break;
+        case NODE_FOR:     visit_for(builder, dynamic_cast<AstFor*>(node)); break;
+        case NODE_SWITCH:  visit_switch(builder, dynamic_cast<AstSwitch*>(node)); break;
+        case NODE_BLOCK:   visit_body(builder, dynamic_cast<AstBlock*>(node)->children); break;
+
+        case NODE_RET:
+            append_node(builder, node);
+            add_edge(builder, builder.current, CFG_EXIT_BLOCK);
+            builder.current = INVALID_BLOCK_ID;
+            break;
+
+        case NODE_BRK:
+        case NODE_CONT:
+            append_node(builder, node);
+            if(!builder.loops.empty()) {
+                const auto& loop = builder.loops.back();
+                add_edge(builder, builder.current, node->type == NODE_BRK ? loop.brk : loop.cont);
+                builder.current = INVALID_BLOCK_ID;
+            }
+            break;
+
+        default:
+            append_node(builder, node);
+            break;
+    }
+}
+
+
+std::vector<uint32_t>
+tak::cfg_reverse_postorder(const ControlFlowGraph& cfg, const uint32_t root, const bool backward) {
+
+    std::vector<uint32_t> postorder;
+    std::vector<bool>     visited(cfg.blocks.size(), false);
+    std::vector<std::pair<uint32_t, uint32_t>> stack; // Block and the index of the next edge to follow.
+
+    const auto edges_of = [&](const uint32_t block) -> const SmallVector<uint32_t, 2>& {
+        return backward ? cfg.blocks[block].preds : cfg.blocks[block].succs;
+    };
+
+    stack.emplace_back(root, 0);
+    visited[root] = true;
+
+    while(!stack.empty()) {
+        auto& [block, next] = stack.back();
+        const auto& edges   = edges_of(block);
+
+        if(next < edges.size()) {
+            const uint32_t to = edges[next++];
+            if(!visited[to]) {
+                visited[to] = true;
+                stack.emplace_back(to, 0);
+            }
+        } else {
+            postorder.emplace_back(block);
+            stack.pop_back();
+        }
+    }
+
+    std::ranges::reverse(postorder);
+    return postorder;
+}
+
+tak::ControlFlowGraph
+tak::build_cfg(const AstProcdecl* proc) {
+
+    assert(proc != nullptr);
+    assert(!proc->deferred_body);
+
+    ControlFlowGraph cfg;
+    CfgBuilder       builder{cfg};
+
+    cfg.proc = proc;
+    cfg.blocks.resize(2);
+
+    visit_body(builder, proc->body);
+    add_edge(builder, builder.current, CFG_EXIT_BLOCK);
+
+    cfg.reverse_postorder = cfg_reverse_postorder(cfg, CFG_ENTRY_BLOCK, false);
+    cfg.rpo_index.assign(cfg.blocks.size(), INVALID_BLOCK_ID);
+
+    for(uint32_t i = 0; i < cfg.reverse_postorder.size(); ++i) {
+        cfg.rpo_index[cfg.reverse_postorder[i]] = i;
+    }
+
+    return cfg;
+}
+
+void
+tak::dump_cfg(const ControlFlowGraph& cfg, Parser& parser) {
+
+    const auto* sym = parser.lookup_unique_symbol(cfg.proc->identifier->symbol_index);
+    print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("CFG for {} ({} blocks)", sym->name, cfg.blocks.size());
+
+    for(uint32_t i = 0; i < cfg.blocks.size(); ++i) {
+        const auto& block = cfg.blocks[i];
+
+        std::string succs;
+        for(const uint32_t succ : block.succs) {
+            succs += (succs.empty() ? "" : ", ") + std::to_string(succ);
+        }
+
+        print("  block {}{}{} -> [{}]",
+            i,
+            i == CFG_ENTRY_BLOCK ? " (entry)" : i == CFG_EXIT_BLOCK ? " (exit)" : "",
+            cfg.is_reachable(i) ? "" : " (unreachable)",
+            succs
+        );
+
+        for(const AstNode* node : block.nodes) {
+            print("    {} @ {}", node_type_name(node->type), node->pos);
+        }
+    }
+}
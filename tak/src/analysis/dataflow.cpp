@@ -0,0 +1,150 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <dataflow.hpp>
+#include <algorithm>
+#include <cassert>
+#include <bit>
+#include <deque>
+
+
+void
+tak::BitVector::set_all() {
+    std::ranges::fill(words_, ~uint64_t{0});
+    if(size_ % 64 != 0) {
+        words_.back() &= (uint64_t{1} << (size_ % 64)) - 1; // Keeps operator== and count() exact.
+    }
+}
+
+void
+tak::BitVector::reset_all() {
+    std::ranges::fill(words_, 0);
+}
+
+size_t
+tak::BitVector::count() const {
+    size_t total = 0;
+    for(const uint64_t word : words_) {
+        total += std::popcount(word);
+    }
+
+    return total;
+}
+
+void
+tak::BitVector::union_with(const BitVector& other) {
+    assert(size_ == other.size_);
+    for(size_t i = 0; i < words_.size(); ++i) words_[i] |= other.words_[i];
+}
+
+void
+tak::BitVector::intersect_with(const BitVector& other) {
+    assert(size_ == other.size_);
+    for(size_t i = 0; i < words_.size(); ++i) words_[i] &= other.words_[i];
+}
+
+void
+tak::BitVector::subtract(const BitVector& other) {
+    assert(size_ == other.size_);
+    for(size_t i = 0; i < words_.size(); ++i) words_[i] &= ~other.words_[i];
+}
+
+
+tak::DataflowProblem
+tak::make_dataflow_problem(const ControlFlowGraph& cfg, const dataflow_direction_t direction, const dataflow_meet_t meet, const size_t num_bits) {
+
+    DataflowProblem problem;
+    problem.direction = direction;
+    problem.meet      = meet;
+    problem.num_bits  = num_bits;
+    problem.boundary  = BitVector(num_bits);
+
+    problem.gen.assign(cfg.blocks.size(), BitVector(num_bits));
+    problem.kill.assign(cfg.blocks.size(), BitVector(num_bits));
+    return problem;
+}
+
+tak::DataflowResult
+tak::solve_dataflow(const ControlFlowGraph& cfg, const DataflowProblem& problem) {
+
+    assert(problem.gen.size() == cfg.blocks.size() && problem.kill.size() == cfg.blocks.size());
+
+    const bool     forward  = problem.direction == DATAFLOW_FORWARD;
+    const uint32_t boundary = forward ? CFG_ENTRY_BLOCK : CFG_EXIT_BLOCK;
+
+    BitVector top(problem.num_bits);
+    if(problem.meet == DATAFLOW_INTERSECTION) {
+        top.set_all();
+    }
+
+    //
+    // "before" is the side facts flow in from, "after" the side the transfer function produces.
+    // Forward that's in and out, backward it's the other way around.
+    //
+
+    DataflowResult result;
+    result.in.assign(cfg.blocks.size(), top);
+    result.out.assign(cfg.blocks.size(), top);
+
+    auto& before = forward ? result.in  : result.out;
+    auto& after  = forward ? result.out : result.in;
+
+    std::deque<uint32_t> worklist;
+    std::vector<bool>    on_list(cfg.blocks.size(), false);
+
+    if(forward) {
+        worklist.assign(cfg.reverse_postorder.begin(), cfg.reverse_postorder.end());
+    } else {
+        worklist.assign(cfg.reverse_postorder.rbegin(), cfg.reverse_postorder.rend());
+    }
+
+    for(const uint32_t block : worklist) {
+        on_list[block] = true;
+    }
+
+    while(!worklist.empty()) {
+        const uint32_t block = worklist.front();
+        worklist.pop_front();
+        on_list[block] = false;
+        ++result.visits;
+
+        if(block == boundary) {
+            before[block] = problem.boundary;
+        } else {
+            bool first = true;
+            for(const uint32_t edge : forward ? cfg.blocks[block].preds : cfg.blocks[block].succs) {
+                if(!cfg.is_reachable(edge)) {
+                    continue;
+                }
+
+                if(first) {
+                    before[block] = after[edge];
+                    first = false;
+                } else if(problem.meet == DATAFLOW_UNION) {
+                    before[block].union_with(after[edge]);
+                } else {
+                    before[block].intersect_with(after[edge]);
+                }
+            }
+        }
+
+        BitVector value = before[block];
+        value.subtract(problem.kill[block]);
+        value.union_with(problem.gen[block]);
+
+        if(value == after[block]) {
+            continue;
+        }
+
+        after[block] = std::move(value);
+        for(const uint32_t edge : forward ? cfg.blocks[block].succs : cfg.blocks[block].preds) {
+            if(cfg.is_reachable(edge) && !on_list[edge]) {
+                on_list[edge] = true;
+                worklist.emplace_back(edge);
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,131 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <cfg.hpp>
+
+//
+// Dominators are computed with the iterative algorithm from Cooper, Harvey and Kennedy,
+// "A Simple, Fast Dominance Algorithm". Blocks are visited in reverse postorder, which makes
+// it converge in two or three passes for the graphs the parser can produce.
+//
+// Post-dominators are the same thing on the reversed graph, rooted at the exit.
+// Blocks that never reach the exit (the inside of an infinite loop) don't get a post-dominator.
+//
+
+using namespace tak;
+
+
+static uint32_t
+intersect(uint32_t first, uint32_t second, const std::vector<uint32_t>& idom, const std::vector<uint32_t>& order) {
+    while(first != second) {
+        while(order[first] > order[second]) first  = idom[first];
+        while(order[second] > order[first]) second = idom[second];
+    }
+
+    return first;
+}
+
+static void
+number_tree(DominatorTree& tree) {
+
+    //
+    // Preorder positions and subtree ends turn dominates() into a range check.
+    //
+
+    const size_t num_blocks = tree.idom.size();
+    std::vector<std::vector<uint32_t>> children(num_blocks);
+
+    for(uint32_t block = 0; block < num_blocks; ++block) {
+        if(tree.idom[block] != INVALID_BLOCK_ID) {
+            children[tree.idom[block]].emplace_back(block);
+        }
+    }
+
+    tree.preorder.assign(num_blocks, INVALID_BLOCK_ID);
+    tree.subtree_end.assign(num_blocks, INVALID_BLOCK_ID);
+
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    uint32_t position = 0;
+
+    stack.emplace_back(tree.root, 0);
+    tree.preorder[tree.root] = position++;
+
+    while(!stack.empty()) {
+        auto& [block, next] = stack.back();
+        if(next < children[block].size()) {
+            const uint32_t child  = children[block][next++];
+            tree.preorder[child]  = position++;
+            stack.emplace_back(child, 0);
+        } else {
+            tree.subtree_end[block] = position;
+            stack.pop_back();
+        }
+    }
+}
+
+static DominatorTree
+compute_tree(const ControlFlowGraph& cfg, const uint32_t root, const bool backward) {
+
+    const auto rpo = backward ? cfg_reverse_postorder(cfg, root, true) : cfg.reverse_postorder;
+
+    DominatorTree tree;
+    tree.root = root;
+    tree.idom.assign(cfg.blocks.size(), INVALID_BLOCK_ID);
+
+    std::vector<uint32_t> order(cfg.blocks.size(), INVALID_BLOCK_ID);
+    for(uint32_t i = 0; i < rpo.size(); ++i) {
+        order[rpo[i]] = i;
+    }
+
+    tree.idom[root] = root;
+    bool changed    = true;
+
+    while(changed) {
+        changed = false;
+        for(const uint32_t block : rpo) {
+            if(block == root) {
+                continue;
+            }
+
+            uint32_t new_idom = INVALID_BLOCK_ID;
+            for(const uint32_t pred : backward ? cfg.blocks[block].succs : cfg.blocks[block].preds) {
+                if(tree.idom[pred] == INVALID_BLOCK_ID) {
+                    continue; // Not processed yet, or not reachable from the root.
+                }
+
+                new_idom = new_idom == INVALID_BLOCK_ID ? pred : intersect(pred, new_idom, tree.idom, order);
+            }
+
+            if(tree.idom[block] != new_idom) {
+                tree.idom[block] = new_idom;
+                changed = true;
+            }
+        }
+    }
+
+    tree.idom[root] = INVALID_BLOCK_ID;
+    number_tree(tree);
+    return tree;
+}
+
+
+bool
+tak::DominatorTree::dominates(const uint32_t dominator, const uint32_t block) const {
+
+    if(preorder[dominator] == INVALID_BLOCK_ID || preorder[block] == INVALID_BLOCK_ID) {
+        return false;
+    }
+
+    return preorder[dominator] <= preorder[block] && preorder[block] < subtree_end[dominator];
+}
+
+tak::DominatorTree
+tak::compute_dominators(const ControlFlowGraph& cfg) {
+    return compute_tree(cfg, CFG_ENTRY_BLOCK, false);
+}
+
+tak::DominatorTree
+tak::compute_post_dominators(const ControlFlowGraph& cfg) {
+    return compute_tree(cfg, CFG_EXIT_BLOCK, true);
+}
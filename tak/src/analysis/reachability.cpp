@@ -0,0 +1,141 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <reachability.hpp>
+#include <io.hpp>
+#include <unordered_map>
+
+using namespace tak;
+
+
+struct ReachabilityState {
+    Parser&                                   parser;
+    std::unordered_map<uint32_t, AstNode*>    decls;          // Symbol index -> procedure or global declaration.
+    std::unordered_set<std::string>           visited_types;
+    std::vector<AstNode*>                     worklist;
+    Reachability                              result;
+
+    explicit ReachabilityState(Parser& parser) : parser(parser) {}
+};
+
+
+static void
+collect_decls(AstNode* node, std::vector<AstNode*>& decls) {
+    if(const auto* nmspace = dynamic_cast<AstNamespaceDecl*>(node)) {
+        for(auto* child : nmspace->children) collect_decls(child, decls);
+    } else if(const auto* compose = dynamic_cast<AstComposeDecl*>(node)) {
+        for(auto* child : compose->children) collect_decls(child, decls);
+    } else if(node->type == NODE_PROCDECL || node->type == NODE_VARDECL) {
+        decls.emplace_back(node);
+    }
+}
+
+static uint32_t
+declared_symbol(const AstNode* decl) {
+    if(const auto* proc = dynamic_cast<const AstProcdecl*>(decl)) {
+        return proc->identifier->symbol_index;
+    }
+
+    return dynamic_cast<const AstVardecl*>(decl)->identifier->symbol_index;
+}
+
+static void
+reach_symbol(ReachabilityState& state, uint32_t symbol_index);
+
+static void
+reach_type(ReachabilityState& state, const TypeData& type) {
+
+    if(const auto* name = std::get_if<std::string>(&type.name)) {
+        if(!state.visited_types.emplace(*name).second || !state.parser.type_exists(*name)) {
+            return;
+        }
+
+        for(const auto& member : state.parser.lookup_type(*name)->members) {
+            if(member.type.sym_ref != INVALID_SYMBOL_INDEX) {
+                reach_symbol(state, member.type.sym_ref);
+            } else {
+                reach_type(state, member.type);
+            }
+        }
+    }
+
+    if(type.return_type != nullptr) {
+        reach_type(state, *type.return_type);
+    }
+
+    if(type.parameters != nullptr) {
+        for(const auto& param : *type.parameters) reach_type(state, param);
+    }
+}
+
+static void
+reach_symbol(ReachabilityState& state, const uint32_t symbol_index) {
+
+    const auto decl = state.decls.find(symbol_index);
+    if(decl != state.decls.end() && state.result.reachable.emplace(decl->second).second) {
+        state.worklist.emplace_back(decl->second);
+    }
+}
+
+
+std::optional<tak::Reachability>
+tak::compute_reachability(Parser& parser, Lexer& lxr, const std::vector<std::string>& entry_points) {
+
+    ReachabilityState     state{parser};
+    std::vector<AstNode*> decls;
+
+    for(auto* node : parser.toplevel_decls_) {
+        collect_decls(node, decls);
+    }
+
+    std::unordered_map<std::string, uint32_t> by_name;
+    for(auto* decl : decls) {
+        const uint32_t symbol_index = declared_symbol(decl);
+        state.decls.emplace(symbol_index, decl);
+        by_name.emplace(parser.lookup_unique_symbol(symbol_index)->name, symbol_index);
+    }
+
+
+    //
+    // Entry points can be written with or without the leading namespace separator, "main" or "\main".
+    //
+
+    for(const auto& name : entry_points) {
+        const auto entry = by_name.find(name.starts_with('\\') ? name : '\\' + name);
+        if(entry == by_name.end()) {
+            print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("{}: no procedure or global named \"{}\" to use as an entry point.", lxr.source_file_name_, name);
+            return std::nullopt;
+        }
+
+        reach_symbol(state, entry->second);
+    }
+
+    while(!state.worklist.empty()) {
+        auto* decl = state.worklist.back();
+        state.worklist.pop_back();
+
+        auto* proc = dynamic_cast<AstProcdecl*>(decl);
+        if(proc != nullptr && proc->deferred_body && !parse_deferred_body(proc, parser, lxr)) {
+            return std::nullopt;
+        }
+
+        reach_type(state, parser.lookup_unique_symbol(declared_symbol(decl))->type);
+        walk_ast(decl, [&](AstNode* node) {
+            if(const auto* ident = dynamic_cast<AstIdentifier*>(node)) {
+                if(const auto* sym = parser.lookup_unique_symbol(ident->symbol_index)) {
+                    reach_symbol(state, ident->symbol_index);
+                    reach_type(state, sym->type);
+                }
+            }
+        });
+    }
+
+    for(auto* decl : decls) {
+        if(!state.result.reachable.contains(decl)) {
+            state.result.unreachable.emplace_back(declared_symbol(decl));
+        }
+    }
+
+    return std::move(state.result);
+}
@@ -3,6 +3,7 @@
 //
 
 #include <checker.hpp>
+#include <type_lattice.hpp>
 
 
 template<typename T>
@@ -88,7 +89,6 @@ tak::type_promote_non_concrete(TypeData& left, const TypeData& right) {
 
     const auto* pleft_t  = std::get_if<var_t>(&left.name);
     const auto* pright_t = std::get_if<var_t>(&right.name);
-    bool is_signed       = false;
 
     assert(left.flags & TYPE_NON_CONCRETE);
     assert(left.pointer_depth == 0    && right.pointer_depth == 0);
@@ -96,25 +96,16 @@ tak::type_promote_non_concrete(TypeData& left, const TypeData& right) {
     assert(pleft_t != nullptr         && pright_t != nullptr);
 
 
-    if(PRIMITIVE_IS_SIGNED(*pleft_t) || PRIMITIVE_IS_SIGNED(*pright_t)) {
-        is_signed = true;
+    const PromotionRule& promotion = type_lattice.promotions[*pleft_t][*pright_t];
+    if(promotion.result == VAR_NONE) {
+        return false;
     }
 
-    if(var_t_to_size_bytes(*pright_t) > var_t_to_size_bytes(*pleft_t)) {
+    if(promotion.widens) {
         left = right;
     }
 
-
-    if(is_signed) {
-        switch(std::get<var_t>(left.name)) {
-            case VAR_U8:   left.name = VAR_I8;  break;
-            case VAR_U16:  left.name = VAR_I16; break;
-            case VAR_U32:  left.name = VAR_I32; break;
-            case VAR_U64:  left.name = VAR_I64; break;
-            default: break;
-        }
-    }
-
+    left.name = promotion.result;
     return true;
 }
 
@@ -251,47 +242,43 @@ tak::get_addressed_type(const TypeData& type) {
 std::optional<tak::TypeData>
 tak::get_struct_member_type_data(const std::string& member_path, const std::string& base_type_name, Parser& parser) {
 
-    const auto   member_chunks = split_string(member_path, '.');
-    const auto*  member_data   = parser.lookup_type_members(base_type_name);
-    size_t       index         = 0;
-
-    if(member_chunks.empty() || member_data == nullptr) {
+    const auto member_chunks = split_string(member_path, '.');
+    if(member_chunks.empty() || !parser.type_exists(base_type_name)) {
         return std::nullopt;
     }
 
 
-    std::function<std::optional<TypeData>(decltype(member_data))> recurse;
-    recurse = [&](const decltype(member_data) members) -> std::optional<TypeData> {
-
-        assert(member_data != nullptr);
-        for(const auto& member : *members) {
-            if(member.name != member_chunks[index]) {
-                continue;
-            }
+    //
+    // Each part of the path is a single lookup in the type's member table, methods included.
+    //
 
-            if(index + 1 >= member_chunks.size()) {
-                if(member.type.sym_ref != INVALID_SYMBOL_INDEX) {
-                    auto* sym         = parser.lookup_unique_symbol(member.type.sym_ref);
-                    sym->type.sym_ref = sym->symbol_index;
-                    return sym->type;
-                }
-                return member.type;
-            }
+    const UserType* user_t = parser.lookup_type(base_type_name);
+    for(size_t index = 0; index < member_chunks.size(); ++index) {
+        const auto* member = user_t->find_member(member_chunks[index]);
+        if(member == nullptr) {
+            return std::nullopt;
+        }
 
-            if(const auto* struct_name = std::get_if<std::string>(&member.type.name)) {
-                ++index;
-                if(parser.type_exists(*struct_name) && member.type.array_lengths.empty() && member.type.pointer_depth < 2) {
-                    return recurse(parser.lookup_type_members(*struct_name));
-                }
+        if(index + 1 >= member_chunks.size()) {
+            if(member->type.sym_ref != INVALID_SYMBOL_INDEX) {
+                const auto* sym      = parser.lookup_unique_symbol(member->type.sym_ref);
+                TypeData    method_t = sym->type;     // a copy, procedure bodies can be checked concurrently.
+                method_t.sym_ref     = sym->symbol_index;
+                return method_t;
             }
+            return member->type;
+        }
 
-            break;
+        const auto* struct_name = std::get_if<std::string>(&member->type.name);
+        if(struct_name == nullptr || !parser.type_exists(*struct_name)
+            || !member->type.array_lengths.empty() || member->type.pointer_depth >= 2) {
+            return std::nullopt;
         }
 
-        return std::nullopt;
-    };
+        user_t = parser.lookup_type(*struct_name);
+    }
 
-    return recurse(member_data);
+    return std::nullopt;
 }
 
 
@@ -302,7 +289,7 @@ tak::assign_bracedexpr_to_struct(const TypeData& type, const AstBracedExpression
     assert(type.kind == TYPE_KIND_STRUCT);
 
     if(type.flags & TYPE_RVALUE) {
-        ctx.raise_error(fmt("Cannot assign this braced expression to lefthand type {}.", typedata_to_str_msg(type)), expr->pos);
+        ctx.report(DIAG_BRACED_STRUCT_TYPE, expr->pos, type);
         return;
     }
 
@@ -317,13 +304,7 @@ tak::assign_bracedexpr_to_struct(const TypeData& type, const AstBracedExpression
     //
 
     if(members->size() != expr->members.size()) {
-        ctx.raise_error(fmt("Number of elements within braced expression ({}) does not match the struct type {} ({} members).",
-            expr->members.size(),
-            typedata_to_str_msg(type),
-            members->size()),
-            expr->pos
-        );
-
+        ctx.report(DIAG_BRACED_MEMBER_COUNT, expr->pos, expr->members.size(), type, members->size());
         return;
     }
 
@@ -340,17 +321,12 @@ tak::assign_bracedexpr_to_struct(const TypeData& type, const AstBracedExpression
 
         const auto element_t = visit_node(expr->members[i], ctx);
         if(!element_t) {
-            ctx.raise_error(fmt("Could not deduce type of element {} in braced expression.", i + 1), expr->members[i]->pos);
+            ctx.report(DIAG_BRACED_ELEMENT_UNTYPED, expr->members[i]->pos, i + 1);
             continue;
         }
 
         if(!is_type_coercion_permissible((*members)[i].type, *element_t)) {
-            ctx.raise_error(fmt("Cannot coerce element {} of braced expression to type {} ({} was given).",
-                i + 1,
-                typedata_to_str_msg((*members)[i].type),
-                typedata_to_str_msg(*element_t)),
-                expr->members[i]->pos
-            );
+            ctx.report(DIAG_BRACED_ELEMENT_COERCION, expr->members[i]->pos, i + 1, (*members)[i].type, *element_t);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,356 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <checker.hpp>
+#include <support.hpp>
+#include <layout.hpp>
+#include <charconv>
+#include <cmath>
+
+//
+// Constant folding. Every expression that gets a type is also folded if its operands are constants,
+// and the result is recorded on the node. Values follow the runtime semantics of their var_t:
+// integers wrap to the width of the type, f32 results are rounded to single precision.
+//
+// Non-concrete expressions (literals, and arithmetic done only on literals) don't have a width yet,
+// so they're folded at 64 bits and only narrowed once they meet a concrete type.
+//
+
+using namespace tak;
+
+
+static var_t
+get_fold_type(const var_t type, const bool is_non_concrete) {
+
+    if(!is_non_concrete || type == VAR_BOOLEAN) {
+        return type;
+    }
+
+    if(PRIMITIVE_IS_FLOAT(type)) return VAR_F64;
+    if(PRIMITIVE_IS_SIGNED(type)) return VAR_I64;
+    return VAR_U64;
+}
+
+static bool
+is_constant_true(const ConstantValue& value) {
+    if(PRIMITIVE_IS_FLOAT(value.type)) {
+        return constant_to_double(value) != 0.0;
+    }
+
+    return value.bits != 0;
+}
+
+static bool
+is_constant_negative(const ConstantValue& value) {
+    return PRIMITIVE_IS_SIGNED(value.type) && static_cast<int64_t>(value.bits) < 0;
+}
+
+static int
+compare_constants(const ConstantValue& left, const ConstantValue& right) {
+
+    //
+    // Integers are compared by their actual value, so mixing signed and unsigned operands
+    // can't flip the result.
+    //
+
+    if(PRIMITIVE_IS_FLOAT(left.type) || PRIMITIVE_IS_FLOAT(right.type)) {
+        const double lhs = constant_to_double(left);
+        const double rhs = constant_to_double(right);
+        return (lhs > rhs) - (lhs < rhs);
+    }
+
+    const bool left_negative  = is_constant_negative(left);
+    const bool right_negative = is_constant_negative(right);
+
+    if(left_negative != right_negative) {
+        return left_negative ? -1 : 1;
+    }
+
+    if(left_negative) {
+        const auto lhs = static_cast<int64_t>(left.bits);
+        const auto rhs = static_cast<int64_t>(right.bits);
+        return (lhs > rhs) - (lhs < rhs);
+    }
+
+    return (left.bits > right.bits) - (left.bits < right.bits);
+}
+
+
+static std::optional<char>
+literal_character(const std::string_view value) {
+
+    //
+    // The parser resolves escape sequences, so '\n' normally arrives here as a quoted newline.
+    // Anything that still has its backslash gets decoded the same way, and anything else isn't folded.
+    //
+
+    if(value.size() == 3) {
+        return value[1];
+    }
+
+    if(value.size() == 4 && value[1] == '\\') {
+        return get_escaped_char_via_real(value[2]);
+    }
+
+    return std::nullopt;
+}
+
+static std::optional<ConstantValue>
+fold_literal(const AstSingletonLiteral* node, const var_t fold_t) {
+
+    switch(node->literal_type) {
+        case TOKEN_INTEGER_LITERAL: {
+            uint64_t value = 0;
+            const auto* end = node->value.data() + node->value.size();
+            if(const auto [ptr, ec] = std::from_chars(node->value.data(), end, value); ec != std::errc() || ptr != end) {
+                return std::nullopt;
+            }
+
+            return make_int_constant(fold_t, value);
+        }
+
+        case TOKEN_FLOAT_LITERAL: {
+            try {
+                return make_float_constant(fold_t, std::stod(node->value));
+            } catch(...) {
+                return std::nullopt;
+            }
+        }
+
+        case TOKEN_CHARACTER_LITERAL: {
+            const auto character = literal_character(node->value);
+            if(!character) {
+                return std::nullopt;
+            }
+
+            return make_int_constant(fold_t, static_cast<uint64_t>(static_cast<int64_t>(static_cast<int8_t>(*character))));
+        }
+
+        case TOKEN_BOOLEAN_LITERAL:
+            return make_int_constant(VAR_BOOLEAN, node->value == "true");
+
+        default:
+            return std::nullopt;
+    }
+}
+
+static std::optional<ConstantValue>
+fold_unaryexpr(const AstUnaryexpr* node, const var_t fold_t, CheckerContext& ctx) {
+
+    const auto* operand = ctx.lookup_constant(node->operand);
+    if(operand == nullptr) {
+        return std::nullopt;
+    }
+
+    if(node->_operator == TOKEN_CONDITIONAL_NOT) {
+        return make_int_constant(VAR_BOOLEAN, !is_constant_true(*operand));
+    }
+
+    const auto value = convert_constant(*operand, fold_t);
+    if(value.type == VAR_NONE) {
+        return std::nullopt;
+    }
+
+    switch(node->_operator) {
+        case TOKEN_PLUS:
+            return value;
+
+        case TOKEN_SUB:
+            if(PRIMITIVE_IS_FLOAT(fold_t)) {
+                return make_float_constant(fold_t, -constant_to_double(value));
+            }
+
+            return PRIMITIVE_IS_INTEGER(fold_t) ? std::optional(make_int_constant(fold_t, 0 - value.bits)) : std::nullopt;
+
+        case TOKEN_BITWISE_NOT:
+            return PRIMITIVE_IS_INTEGER(fold_t) ? std::optional(make_int_constant(fold_t, ~value.bits)) : std::nullopt;
+
+        default:
+            return std::nullopt; // ++, --, dereferencing and taking an address never produce constants.
+    }
+}
+
+static std::optional<ConstantValue>
+fold_float_binexpr(const token_t _operator, const var_t fold_t, const double lhs, const double rhs) {
+
+    switch(_operator) {
+        case TOKEN_PLUS: return make_float_constant(fold_t, lhs + rhs);
+        case TOKEN_SUB:  return make_float_constant(fold_t, lhs - rhs);
+        case TOKEN_MUL:  return make_float_constant(fold_t, lhs * rhs);
+        case TOKEN_DIV:  return make_float_constant(fold_t, lhs / rhs);
+        case TOKEN_MOD:  return make_float_constant(fold_t, std::fmod(lhs, rhs));
+        default:         return std::nullopt;
+    }
+}
+
+static std::optional<ConstantValue>
+fold_integer_binexpr(const AstBinexpr* node, const var_t fold_t, const ConstantValue& left, const ConstantValue& right, CheckerContext& ctx) {
+
+    const uint64_t lhs       = left.bits;
+    const uint64_t rhs       = right.bits;
+    const bool     is_signed = PRIMITIVE_IS_SIGNED(fold_t);
+
+    switch(node->_operator) {
+        case TOKEN_PLUS:         return make_int_constant(fold_t, lhs + rhs);
+        case TOKEN_SUB:          return make_int_constant(fold_t, lhs - rhs);
+        case TOKEN_MUL:          return make_int_constant(fold_t, lhs * rhs);
+        case TOKEN_BITWISE_AND:  return make_int_constant(fold_t, lhs & rhs);
+        case TOKEN_BITWISE_OR:   return make_int_constant(fold_t, lhs | rhs);
+        case TOKEN_BITWISE_XOR_OR_PTR: return make_int_constant(fold_t, lhs ^ rhs);
+        default: break;
+    }
+
+
+    if(node->_operator == TOKEN_DIV || node->_operator == TOKEN_MOD) {
+        if(rhs == 0) {
+            ctx.report(DIAG_CONSTANT_DIVISION_BY_ZERO, node->pos);
+            return std::nullopt;
+        }
+
+        if(!is_signed) {
+            return make_int_constant(fold_t, node->_operator == TOKEN_DIV ? lhs / rhs : lhs % rhs);
+        }
+
+        //
+        // INT64_MIN / -1 doesn't fit, dividing by -1 is just negation (which wraps).
+        //
+
+        if(static_cast<int64_t>(rhs) == -1) {
+            return make_int_constant(fold_t, node->_operator == TOKEN_DIV ? 0 - lhs : 0);
+        }
+
+        const auto slhs = static_cast<int64_t>(lhs);
+        const auto srhs = static_cast<int64_t>(rhs);
+        return make_int_constant(fold_t, static_cast<uint64_t>(node->_operator == TOKEN_DIV ? slhs / srhs : slhs % srhs));
+    }
+
+
+    if(node->_operator == TOKEN_BITWISE_LSHIFT || node->_operator == TOKEN_BITWISE_RSHIFT) {
+        const uint32_t width = var_t_to_size_bytes(fold_t) * 8U;
+        if(is_constant_negative(right) || rhs >= width) {
+            ctx.report(DIAG_CONSTANT_SHIFT_RANGE, node->pos, constant_to_string(right), var_t_to_string(fold_t));
+            return std::nullopt;
+        }
+
+        if(node->_operator == TOKEN_BITWISE_LSHIFT) {
+            return make_int_constant(fold_t, lhs << rhs);
+        }
+
+        return make_int_constant(fold_t, is_signed ? static_cast<uint64_t>(static_cast<int64_t>(lhs) >> rhs) : lhs >> rhs);
+    }
+
+    return std::nullopt;
+}
+
+static std::optional<ConstantValue>
+fold_binexpr(const AstBinexpr* node, const var_t fold_t, CheckerContext& ctx) {
+
+    const auto* left  = ctx.lookup_constant(node->left_op);
+    const auto* right = ctx.lookup_constant(node->right_op);
+
+    if(left == nullptr || right == nullptr) {
+        return std::nullopt;
+    }
+
+    switch(node->_operator) {
+        case TOKEN_CONDITIONAL_AND:  return make_int_constant(VAR_BOOLEAN, is_constant_true(*left) && is_constant_true(*right));
+        case TOKEN_CONDITIONAL_OR:   return make_int_constant(VAR_BOOLEAN, is_constant_true(*left) || is_constant_true(*right));
+        case TOKEN_COMP_EQUALS:      return make_int_constant(VAR_BOOLEAN, compare_constants(*left, *right) == 0);
+        case TOKEN_COMP_NOT_EQUALS:  return make_int_constant(VAR_BOOLEAN, compare_constants(*left, *right) != 0);
+        case TOKEN_COMP_LT:          return make_int_constant(VAR_BOOLEAN, compare_constants(*left, *right) <  0);
+        case TOKEN_COMP_LTE:         return make_int_constant(VAR_BOOLEAN, compare_constants(*left, *right) <= 0);
+        case TOKEN_COMP_GT:          return make_int_constant(VAR_BOOLEAN, compare_constants(*left, *right) >  0);
+        case TOKEN_COMP_GTE:         return make_int_constant(VAR_BOOLEAN, compare_constants(*left, *right) >= 0);
+        default: break;
+    }
+
+
+    //
+    // Arithmetic and bitwise operators work in the type of the whole expression.
+    // Shift amounts keep their own value, only the shifted operand gets converted.
+    //
+
+    const auto lhs = convert_constant(*left, fold_t);
+    if(lhs.type == VAR_NONE) {
+        return std::nullopt;
+    }
+
+    if(PRIMITIVE_IS_FLOAT(fold_t)) {
+        const auto rhs = convert_constant(*right, fold_t);
+        return rhs.type == VAR_NONE ? std::nullopt : fold_float_binexpr(node->_operator, fold_t, constant_to_double(lhs), constant_to_double(rhs));
+    }
+
+    if(!PRIMITIVE_IS_INTEGER(fold_t) || PRIMITIVE_IS_FLOAT(right->type)) {
+        return std::nullopt;
+    }
+
+    const bool is_shift = node->_operator == TOKEN_BITWISE_LSHIFT || node->_operator == TOKEN_BITWISE_RSHIFT;
+    const auto rhs      = is_shift ? *right : convert_constant(*right, fold_t);
+
+    return fold_integer_binexpr(node, fold_t, lhs, rhs, ctx);
+}
+
+
+std::optional<ConstantValue>
+tak::fold_constant(const AstNode* node, const TypeData& type, CheckerContext& ctx) {
+
+    assert(node != nullptr);
+
+    const auto* var_type = std::get_if<var_t>(&type.name);
+    if(var_type == nullptr
+        || type.kind != TYPE_KIND_VARIABLE
+        || type.pointer_depth > 0
+        || !type.array_lengths.empty()
+        || *var_type == VAR_NONE
+        || *var_type == VAR_VOID
+    ) {
+        return std::nullopt;
+    }
+
+    const var_t fold_t = get_fold_type(*var_type, type.flags & TYPE_NON_CONCRETE);
+    switch(node->type) {
+        case NODE_SINGLETON_LITERAL:
+            return fold_literal(dynamic_cast<const AstSingletonLiteral*>(node), fold_t);
+
+        case NODE_UNARYEXPR:
+            return fold_unaryexpr(dynamic_cast<const AstUnaryexpr*>(node), fold_t, ctx);
+
+        case NODE_BINEXPR:
+            return fold_binexpr(dynamic_cast<const AstBinexpr*>(node), fold_t, ctx);
+
+        case NODE_IDENT: {
+            const auto* sym = ctx.parser_.lookup_unique_symbol(dynamic_cast<const AstIdentifier*>(node)->symbol_index);
+            if(sym == nullptr || sym->constant.type == VAR_NONE) {
+                return std::nullopt;
+            }
+
+            return convert_constant(sym->constant, fold_t);
+        }
+
+        case NODE_CAST: {
+            const auto* target = ctx.lookup_constant(dynamic_cast<const AstCast*>(node)->target);
+            if(target == nullptr) {
+                return std::nullopt;
+            }
+
+            const auto value = convert_constant(*target, fold_t);
+            return value.type == VAR_NONE ? std::nullopt : std::optional(value);
+        }
+
+        case NODE_SIZEOF: {
+            const auto*     sizeof_node = dynamic_cast<const AstSizeof*>(node);
+            const TypeData* target_t    = std::get_if<TypeData>(&sizeof_node->target);
+
+            if(const auto* target_node = std::get_if<AstNode*>(&sizeof_node->target)) {
+                target_t = ctx.lookup_type(*target_node);
+            }
+
+            const auto size = target_t != nullptr ? get_type_size(*target_t, ctx.parser_) : std::nullopt;
+            return size ? std::optional(make_int_constant(fold_t, *size)) : std::nullopt;
+        }
+
+        default:
+            return std::nullopt;
+    }
+}
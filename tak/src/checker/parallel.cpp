@@ -0,0 +1,193 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <checker.hpp>
+#include <thread_pool.hpp>
+#include <layout.hpp>
+#include <algorithm>
+#include <functional>
+#include <memory>
+
+//
+// Procedure bodies only ever write to their own local symbols, so they can be checked concurrently.
+// Everything else at the toplevel (globals, mostly) is checked on the calling thread and acts as a barrier:
+// bodies before it have to finish first, since checking a global changes what the bodies after it see.
+//
+// Bodies are checked in batches, each with its own context that buffers diagnostics, node types and constants.
+// Once every batch is done the buffers are merged in source order through the real context,
+// so the output, the type IDs and the error counts all come out exactly the same as checking serially.
+//
+// Until then nodes carry IDs local to their batch. They're remapped by walking the batch's procedures,
+// not through a list of annotated nodes, since checking replaces and deletes some nodes (method calls).
+//
+
+struct ProcBatch {
+    std::vector<tak::AstProcdecl*>       procs;
+    std::vector<tak::Diagnostic>         diagnostics;
+    tak::CheckerTypeBuffer               types;
+};
+
+
+static void
+merge_batch(ProcBatch& batch, tak::CheckerContext& ctx) {
+
+    std::vector<uint32_t> type_ids;
+    type_ids.reserve(batch.types.types.size());
+
+    for(const auto& type : batch.types.types) {
+        type_ids.emplace_back(ctx.parser_.intern_node_type(type));
+    }
+
+    const auto const_base = static_cast<uint32_t>(ctx.parser_.node_constants_.size());
+    for(const auto& value : batch.types.constants) {
+        ctx.parser_.add_node_constant(value);
+    }
+
+    for(auto* proc : batch.procs) {
+        tak::walk_ast(proc, [&](tak::AstNode* node) {
+            if(node->type_id != INVALID_TYPE_ID)      node->type_id   = type_ids[node->type_id - 1];
+            if(node->const_id != INVALID_CONSTANT_ID) node->const_id += const_base;
+        });
+    }
+
+    for(auto& diag : batch.diagnostics) {
+        for(auto& arg : diag.args) {
+            if(arg.kind == tak::DIAG_ARG_TYPE) arg.value = type_ids[arg.value - 1];
+        }
+
+        ctx.add_diagnostic(std::move(diag));
+    }
+}
+
+static void
+check_procs(const std::vector<tak::AstProcdecl*>& procs, tak::ThreadPool& pool, tak::CheckerContext& ctx) {
+
+    //
+    // A few batches per thread is enough to keep every thread busy when some bodies are much bigger
+    // than others. Any more and the cost of merging the batches back starts to show.
+    //
+
+    static constexpr size_t batches_per_thread = 4;
+
+    const size_t num_batches = std::min(procs.size(), pool.size() * batches_per_thread);
+    const size_t batch_size  = (procs.size() + num_batches - 1) / num_batches;
+
+    std::vector<std::unique_ptr<ProcBatch>> batches;
+    batches.reserve(num_batches);
+
+    for(size_t begin = 0; begin < procs.size(); begin += batch_size) {
+        auto* batch = batches.emplace_back(std::make_unique<ProcBatch>()).get();
+        batch->procs.assign(
+            procs.begin() + static_cast<std::ptrdiff_t>(begin),
+            procs.begin() + static_cast<std::ptrdiff_t>(std::min(begin + batch_size, procs.size()))
+        );
+
+        pool.submit([batch, &ctx] {
+            tak::CheckerContext batch_ctx(ctx.lxr_, ctx.parser_);
+            batch_ctx.type_buffer_ = &batch->types;
+
+            for(auto* proc : batch->procs) {
+                tak::visit_procdecl(proc, batch_ctx);
+            }
+
+            batch->diagnostics = std::move(batch_ctx.diagnostics_);
+        });
+    }
+
+    pool.wait();
+    for(const auto& batch : batches) {
+        merge_batch(*batch, ctx);
+    }
+}
+
+
+//
+// With a reachable set, only the procedures and globals in it are checked.
+// Everything else at the toplevel (structs, enums, namespaces) is visited as usual.
+//
+
+static bool
+is_decl_reachable(const tak::AstNode* node, const std::unordered_set<const tak::AstNode*>* reachable) {
+    return reachable == nullptr
+        || (node->type != tak::NODE_PROCDECL && node->type != tak::NODE_VARDECL)
+        || reachable->contains(node);
+}
+
+void
+tak::visit_toplevel(CheckerContext& ctx, const std::unordered_set<const AstNode*>* reachable) {
+
+    std::function<void(AstNode*)> visit_decl;
+    visit_decl = [&](AstNode* node) {
+        if(!NODE_NEEDS_VISITING(node->type) || ctx.truncated_ || !is_decl_reachable(node, reachable)) {
+            return;
+        }
+
+        if(reachable == nullptr) {
+            visit_node(node, ctx);
+        } else if(const auto* nmspace = dynamic_cast<AstNamespaceDecl*>(node)) {
+            for(auto* child : nmspace->children) visit_decl(child);
+        } else if(const auto* compose = dynamic_cast<AstComposeDecl*>(node)) {
+            for(auto* child : compose->children) visit_decl(child);
+        } else {
+            visit_node(node, ctx);
+        }
+    };
+
+    for(auto* decl : ctx.parser_.toplevel_decls_) {
+        visit_decl(decl);
+    }
+}
+
+void
+tak::visit_toplevel_parallel(CheckerContext& ctx, const uint32_t num_threads, const std::unordered_set<const AstNode*>* reachable) {
+
+    assert(!ctx.parser_.lazy_proc_bodies_);
+    assert(ctx.type_buffer_ == nullptr);
+
+    //
+    // Struct layouts are cached lazily, compute them all up front so that bodies only ever read the cache.
+    //
+
+    compute_type_layouts(ctx.parser_);
+
+    ThreadPool pool(num_threads);
+    std::vector<AstProcdecl*> procs;
+
+    const auto flush = [&] {
+        if(!procs.empty()) {
+            check_procs(procs, pool, ctx);
+            procs.clear();
+        }
+    };
+
+
+    //
+    // Namespaces and compose blocks don't do anything besides visiting their children,
+    // so the procedures inside them get split off the same way.
+    //
+
+    std::function<void(AstNode*)> visit_decl;
+    visit_decl = [&](AstNode* node) {
+        if(!NODE_NEEDS_VISITING(node->type) || ctx.truncated_ || !is_decl_reachable(node, reachable)) {
+            return;
+        }
+
+        if(node->type == NODE_PROCDECL) {
+            procs.emplace_back(dynamic_cast<AstProcdecl*>(node));
+        } else if(const auto* nmspace = dynamic_cast<AstNamespaceDecl*>(node)) {
+            for(auto* child : nmspace->children) visit_decl(child);
+        } else if(const auto* compose = dynamic_cast<AstComposeDecl*>(node)) {
+            for(auto* child : compose->children) visit_decl(child);
+        } else {
+            flush();
+            visit_node(node, ctx);
+        }
+    };
+
+    for(auto* decl : ctx.parser_.toplevel_decls_) {
+        visit_decl(decl);
+    }
+
+    flush();
+}
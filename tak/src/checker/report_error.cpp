@@ -3,19 +3,54 @@
 //
 
 #include <checker.hpp>
+#include <io.hpp>
 
 void
-tak::CheckerContext::raise_error(const std::string& message, const size_t position) {
-    lxr_.raise_error(fmt("ERROR: {}\n", message), position);
-    ++error_count_;
+tak::CheckerContext::add_diagnostic(Diagnostic&& diag) {
 
-    if(error_count_ >= MAX_ERROR_COUNT) {
-        panic("\nMaximum error count reached. Aborting compilation.");
+    if(truncated_) {
+        return;
     }
+
+    if(get_diag_info(diag.code).severity == DIAG_SEVERITY_WARNING) {
+        ++warning_count_;
+    } else if(error_count_ >= MAX_ERROR_COUNT) {
+        truncated_ = true;
+        return;
+    } else {
+        ++error_count_;
+    }
+
+    diagnostics_.emplace_back(std::move(diag));
 }
 
-void
-tak::CheckerContext::raise_warning(const std::string& message, const size_t position) {
-    lxr_.raise_error(fmt("WARNING: {}\n", message), position);
-    ++warning_count_;
-}
\ No newline at end of file
+bool
+tak::emit_checker_diagnostics(CheckerContext& ctx, const diag_format_t format, const std::string& output_path) {
+
+    //
+    // Not every error comes with a diagnostic, a deferred body that fails to parse
+    // reports its own errors through the lexer.
+    //
+
+    const auto recorded = std::ranges::count_if(ctx.diagnostics_, [](const Diagnostic& diag) {
+        return get_diag_info(diag.code).severity == DIAG_SEVERITY_ERROR;
+    });
+
+    auto summary    = sort_diagnostics(ctx.diagnostics_, ctx.truncated_);
+    summary.errors += ctx.error_count_ - static_cast<uint32_t>(recorded);
+
+    if(!emit_diagnostics(ctx.diagnostics_, summary, ctx.lxr_, ctx.parser_, format, output_path)) {
+        return false;
+    }
+
+    if(ctx.error_count_ == 0) {
+        return true;
+    }
+
+    if(format == DIAG_FORMAT_TEXT || !output_path.empty()) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("\n{}: BUILD FAILED", ctx.lxr_.source_file_name_);
+        print<TFG_NONE, TBG_NONE, TSTYLE_NONE>("Finished with {} errors, {} warnings.", summary.errors, summary.warnings);
+    }
+
+    return false;
+}
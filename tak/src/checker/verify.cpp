@@ -3,6 +3,7 @@
 //
 
 #include <checker.hpp>
+#include <type_lattice.hpp>
 
 
 bool
@@ -89,16 +90,20 @@ tak::is_type_cast_permissible(const TypeData& from, const TypeData& to) {
     if(to.flags & TYPE_POINTER)   ++ptr_count;
 
 
-    if(ptr_count == 2 || ptr_count == 0) {
+    if(ptr_count == 2) {
         return true;
     }
 
+    if(ptr_count == 0) {
+        return primfrom_t == nullptr || primto_t == nullptr || type_lattice.castable[*primfrom_t][*primto_t];
+    }
+
     if(from.flags & TYPE_POINTER && !(to.flags & TYPE_POINTER)) {
-        return primto_t != nullptr && *primto_t == VAR_U64;
+        return primto_t != nullptr && type_lattice.pointer_castable[*primto_t];
     }
 
     if(to.flags & TYPE_POINTER && !(from.flags & TYPE_POINTER)) {
-        return primfrom_t != nullptr && *primfrom_t == VAR_U64;
+        return primfrom_t != nullptr && type_lattice.pointer_castable[*primfrom_t];
     }
 
     return false;
@@ -128,7 +133,7 @@ tak::is_type_coercion_permissible(TypeData& left, const TypeData& right) {
     if(ptr_count != 0) return false;
 
 
-    if((left_t == nullptr || right_t == nullptr) || (PRIMITIVE_IS_FLOAT(*right_t) && !PRIMITIVE_IS_FLOAT(*left_t))) {
+    if(left_t == nullptr || right_t == nullptr) {
         return false;
     }
 
@@ -136,7 +141,7 @@ tak::is_type_coercion_permissible(TypeData& left, const TypeData& right) {
         return type_promote_non_concrete(left, right);
     }
 
-    return var_t_to_size_bytes(*right_t) <= var_t_to_size_bytes(*left_t);
+    return type_lattice.coercible[*left_t][*right_t];
 }
 
 
@@ -270,6 +275,21 @@ tak::can_operator_be_applied_to(const token_t _operator, const TypeData& type) {
         return false;
     }
 
+    const auto* primitive_ptr = std::get_if<var_t>(&type.name);
+    if(primitive_ptr != nullptr
+        && type.kind == TYPE_KIND_VARIABLE
+        && type.pointer_depth == 0
+        && !(type.flags & TYPE_POINTER)
+        && type.array_lengths.empty()
+    ) {
+        switch(type_lattice.operators[_operator][*primitive_ptr]) {
+            case OPERATOR_RULE_LEGAL:   return true;
+            case OPERATOR_RULE_ILLEGAL: return false;
+            case OPERATOR_RULE_MUTABLE: return !(type.flags & TYPE_CONSTANT) && !(type.flags & TYPE_RVALUE);
+            default: break;
+        }
+    }
+
     if(_operator == TOKEN_VALUE_ASSIGNMENT) {
         return !(type.flags & TYPE_CONSTANT) && !(type.flags & TYPE_RVALUE);
     }
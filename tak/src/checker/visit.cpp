@@ -3,6 +3,8 @@
 //
 
 #include <checker.hpp>
+#include <layout.hpp>
+#include <trace.hpp>
 
 
 template<typename T>
@@ -45,28 +47,24 @@ tak::visit_binexpr(AstBinexpr* node, CheckerContext& ctx) {
     }
 
     if(!left_t || !right_t) {
-        ctx.raise_error("Unable to deduce type of one or more operands.", node->pos);
+        ctx.report(DIAG_OPERANDS_UNTYPED, node->pos);
         return std::nullopt;
     }
 
 
-    const auto op_as_str    = token_to_string(node->_operator);
-    const auto left_as_str  = typedata_to_str_msg(*left_t);
-    const auto right_as_str = typedata_to_str_msg(*right_t);
-
     if(node->_operator == TOKEN_CONDITIONAL_OR || node->_operator == TOKEN_CONDITIONAL_AND) {
         if(!can_operator_be_applied_to(node->_operator, *left_t)) {
-            ctx.raise_error(fmt("Logical operator '{}' cannot be applied to lefthand type {}.", op_as_str, left_as_str), node->pos);
+            ctx.report(DIAG_LOGICAL_OPERATOR_LEFT, node->pos, node->_operator, *left_t);
         }
         if(!can_operator_be_applied_to(node->_operator, *right_t)) {
-            ctx.raise_error(fmt("Logical operator '{}' cannot be applied to righthand type {}.", op_as_str, right_as_str), node->pos);
+            ctx.report(DIAG_LOGICAL_OPERATOR_RIGHT, node->pos, node->_operator, *right_t);
         }
     } else {
         if(!can_operator_be_applied_to(node->_operator, *left_t)) {
-            ctx.raise_error(fmt("Operator '{}' cannot be applied to lefthand type {}.", op_as_str, left_as_str), node->pos);
+            ctx.report(DIAG_OPERATOR_LEFT, node->pos, node->_operator, *left_t);
         }
         if(!is_type_coercion_permissible(*left_t, *right_t)) {
-            ctx.raise_error(fmt("Cannot coerce type of righthand expression ({}) to {}", right_as_str, left_as_str), node->pos);
+            ctx.report(DIAG_RIGHT_COERCION, node->pos, *right_t, *left_t);
         }
     }
 
@@ -96,19 +94,15 @@ tak::visit_unaryexpr(AstUnaryexpr* node, CheckerContext& ctx) {
         return std::nullopt;
     }
 
-    const auto op_as_str   = token_to_string(node->_operator);
-    const auto type_as_str = typedata_to_str_msg(*operand_t);
-
-
     if(node->_operator == TOKEN_SUB || node->_operator == TOKEN_PLUS) {
         if(operand_t->flags & TYPE_POINTER || !operand_t->array_lengths.empty() || operand_t->kind != TYPE_KIND_VARIABLE) {
-            ctx.raise_error(fmt("Cannot apply unary operator {} to type {}.", op_as_str, type_as_str), node->pos);
+            ctx.report(DIAG_UNARY_OPERATOR, node->pos, node->_operator, *operand_t);
             return std::nullopt;
         }
 
         if(node->_operator == TOKEN_SUB) {
             if(!flip_sign(*operand_t)) {
-                ctx.raise_error(fmt("Cannot apply unary minus to type {}.", op_as_str, type_as_str), node->pos);
+                ctx.report(DIAG_UNARY_MINUS, node->pos, *operand_t);
                 return std::nullopt;
             }
         }
@@ -119,7 +113,7 @@ tak::visit_unaryexpr(AstUnaryexpr* node, CheckerContext& ctx) {
 
     if(node->_operator == TOKEN_BITWISE_NOT) {
         if(!is_type_bwop_eligible(*operand_t)) {
-            ctx.raise_error(fmt("Cannot apply bitwise operator ~ to type {}", type_as_str), node->pos);
+            ctx.report(DIAG_BITWISE_NOT, node->pos, *operand_t);
             return std::nullopt;
         }
 
@@ -129,7 +123,7 @@ tak::visit_unaryexpr(AstUnaryexpr* node, CheckerContext& ctx) {
 
     if(node->_operator == TOKEN_INCREMENT || node->_operator == TOKEN_DECREMENT) {
         if(!can_operator_be_applied_to(node->_operator, *operand_t)) {
-            ctx.raise_error(fmt("Cannot apply operator {} to type {}", op_as_str, type_as_str), node->pos);
+            ctx.report(DIAG_INCREMENT_DECREMENT, node->pos, node->_operator, *operand_t);
             return std::nullopt;
         }
 
@@ -139,7 +133,7 @@ tak::visit_unaryexpr(AstUnaryexpr* node, CheckerContext& ctx) {
 
     if(node->_operator == TOKEN_CONDITIONAL_NOT) {
         if(!is_type_lop_eligible(*operand_t)) {
-            ctx.raise_error(fmt("Cannot apply logical operator ! to type {}", type_as_str), node->pos);
+            ctx.report(DIAG_LOGICAL_NOT, node->pos, *operand_t);
             return std::nullopt;
         }
 
@@ -156,7 +150,7 @@ tak::visit_unaryexpr(AstUnaryexpr* node, CheckerContext& ctx) {
             return deref_t;
         }
 
-        ctx.raise_error(fmt("Cannot dereference type {}.", type_as_str), node->pos);
+        ctx.report(DIAG_DEREFERENCE, node->pos, *operand_t);
         return std::nullopt;
     }
 
@@ -165,7 +159,7 @@ tak::visit_unaryexpr(AstUnaryexpr* node, CheckerContext& ctx) {
             return addressed_t;
         }
 
-        ctx.raise_error(fmt("Cannot get the address of type {}.", type_as_str), node->pos);
+        ctx.report(DIAG_ADDRESS_OF, node->pos, *operand_t);
         return std::nullopt;
     }
 
@@ -180,7 +174,7 @@ tak::visit_identifier(const AstIdentifier* node, CheckerContext& ctx) {
     const auto* sym = ctx.parser_.lookup_unique_symbol(node->symbol_index);
     assert(sym != nullptr);
     if(sym->type.flags & TYPE_INFERRED || sym->type.flags & TYPE_UNINITIALIZED) {
-        ctx.raise_error(fmt("Referencing uninitialized or invalid symbol \"{}\".", sym->name), node->pos);
+        ctx.report(DIAG_UNINITIALIZED_SYMBOL, node->pos, sym->name);
         return std::nullopt;
     }
 
@@ -242,6 +236,44 @@ initialize_symbol(tak::Symbol* sym) {
 }
 
 
+static void
+fold_declared_value(tak::Symbol* sym, const tak::AstVardecl* decl, tak::CheckerContext& ctx) {
+
+    //
+    // Constants keep their value, so anything referring to them can be folded as well.
+    // Either way, a value that doesn't survive being narrowed to the declared type gets a warning.
+    //
+
+    const auto* value    = ctx.lookup_constant(*decl->init_value);
+    const auto* var_type = std::get_if<tak::var_t>(&sym->type.name);
+
+    if(value == nullptr
+        || var_type == nullptr
+        || sym->type.kind != tak::TYPE_KIND_VARIABLE
+        || sym->type.pointer_depth > 0
+        || !sym->type.array_lengths.empty()
+    ) {
+        return;
+    }
+
+    const auto converted = tak::convert_constant(*value, *var_type);
+    if(PRIMITIVE_IS_INTEGER(*var_type)
+        && PRIMITIVE_IS_INTEGER(value->type)
+        && tak::convert_constant(converted, value->type) != *value
+    ) {
+        ctx.report(tak::DIAG_CONSTANT_TRUNCATED, decl->pos,
+            tak::constant_to_string(*value),
+            tak::var_t_to_string(*var_type),
+            tak::constant_to_string(converted)
+        );
+    }
+
+    if(sym->type.flags & tak::TYPE_CONSTANT) {
+        sym->constant = converted;
+    }
+}
+
+
 std::optional<tak::TypeData>
 tak::checker_handle_arraydecl(Symbol* sym, const AstVardecl* decl, CheckerContext& ctx) {
 
@@ -250,17 +282,12 @@ tak::checker_handle_arraydecl(Symbol* sym, const AstVardecl* decl, CheckerContex
 
     const auto array_t = get_bracedexpr_as_array_t(dynamic_cast<AstBracedExpression*>(*decl->init_value), ctx);
     if(!array_t) {
-        ctx.raise_error("Could not deduce type of righthand expression.", decl->pos);
+        ctx.report(DIAG_RIGHT_UNDEDUCED, decl->pos);
         return std::nullopt;
     }
 
     if(!are_array_types_equivalent(sym->type, *array_t)) {
-        ctx.raise_error(fmt("Array of type {} is not equivalent to {}.",
-            typedata_to_str_msg(*array_t),
-            typedata_to_str_msg(sym->type)),
-            (*decl->init_value)->pos
-        );
-
+        ctx.report(DIAG_ARRAY_MISMATCH, (*decl->init_value)->pos, *array_t, sym->type);
         return std::nullopt;
     }
 
@@ -291,12 +318,12 @@ tak::checker_handle_inferred_decl(Symbol* sym, const AstVardecl* decl, CheckerCo
     }
 
     if(!assigned_t) {
-        ctx.raise_error(fmt("Expression assigned to \"{}\" does not have a type.", sym->name), decl->pos);
+        ctx.report(DIAG_ASSIGNED_UNTYPED, decl->pos, sym->name);
         return std::nullopt;
     }
 
     if(is_type_invalid_in_inferred_context(*assigned_t) || (assigned_t->flags & TYPE_ARRAY && (*decl->init_value)->type != NODE_BRACED_EXPRESSION)) {
-        ctx.raise_error(fmt("Cannot assign type {} in an inferred context.", typedata_to_str_msg(*assigned_t)), (*decl->init_value)->pos);
+        ctx.report(DIAG_INFERRED_CONTEXT, (*decl->init_value)->pos, *assigned_t);
         return std::nullopt;
     }
 
@@ -306,6 +333,7 @@ tak::checker_handle_inferred_decl(Symbol* sym, const AstVardecl* decl, CheckerCo
     if(assigned_t->flags & TYPE_NON_CONCRETE) assigned_t->flags &= ~TYPE_NON_CONCRETE;
 
     sym->type = *assigned_t;
+    fold_declared_value(sym, decl, ctx);
     return sym->type;
 }
 
@@ -323,7 +351,7 @@ tak::visit_vardecl(const AstVardecl* node, CheckerContext& ctx) {
         initialize_symbol(sym);
         assert(!(sym->type.flags & TYPE_INFERRED));
         if(sym->type.flags & TYPE_ARRAY && array_has_inferred_sizes(sym->type)) {
-            ctx.raise_error("Arrays with inferred sizes (e.g. '[]') must be assigned when created.", node->pos);
+            ctx.report(DIAG_INFERRED_ARRAY_UNASSIGNED, node->pos);
             return std::nullopt;
         }
 
@@ -348,22 +376,17 @@ tak::visit_vardecl(const AstVardecl* node, CheckerContext& ctx) {
 
     const auto init_t = visit_node(*node->init_value, ctx);
     if(!init_t) {
-        ctx.raise_error("Righthand expression does not have a type.", node->pos);
+        ctx.report(DIAG_RIGHT_UNTYPED, node->pos);
         return std::nullopt;
     }
 
     initialize_symbol(sym);
     if(!is_type_coercion_permissible(sym->type, *init_t)) {
-        ctx.raise_error(fmt("Cannot assign variable \"{}\" of type {} to {}.",
-            sym->name,
-            typedata_to_str_msg(sym->type),
-            typedata_to_str_msg(*init_t)),
-            node->pos
-        );
-
+        ctx.report(DIAG_ASSIGNMENT_MISMATCH, node->pos, sym->name, sym->type, *init_t);
         return std::nullopt;
     }
 
+    fold_declared_value(sym, node, ctx);
     return sym->type;
 }
 
@@ -379,11 +402,8 @@ tak::visit_cast(const AstCast* node, CheckerContext& ctx) {
         return std::nullopt;
     }
 
-    const std::string target_t_str = typedata_to_str_msg(*target_t);
-    const std::string cast_t_str   = typedata_to_str_msg(cast_t);
-
     if(!is_type_cast_permissible(*target_t, cast_t)) {
-        ctx.raise_error(fmt("Cannot cast type {} to {}.", target_t_str, cast_t_str), node->pos);
+        ctx.report(DIAG_INVALID_CAST, node->pos, *target_t, cast_t);
         return std::nullopt;
     }
 
@@ -391,10 +411,104 @@ tak::visit_cast(const AstCast* node, CheckerContext& ctx) {
 }
 
 
+uint32_t
+tak::CheckerContext::intern_type(const TypeData& type) {
+    if(type_buffer_ == nullptr) {
+        return parser_.intern_node_type(type);
+    }
+
+    return tak::intern_type(type_buffer_->types, type_buffer_->type_ids, type);
+}
+
+void
+tak::CheckerContext::annotate(AstNode* node, const TypeData& type) {
+
+    assert(node != nullptr);
+    node->type_id = intern_type(type);
+}
+
+
+void
+tak::CheckerContext::record_constant(AstNode* node, const ConstantValue& value) {
+
+    assert(node != nullptr);
+    if(type_buffer_ == nullptr) {
+        node->const_id = parser_.add_node_constant(value);
+        return;
+    }
+
+    type_buffer_->constants.emplace_back(value);
+    node->const_id = static_cast<uint32_t>(type_buffer_->constants.size());
+}
+
+const tak::ConstantValue*
+tak::CheckerContext::lookup_constant(const AstNode* node) {
+
+    assert(node != nullptr);
+    if(type_buffer_ == nullptr) {
+        return parser_.lookup_node_constant(node);
+    }
+
+    if(node->const_id == INVALID_CONSTANT_ID || node->const_id > type_buffer_->constants.size()) {
+        return nullptr;
+    }
+
+    return &type_buffer_->constants[node->const_id - 1];
+}
+
+const tak::TypeData*
+tak::CheckerContext::lookup_type(const AstNode* node) {
+
+    assert(node != nullptr);
+    if(type_buffer_ == nullptr) {
+        return parser_.lookup_node_type(node);
+    }
+
+    if(node->type_id == INVALID_TYPE_ID || node->type_id > type_buffer_->types.size()) {
+        return nullptr;
+    }
+
+    return &type_buffer_->types[node->type_id - 1];
+}
+
+
+static void
+annotate_declaration(const tak::AstVardecl* node, tak::CheckerContext& ctx) {
+
+    //
+    // Declared names and braced initializers never get visited as expressions,
+    // they simply have the type of the symbol being declared.
+    //
+
+    const auto* sym = ctx.parser_.lookup_unique_symbol(node->identifier->symbol_index);
+    if(sym->type.flags & tak::TYPE_INFERRED) {
+        return;
+    }
+
+    ctx.annotate(node->identifier, sym->type);
+    if(node->init_value && (*node->init_value)->type == tak::NODE_BRACED_EXPRESSION) {
+        ctx.annotate(*node->init_value, sym->type);
+    }
+}
+
+
 std::optional<tak::TypeData>
-tak::visit_procdecl(const AstProcdecl* node, CheckerContext& ctx) {
+tak::visit_procdecl(AstProcdecl* node, CheckerContext& ctx) {
 
     assert(node != nullptr);
+    tak::TraceScope scope("check", "procedure");
+
+    if(node->deferred_body && !parse_deferred_body(node, ctx.parser_, ctx.lxr_)) {
+        ++ctx.error_count_;
+        return std::nullopt;
+    }
+
+    const auto* proc = ctx.parser_.lookup_unique_symbol(node->identifier->symbol_index);
+    scope.set_name(proc->name);
+    ctx.annotate(node->identifier, proc->type);
+    for(const auto* param : node->parameters) {
+        annotate_declaration(param, ctx);
+    }
 
     for(const auto& child : node->body) {
         if(NODE_NEEDS_VISITING(child->type)) {
@@ -418,7 +532,7 @@ verify_method_call(const tak::TypeData& method_t, tak::AstCall* node, tak::Check
     const uint32_t receives    = method_t.parameters == nullptr ? 0 : method_t.parameters->size();
 
     if(maccess == nullptr || called_with == receives) {
-        ctx.raise_error(tak::fmt("Calling method with {} arguments, but it takes {}.", called_with, !receives ? receives : receives - 1), node->pos);
+        ctx.report(tak::DIAG_METHOD_ARGUMENT_COUNT, node->pos, called_with, !receives ? receives : receives - 1);
         return false;
     }
 
@@ -450,12 +564,12 @@ verify_method_call(const tak::TypeData& method_t, tak::AstCall* node, tak::Check
     ident->pos          = symbol->src_pos;
     ident->parent       = node;
     maccess->target     = nullptr;
+    ctx.annotate(ident, symbol->type);
     delete maccess;
 
 
     if(receives != node->arguments.size()) {
-        ctx.raise_error(tak::fmt("Calling method \"{}\" with {} arguments, but it takes {}.",
-            symbol->name, node->arguments.size(), receives), node->pos);
+        ctx.report(tak::DIAG_NAMED_METHOD_ARGUMENT_COUNT, node->pos, symbol->name, node->arguments.size(), receives);
         return false;
     }
 
@@ -463,16 +577,12 @@ verify_method_call(const tak::TypeData& method_t, tak::AstCall* node, tak::Check
     for(size_t i = 0; i < node->arguments.size(); i++) {
         const auto arg_t = visit_node(node->arguments[i], ctx);
         if(!arg_t) {
-            ctx.raise_error(tak::fmt("Cannot deduce type of argument {} in this call.", i + 1), node->pos);
+            ctx.report(tak::DIAG_ARGUMENT_UNTYPED, node->pos, i + 1);
             continue;
         }
 
         if(!is_type_coercion_permissible((*symbol->type.parameters)[i], *arg_t)) {
-            const std::string param_t_str = typedata_to_str_msg((*symbol->type.parameters)[i]);
-            const std::string arg_t_str   = typedata_to_str_msg(*arg_t);
-
-            ctx.raise_error(tak::fmt("Cannot convert argument {} of type {} to expected parameter type {}.",
-                i + 1, arg_t_str, param_t_str), node->arguments[i]->pos);
+            ctx.report(tak::DIAG_ARGUMENT_CONVERSION, node->arguments[i]->pos, i + 1, *arg_t, (*symbol->type.parameters)[i]);
         }
     }
 
@@ -487,17 +597,16 @@ tak::visit_call(AstCall* node, CheckerContext& ctx) {
 
     auto target_t = visit_node(node->target, ctx);
     if(!target_t) {
-        ctx.raise_error("Unable to deduce type of call target", node->pos);
+        ctx.report(DIAG_CALL_TARGET_UNTYPED, node->pos);
         return std::nullopt;
     }
 
     if(target_t->kind != TYPE_KIND_PROCEDURE) {
-        ctx.raise_error("Attempt to call non-callable type.", node->pos);
+        ctx.report(DIAG_NOT_CALLABLE, node->pos);
         return std::nullopt;
     }
 
 
-    const auto     proc_t_str  = typedata_to_str_msg(*target_t);
     const uint32_t called_with = node->arguments.size();
     const uint32_t receives    = target_t->parameters == nullptr ? 0 : target_t->parameters->size();
 
@@ -515,12 +624,7 @@ tak::visit_call(AstCall* node, CheckerContext& ctx) {
 
 
     if(called_with != receives) {
-        ctx.raise_error(fmt("Attempting to call procedure of type {} with {} arguments, but it takes {}.",
-            proc_t_str,
-            called_with,
-            receives),
-            node->pos
-        );
+        ctx.report(DIAG_CALL_ARGUMENT_COUNT, node->pos, *target_t, called_with, receives);
 
         if(target_t->return_type == nullptr) {
             return std::nullopt;
@@ -551,15 +655,10 @@ tak::visit_call(AstCall* node, CheckerContext& ctx) {
     for(size_t i = 0; i < node->arguments.size(); i++) {
         if(const auto arg_t = visit_node(node->arguments[i], ctx)) {
             if(!is_type_coercion_permissible((*target_t->parameters)[i], *arg_t)) {
-
-                const std::string param_t_str = typedata_to_str_msg((*target_t->parameters)[i]);
-                const std::string arg_t_str   = typedata_to_str_msg(*arg_t);
-
-                ctx.raise_error(fmt("Cannot convert argument {} of type {} to expected parameter type {}.",
-                    i + 1, arg_t_str, param_t_str), node->arguments[i]->pos);
+                ctx.report(DIAG_ARGUMENT_CONVERSION, node->arguments[i]->pos, i + 1, *arg_t, (*target_t->parameters)[i]);
             }
         } else {
-            ctx.raise_error(fmt("Cannot deduce type of argument {} in this call.", i + 1), node->pos);
+            ctx.report(DIAG_ARGUMENT_UNTYPED, node->pos, i + 1);
         }
     }
 
@@ -606,24 +705,19 @@ tak::visit_ret(const AstRet* node, CheckerContext& ctx) {
     }
 
     if(count != 2) {
-        ctx.raise_error(fmt("Invalid return statement: does not match return type for procedure \"{}\".", sym->name), node->pos);
+        ctx.report(DIAG_RETURN_MISMATCH, node->pos, sym->name);
         return std::nullopt;
     }
 
 
     const auto ret_t = visit_node(*node->value, ctx);
     if(!ret_t) {
-        ctx.raise_error("Could not deduce type of righthand expression.", node->pos);
+        ctx.report(DIAG_RIGHT_UNDEDUCED, node->pos);
         return std::nullopt;
     }
 
     if(!is_type_coercion_permissible(*sym->type.return_type, *ret_t)) {
-        ctx.raise_error(fmt("Cannot coerce type {} to procedure return type {} (compiling procedure \"{}\").",
-            typedata_to_str_msg(*ret_t),
-            typedata_to_str_msg(*sym->type.return_type),
-            sym->name),
-            node->pos
-        );
+        ctx.report(DIAG_RETURN_COERCION, node->pos, *ret_t, *sym->type.return_type, sym->name);
     }
 
     return *ret_t;
@@ -637,12 +731,12 @@ tak::visit_member_access(const AstMemberAccess* node, CheckerContext& ctx) {
     const auto target_t = visit_node(node->target, ctx);
 
     if(!target_t) {
-        ctx.raise_error("Attempting to access non-existant type as a struct.", node->pos);
+        ctx.report(DIAG_MEMBER_ACCESS_UNTYPED, node->pos);
         return std::nullopt;
     }
 
     if(target_t->kind != TYPE_KIND_STRUCT || target_t->flags & TYPE_ARRAY || target_t->pointer_depth > 1) {
-        ctx.raise_error(fmt("Cannot perform member access on type {}.", typedata_to_str_msg(*target_t)), node->pos);
+        ctx.report(DIAG_MEMBER_ACCESS_TYPE, node->pos, *target_t);
         return std::nullopt;
     }
 
@@ -656,7 +750,7 @@ tak::visit_member_access(const AstMemberAccess* node, CheckerContext& ctx) {
         return *member_type;
     }
 
-    ctx.raise_error(fmt("Cannot access \"{}\" within type \"{}\".", node->path, typedata_to_str_msg(*target_t)), node->pos);
+    ctx.report(DIAG_NO_SUCH_MEMBER, node->pos, node->path, *target_t);
     return std::nullopt;
 }
 
@@ -670,12 +764,12 @@ tak::visit_defer_if(const AstDeferIf* node, CheckerContext& ctx) {
     const auto call_t      = visit_node(node->call, ctx);
 
     if(!condition_t) {
-        ctx.raise_error("defer_if condition does not produce a type.", node->condition->pos);
+        ctx.report(DIAG_DEFER_IF_UNTYPED, node->condition->pos);
         return std::nullopt;
     }
 
     if(!is_type_lop_eligible(*condition_t)) {
-        ctx.raise_error(fmt("Type {} cannot be used as a logical expression.", typedata_to_str_msg(*condition_t)), node->condition->pos);
+        ctx.report(DIAG_NOT_LOGICAL, node->condition->pos, *condition_t);
     }
 
     return call_t;
@@ -694,18 +788,34 @@ std::optional<tak::TypeData>
 tak::visit_sizeof(const AstSizeof* node, CheckerContext& ctx) {
 
     assert(node != nullptr);
+    std::optional<TypeData> target_t;
+
     if(const auto* is_child_node = std::get_if<AstNode*>(&node->target)) {
-        if(!visit_node(*is_child_node, ctx)) {
-            ctx.raise_error("Expression does not evaluate to a type.", (*is_child_node)->pos);
+        target_t = visit_node(*is_child_node, ctx);
+        if(!target_t) {
+            ctx.report(DIAG_EXPRESSION_UNTYPED, (*is_child_node)->pos);
             return std::nullopt;
         }
+    } else {
+        target_t = std::get<TypeData>(node->target);
     }
 
+
+    //
+    // Like an integer literal, the result gets the smallest type that can hold it.
+    //
+
     TypeData const_int;
     const_int.kind   = TYPE_KIND_VARIABLE;
     const_int.name   = VAR_U8;
     const_int.flags |= TYPE_RVALUE | TYPE_CONSTANT | TYPE_NON_CONCRETE;
 
+    if(const auto size = get_type_size(*target_t, ctx.parser_)) {
+        if(*size > std::numeric_limits<uint32_t>::max())      const_int.name = VAR_U64;
+        else if(*size > std::numeric_limits<uint16_t>::max()) const_int.name = VAR_U32;
+        else if(*size > std::numeric_limits<uint8_t>::max())  const_int.name = VAR_U16;
+    }
+
     return const_int;
 }
 
@@ -717,13 +827,12 @@ tak::visit_branch(const AstBranch* node, CheckerContext& ctx) {
     for(const AstIf* _if : node->conditions) {
         const auto condition_t = visit_node(_if->condition, ctx);
         if(!condition_t) {
-            ctx.raise_error("Invalid branch condition: contained expression does not produce a type.", _if->pos);
+            ctx.report(DIAG_BRANCH_UNTYPED, _if->pos);
             continue;
         }
 
-        const std::string cond_str = typedata_to_str_msg(*condition_t);
         if(!is_type_lop_eligible(*condition_t)) {
-            ctx.raise_error(fmt("Type {} cannot be used as a logical expression.", cond_str), _if->condition->pos);
+            ctx.report(DIAG_NOT_LOGICAL, _if->condition->pos, *condition_t);
         }
 
         for(AstNode* branch_child : _if->body) {
@@ -747,17 +856,16 @@ tak::visit_for(const AstFor* node, CheckerContext& ctx) {
     assert(node != nullptr);
     if(node->init) {
         if(const auto init_t = visit_node(*node->init, ctx); !init_t) {
-            ctx.raise_error("For-loop initialization clause does not produce a type.", (*node->init)->pos);
+            ctx.report(DIAG_FOR_INIT_UNTYPED, (*node->init)->pos);
         }
     }
 
     if(node->condition) {
         const auto condition_t = visit_node(*node->condition, ctx);
         if(!condition_t) {
-            ctx.raise_error("For-loop condition does not produce a type.",  (*node->condition)->pos);
+            ctx.report(DIAG_FOR_CONDITION_UNTYPED, (*node->condition)->pos);
         } else if(!is_type_lop_eligible(*condition_t)) {
-            const std::string cond_t_str = typedata_to_str_msg(*condition_t);
-            ctx.raise_error(fmt("Type {} cannot be used as a for-loop condition.", cond_t_str), (*node->condition)->pos);
+            ctx.report(DIAG_FOR_CONDITION_TYPE, (*node->condition)->pos, *condition_t);
         }
     }
 
@@ -776,14 +884,12 @@ tak::visit_switch(const AstSwitch* node, CheckerContext& ctx) {
     auto target_t = visit_node(node->target, ctx);
 
     if(!target_t) {
-        ctx.raise_error("Switch target does not produce a type.", node->target->pos);
+        ctx.report(DIAG_SWITCH_TARGET_UNTYPED, node->target->pos);
         return std::nullopt;
     }
 
-    const std::string target_t_str = typedata_to_str_msg(*target_t);
-
     if(!is_type_bwop_eligible(*target_t)) {
-        ctx.raise_error(fmt("Type {} cannot be used as a switch target.", target_t_str), node->target->pos);
+        ctx.report(DIAG_SWITCH_TARGET_TYPE, node->target->pos, *target_t);
         return std::nullopt;
     }
 
@@ -791,12 +897,12 @@ tak::visit_switch(const AstSwitch* node, CheckerContext& ctx) {
     for(AstCase* _case : node->cases) {
         const auto case_t = visit_node(_case->value, ctx);
         if(!case_t) {
-            ctx.raise_error("Case value does not produce a type.", _case->pos);
+            ctx.report(DIAG_CASE_UNTYPED, _case->pos);
             continue;
         }
 
         if(!is_type_coercion_permissible(*target_t, *case_t)) {
-            ctx.raise_error(fmt("Cannot coerce type of case value ({}) to {}.", typedata_to_str_msg(*case_t), target_t_str), _case->pos);
+            ctx.report(DIAG_CASE_COERCION, _case->pos, *case_t, *target_t);
         }
 
         for(AstNode* child : _case->body) {
@@ -839,11 +945,11 @@ tak::visit_while(AstNode* node, CheckerContext& ctx) {
     const auto condition_t = visit_node(condition, ctx);
 
     if(!condition_t) {
-        ctx.raise_error("Loop condition does not produce a type.", condition->pos);
+        ctx.report(DIAG_WHILE_CONDITION_UNTYPED, condition->pos);
     }
 
     else if(!is_type_lop_eligible(*condition_t)) {
-        ctx.raise_error(fmt("Type {} cannot be used as a condition for a while-loop.", typedata_to_str_msg(*condition_t)), condition->pos);
+        ctx.report(DIAG_WHILE_CONDITION_TYPE, condition->pos, *condition_t);
     }
 
     for(AstNode* child : *branch_body) {
@@ -862,24 +968,22 @@ tak::visit_subscript(const AstSubscript* node, CheckerContext& ctx) {
     const auto value_t   = visit_node(node->value, ctx);
     const auto operand_t = visit_node(node->operand, ctx);
 
-    if(!value_t)   ctx.raise_error("Value within subscript operator does not evaluate to a type.", node->value->pos);
-    if(!operand_t) ctx.raise_error("Subscript operand does not evaluate to a type.", node->operand->pos);
+    if(!value_t)   ctx.report(DIAG_SUBSCRIPT_VALUE_UNTYPED, node->value->pos);
+    if(!operand_t) ctx.report(DIAG_SUBSCRIPT_OPERAND_UNTYPED, node->operand->pos);
 
     if(!value_t || !operand_t) {
         return std::nullopt;
     }
 
 
-    const std::string value_t_str   = typedata_to_str_msg(*value_t);
-    const std::string operand_t_str = typedata_to_str_msg(*operand_t);
-    const auto        deref_t       = get_dereferenced_type(*operand_t);
+    const auto deref_t = get_dereferenced_type(*operand_t);
 
     if(!is_type_bwop_eligible(*value_t)) {
-        ctx.raise_error(fmt("Type {} Cannot be used as a subscript value.", value_t_str), node->value->pos);
+        ctx.report(DIAG_SUBSCRIPT_VALUE_TYPE, node->value->pos, *value_t);
     }
 
     if(!deref_t) {
-        ctx.raise_error(fmt("Type {} cannot be subscripted into.", operand_t_str), node->operand->pos);
+        ctx.report(DIAG_SUBSCRIPT_OPERAND_TYPE, node->operand->pos, *operand_t);
         return std::nullopt;
     }
 
@@ -893,35 +997,51 @@ tak::visit_node(AstNode* node, CheckerContext& ctx) {
     assert(node != nullptr);
     assert(node->type != NODE_NONE);
 
+    std::optional<TypeData> type;
     switch(node->type) {
-        case NODE_NAMESPACEDECL:     return visit_node_children(dynamic_cast<AstNamespaceDecl*>(node), ctx);
-        case NODE_COMPOSEDECL:       return visit_node_children(dynamic_cast<AstComposeDecl*>(node), ctx);
-        case NODE_BLOCK:             return visit_node_children(dynamic_cast<AstBlock*>(node), ctx);
-        case NODE_VARDECL:           return visit_vardecl(dynamic_cast<AstVardecl*>(node), ctx);
-        case NODE_PROCDECL:          return visit_procdecl(dynamic_cast<AstProcdecl*>(node), ctx);
-        case NODE_BINEXPR:           return visit_binexpr(dynamic_cast<AstBinexpr*>(node), ctx);
-        case NODE_UNARYEXPR:         return visit_unaryexpr(dynamic_cast<AstUnaryexpr*>(node), ctx);
-        case NODE_SINGLETON_LITERAL: return visit_singleton_literal(dynamic_cast<AstSingletonLiteral*>(node), ctx);
-        case NODE_IDENT:             return visit_identifier(dynamic_cast<AstIdentifier*>(node), ctx);
-        case NODE_CAST:              return visit_cast(dynamic_cast<AstCast*>(node), ctx);
-        case NODE_BRANCH:            return visit_branch(dynamic_cast<AstBranch*>(node), ctx);
-        case NODE_FOR:               return visit_for(dynamic_cast<AstFor*>(node), ctx);
-        case NODE_SWITCH:            return visit_switch(dynamic_cast<AstSwitch*>(node), ctx);
-        case NODE_CALL:              return visit_call(dynamic_cast<AstCall*>(node), ctx);
-        case NODE_RET:               return visit_ret(dynamic_cast<AstRet*>(node), ctx);
-        case NODE_DEFER:             return visit_defer(dynamic_cast<AstDefer*>(node), ctx);
-        case NODE_DEFER_IF:          return visit_defer_if(dynamic_cast<AstDeferIf*>(node), ctx);
-        case NODE_SIZEOF:            return visit_sizeof(dynamic_cast<AstSizeof*>(node), ctx);
-        case NODE_SUBSCRIPT:         return visit_subscript(dynamic_cast<AstSubscript*>(node), ctx);
-        case NODE_MEMBER_ACCESS:     return visit_member_access(dynamic_cast<AstMemberAccess*>(node), ctx);
-        case NODE_WHILE:             return visit_while(node, ctx);
-        case NODE_DOWHILE:           return visit_while(node, ctx);
-        case NODE_BRACED_EXPRESSION: return std::nullopt;
-
-        default: break;
-    }
-
-    panic("visit_node: non-visitable node passed.");
+        case NODE_NAMESPACEDECL:     type = visit_node_children(dynamic_cast<AstNamespaceDecl*>(node), ctx); break;
+        case NODE_COMPOSEDECL:       type = visit_node_children(dynamic_cast<AstComposeDecl*>(node), ctx); break;
+        case NODE_BLOCK:             type = visit_node_children(dynamic_cast<AstBlock*>(node), ctx); break;
+        case NODE_VARDECL:           type = visit_vardecl(dynamic_cast<AstVardecl*>(node), ctx); break;
+        case NODE_PROCDECL:          type = visit_procdecl(dynamic_cast<AstProcdecl*>(node), ctx); break;
+        case NODE_BINEXPR:           type = visit_binexpr(dynamic_cast<AstBinexpr*>(node), ctx); break;
+        case NODE_UNARYEXPR:         type = visit_unaryexpr(dynamic_cast<AstUnaryexpr*>(node), ctx); break;
+        case NODE_SINGLETON_LITERAL: type = visit_singleton_literal(dynamic_cast<AstSingletonLiteral*>(node), ctx); break;
+        case NODE_IDENT:             type = visit_identifier(dynamic_cast<AstIdentifier*>(node), ctx); break;
+        case NODE_CAST:              type = visit_cast(dynamic_cast<AstCast*>(node), ctx); break;
+        case NODE_BRANCH:            type = visit_branch(dynamic_cast<AstBranch*>(node), ctx); break;
+        case NODE_FOR:               type = visit_for(dynamic_cast<AstFor*>(node), ctx); break;
+        case NODE_SWITCH:            type = visit_switch(dynamic_cast<AstSwitch*>(node), ctx); break;
+        case NODE_CALL:              type = visit_call(dynamic_cast<AstCall*>(node), ctx); break;
+        case NODE_RET:               type = visit_ret(dynamic_cast<AstRet*>(node), ctx); break;
+        case NODE_DEFER:             type = visit_defer(dynamic_cast<AstDefer*>(node), ctx); break;
+        case NODE_DEFER_IF:          type = visit_defer_if(dynamic_cast<AstDeferIf*>(node), ctx); break;
+        case NODE_SIZEOF:            type = visit_sizeof(dynamic_cast<AstSizeof*>(node), ctx); break;
+        case NODE_SUBSCRIPT:         type = visit_subscript(dynamic_cast<AstSubscript*>(node), ctx); break;
+        case NODE_MEMBER_ACCESS:     type = visit_member_access(dynamic_cast<AstMemberAccess*>(node), ctx); break;
+        case NODE_WHILE:             type = visit_while(node, ctx); break;
+        case NODE_DOWHILE:           type = visit_while(node, ctx); break;
+        case NODE_BRACED_EXPRESSION: type = std::nullopt; break;
+
+        default: panic("visit_node: non-visitable node passed.");
+    }
+
+
+    //
+    // Remember the type on the node, so nothing after the checker has to visit it again.
+    // Same goes for the value, if the expression turns out to be a constant.
+    //
+
+    if(type && VALID_SUBEXPRESSION(node->type)) {
+        ctx.annotate(node, *type);
+        if(const auto value = fold_constant(node, *type, ctx)) {
+            ctx.record_constant(node, *value);
+        }
+    } else if(node->type == NODE_VARDECL) {
+        annotate_declaration(dynamic_cast<AstVardecl*>(node), ctx);
+    }
+
+    return type;
 }
 
 
@@ -0,0 +1,696 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <image.hpp>
+#include <cstring>
+
+#ifdef TAK_WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+struct ImageCursor {
+    const uint8_t* data    = nullptr;
+    size_t         size    = 0;
+    size_t         index   = 0;
+    const uint8_t* strings = nullptr;
+    size_t         strings_size = 0;
+    uint32_t       type_count   = 0;  // Largest valid type ID.
+    uint32_t       const_count  = 0;  // Largest valid constant ID.
+    bool           ok      = true;
+};
+
+
+template<typename T>
+static T
+get(ImageCursor& cur) {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    T value{};
+    if(!cur.ok || cur.size - cur.index < sizeof(T)) {
+        cur.ok = false;
+        return value;
+    }
+
+    std::memcpy(&value, cur.data + cur.index, sizeof(T));
+    cur.index += sizeof(T);
+    return value;
+}
+
+static std::string
+get_string(ImageCursor& cur) {
+
+    const auto offset = get<uint32_t>(cur);
+    const auto length = get<uint32_t>(cur);
+
+    if(!cur.ok || offset > cur.strings_size || cur.strings_size - offset < length) {
+        cur.ok = false;
+        return {};
+    }
+
+    return { reinterpret_cast<const char*>(cur.strings) + offset, length };
+}
+
+static bool
+get_type_data(ImageCursor& cur, tak::TypeData& type) {
+
+    type.pointer_depth = get<uint16_t>(cur);
+    type.flags         = get<uint64_t>(cur);
+    type.kind          = static_cast<tak::type_kind_t>(get<uint8_t>(cur));
+    type.sym_ref       = get<uint32_t>(cur);
+
+    const auto array_count = get<uint32_t>(cur);
+    for(uint32_t i = 0; i < array_count && cur.ok; ++i) {
+        type.array_lengths.emplace_back(get<uint32_t>(cur));
+    }
+
+    switch(get<uint8_t>(cur)) {
+        case 0:  type.name = static_cast<tak::var_t>(get<uint16_t>(cur)); break;
+        case 1:  type.name = get_string(cur); break;
+        case 2:  type.name = std::monostate(); break;
+        default: cur.ok = false; break;
+    }
+
+    if(get<uint8_t>(cur)) {
+        const auto param_count = get<uint32_t>(cur);
+        type.parameters = std::make_shared<std::vector<tak::TypeData>>();
+        for(uint32_t i = 0; i < param_count && cur.ok; ++i) {
+            get_type_data(cur, type.parameters->emplace_back());
+        }
+    }
+
+    if(get<uint8_t>(cur)) {
+        type.return_type = std::make_shared<tak::TypeData>();
+        get_type_data(cur, *type.return_type);
+    }
+
+    return cur.ok;
+}
+
+
+//
+// AST fix-up. Nodes are rebuilt in the same preorder they were written in,
+// and each child gets its parent pointer set on the way.
+//
+
+static tak::AstNode* get_node(ImageCursor& cur, tak::AstNode* parent);
+
+template<typename T>
+static bool
+get_child(ImageCursor& cur, tak::AstNode* parent, T*& out, const bool nullable = false) {
+
+    tak::AstNode* node = get_node(cur, parent);
+    if(node == nullptr) {
+        cur.ok = cur.ok && nullable;
+        return cur.ok;
+    }
+
+    out = dynamic_cast<T*>(node);
+    if(out == nullptr) {
+        delete node;
+        cur.ok = false;
+    }
+
+    return cur.ok;
+}
+
+template<typename T>
+static bool
+get_optional_child(ImageCursor& cur, tak::AstNode* parent, std::optional<T*>& out) {
+
+    T* node = nullptr;
+    if(!get_child(cur, parent, node, true)) {
+        return false;
+    }
+
+    if(node != nullptr) {
+        out = node;
+    }
+
+    return true;
+}
+
+template<typename Container>
+static bool
+get_children(ImageCursor& cur, tak::AstNode* parent, Container& out) {
+
+    const auto count = get<uint32_t>(cur);
+    if(!cur.ok || count > cur.size - cur.index) { // every node takes up at least one byte.
+        cur.ok = false;
+        return false;
+    }
+
+    out.reserve(count);
+    for(uint32_t i = 0; i < count; ++i) {
+        typename Container::value_type child = nullptr;
+        if(!get_child(cur, parent, child)) {
+            return false;
+        }
+
+        out.emplace_back(child);
+    }
+
+    return true;
+}
+
+static tak::AstNode*
+get_node(ImageCursor& cur, tak::AstNode* parent) {
+
+    using namespace tak;
+
+    const auto type = static_cast<node_t>(get<uint16_t>(cur));
+    if(!cur.ok || type == NODE_NONE) {
+        return nullptr;
+    }
+
+    const auto pos     = get<uint64_t>(cur);
+    const auto type_id  = get<uint32_t>(cur);
+    const auto const_id = get<uint32_t>(cur);
+    AstNode*   node     = nullptr;
+    bool       state    = false;
+
+    if(type_id > cur.type_count || const_id > cur.const_count) {
+        cur.ok = false;
+        return nullptr;
+    }
+
+    switch(type) {
+        case NODE_VARDECL: {
+            auto* vardecl = new AstVardecl();
+            node  = vardecl;
+            state = get_child(cur, node, vardecl->identifier) && get_optional_child(cur, node, vardecl->init_value);
+            break;
+        }
+
+        case NODE_PROCDECL: {
+            auto* procdecl = new AstProcdecl();
+            node  = procdecl;
+            state = get_child(cur, node, procdecl->identifier)
+                && get_children(cur, node, procdecl->parameters)
+                && get_children(cur, node, procdecl->body);
+            break;
+        }
+
+        case NODE_BINEXPR: {
+            auto* binexpr = new AstBinexpr();
+            node  = binexpr;
+            binexpr->_operator = static_cast<token_t>(get<uint32_t>(cur));
+            state = get_child(cur, node, binexpr->left_op) && get_child(cur, node, binexpr->right_op);
+            break;
+        }
+
+        case NODE_UNARYEXPR: {
+            auto* unaryexpr = new AstUnaryexpr();
+            node  = unaryexpr;
+            unaryexpr->_operator = static_cast<token_t>(get<uint32_t>(cur));
+            state = get_child(cur, node, unaryexpr->operand);
+            break;
+        }
+
+        case NODE_IDENT: {
+            auto* ident = new AstIdentifier();
+            node  = ident;
+            ident->symbol_index = get<uint32_t>(cur);
+            state = cur.ok;
+            break;
+        }
+
+        case NODE_BRANCH: {
+            auto* branch = new AstBranch();
+            node  = branch;
+            state = get_children(cur, node, branch->conditions) && get_optional_child(cur, node, branch->_else);
+            break;
+        }
+
+        case NODE_IF: {
+            auto* _if = new AstIf();
+            node  = _if;
+            state = get_child(cur, node, _if->condition) && get_children(cur, node, _if->body);
+            break;
+        }
+
+        case NODE_ELSE: {
+            auto* _else = new AstElse();
+            node  = _else;
+            state = get_children(cur, node, _else->body);
+            break;
+        }
+
+        case NODE_DEFAULT: {
+            auto* _default = new AstDefault();
+            node  = _default;
+            state = get_children(cur, node, _default->body);
+            break;
+        }
+
+        case NODE_BLOCK: {
+            auto* block = new AstBlock();
+            node  = block;
+            state = get_children(cur, node, block->children);
+            break;
+        }
+
+        case NODE_FOR: {
+            auto* _for = new AstFor();
+            node  = _for;
+            state = get_children(cur, node, _for->body)
+                && get_optional_child(cur, node, _for->init)
+                && get_optional_child(cur, node, _for->condition)
+                && get_optional_child(cur, node, _for->update);
+            break;
+        }
+
+        case NODE_SWITCH: {
+            auto* _switch = new AstSwitch();
+            node  = _switch;
+            state = get_child(cur, node, _switch->target)
+                && get_child(cur, node, _switch->_default, true)
+                && get_children(cur, node, _switch->cases);
+            break;
+        }
+
+        case NODE_CASE: {
+            auto* _case = new AstCase();
+            node  = _case;
+            _case->fallthrough = get<uint8_t>(cur);
+            state = get_child(cur, node, _case->value, true) && get_children(cur, node, _case->body);
+            break;
+        }
+
+        case NODE_WHILE: {
+            auto* _while = new AstWhile();
+            node  = _while;
+            state = get_child(cur, node, _while->condition) && get_children(cur, node, _while->body);
+            break;
+        }
+
+        case NODE_DOWHILE: {
+            auto* dowhile = new AstDoWhile();
+            node  = dowhile;
+            state = get_child(cur, node, dowhile->condition) && get_children(cur, node, dowhile->body);
+            break;
+        }
+
+        case NODE_CALL: {
+            auto* call = new AstCall();
+            node  = call;
+            state = get_child(cur, node, call->target) && get_children(cur, node, call->arguments);
+            break;
+        }
+
+        case NODE_BRK:  node = new AstBrk();  state = true; break;
+        case NODE_CONT: node = new AstCont(); state = true; break;
+
+        case NODE_RET: {
+            auto* ret = new AstRet();
+            node  = ret;
+            state = get_optional_child(cur, node, ret->value);
+            break;
+        }
+
+        case NODE_DEFER: {
+            auto* _defer = new AstDefer();
+            node  = _defer;
+            state = get_child(cur, node, _defer->call);
+            break;
+        }
+
+        case NODE_DEFER_IF: {
+            auto* defer_if = new AstDeferIf();
+            node  = defer_if;
+            state = get_child(cur, node, defer_if->call) && get_child(cur, node, defer_if->condition);
+            break;
+        }
+
+        case NODE_SIZEOF: {
+            auto* _sizeof = new AstSizeof();
+            node  = _sizeof;
+            if(get<uint8_t>(cur) == 0) {
+                state = get_type_data(cur, _sizeof->target.emplace<TypeData>());
+            } else {
+                state = get_child(cur, node, std::get<AstNode*>(_sizeof->target));
+            }
+            break;
+        }
+
+        case NODE_SINGLETON_LITERAL: {
+            auto* literal = new AstSingletonLiteral();
+            node  = literal;
+            literal->literal_type = static_cast<token_t>(get<uint32_t>(cur));
+            literal->value        = get_string(cur);
+            state = cur.ok;
+            break;
+        }
+
+        case NODE_BRACED_EXPRESSION: {
+            auto* braced = new AstBracedExpression();
+            node  = braced;
+            state = get_children(cur, node, braced->members);
+            break;
+        }
+
+        case NODE_STRUCT_DEFINITION: {
+            auto* structdef = new AstStructdef();
+            node  = structdef;
+            structdef->name = get_string(cur);
+            state = cur.ok;
+            break;
+        }
+
+        case NODE_TYPE_ALIAS: {
+            auto* alias = new AstTypeAlias();
+            node  = alias;
+            alias->name = get_string(cur);
+            state = cur.ok;
+            break;
+        }
+
+        case NODE_ENUM_DEFINITION: {
+            auto* enumdef = new AstEnumdef();
+            node  = enumdef;
+            state = get_child(cur, node, enumdef->_namespace) && get_child(cur, node, enumdef->alias);
+            break;
+        }
+
+        case NODE_SUBSCRIPT: {
+            auto* subscript = new AstSubscript();
+            node  = subscript;
+            state = get_child(cur, node, subscript->operand) && get_child(cur, node, subscript->value);
+            break;
+        }
+
+        case NODE_NAMESPACEDECL: {
+            auto* _namespace = new AstNamespaceDecl();
+            node  = _namespace;
+            _namespace->full_path = get_string(cur);
+            state = get_children(cur, node, _namespace->children);
+            break;
+        }
+
+        case NODE_COMPOSEDECL: {
+            auto* compose = new AstComposeDecl();
+            node  = compose;
+            compose->type_name = get_string(cur);
+            state = get_children(cur, node, compose->children);
+            break;
+        }
+
+        case NODE_CAST: {
+            auto* cast = new AstCast();
+            node  = cast;
+            state = get_type_data(cur, cast->type) && get_child(cur, node, cast->target);
+            break;
+        }
+
+        case NODE_MEMBER_ACCESS: {
+            auto* member_access = new AstMemberAccess();
+            node  = member_access;
+            member_access->path = get_string(cur);
+            state = get_child(cur, node, member_access->target);
+            break;
+        }
+
+        default:
+            break;
+    }
+
+    if(!state) {
+        cur.ok = false;
+        delete node;
+        return nullptr;
+    }
+
+    node->pos      = pos;
+    node->type_id  = type_id;
+    node->const_id = const_id;
+    if(parent != nullptr) {
+        node->parent = parent;
+    }
+
+    return node;
+}
+
+
+static ImageCursor
+section_cursor(const uint8_t* data, const tak::ImageSection& section, const tak::ImageHeader& header) {
+
+    ImageCursor cur;
+    cur.data         = data + section.offset;
+    cur.size         = section.size;
+    cur.strings      = data + header.strings.offset;
+    cur.strings_size = header.strings.size;
+    cur.type_count   = header.node_types.count;
+    cur.const_count  = header.node_constants.count;
+    return cur;
+}
+
+static bool
+section_in_bounds(const tak::ImageSection& section, const size_t size) {
+    return section.offset <= size && size - section.offset >= section.size;
+}
+
+
+bool
+tak::read_image(const uint8_t* data, const size_t size, const uint64_t source_hash, Parser& parser) {
+
+    assert(data != nullptr);
+    assert(parser.toplevel_decls_.empty());
+
+    ImageHeader header;
+    if(size < sizeof(ImageHeader)) {
+        return false;
+    }
+
+    std::memcpy(&header, data, sizeof(ImageHeader));
+    if(header.magic != TAK_IMAGE_MAGIC || header.version != TAK_IMAGE_VERSION || header.source_hash != source_hash) {
+        return false;
+    }
+
+    for(const auto* section : { &header.strings, &header.nodes, &header.toplevel, &header.symbols,
+                                &header.types, &header.aliases, &header.globals, &header.node_types,
+                                &header.node_constants }) {
+        if(!section_in_bounds(*section, size)) {
+            return false;
+        }
+    }
+
+
+    //
+    // Rebuild everything into temporaries first, the parser is only touched once the whole image checks out.
+    //
+
+    std::vector<AstNode*>                          decls;
+    std::unordered_map<uint32_t, Symbol>           symbols;
+    std::unordered_map<std::string, UserType>      types;
+    std::unordered_map<std::string, TypeData>      aliases;
+    std::unordered_map<std::string, uint32_t>      globals;
+    std::vector<TypeData>                          node_types;
+    std::vector<ConstantValue>                     node_constants;
+
+    bool state = false;
+    defer_if(!state, [&] {
+        for(const auto* decl : decls) { delete decl; }
+    });
+
+    auto toplevel = section_cursor(data, header.toplevel, header);
+    auto nodes    = section_cursor(data, header.nodes, header);
+
+    decls.reserve(header.toplevel.count);
+    for(uint32_t i = 0; i < header.toplevel.count; ++i) {
+        const auto offset = get<uint64_t>(toplevel);
+        if(!toplevel.ok || offset >= nodes.size) {
+            return false;
+        }
+
+        nodes.index = offset;
+        AstNode* decl = get_node(nodes, nullptr);
+        if(decl == nullptr) {
+            return false;
+        }
+
+        decls.emplace_back(decl);
+    }
+
+    auto cur = section_cursor(data, header.symbols, header);
+    for(uint32_t i = 0; i < header.symbols.count && cur.ok; ++i) {
+        Symbol sym;
+        sym.symbol_index = get<uint32_t>(cur);
+        sym.flags        = get<uint32_t>(cur);
+        sym.line_number  = get<uint32_t>(cur);
+        sym.src_pos      = get<uint64_t>(cur);
+        sym.name         = get_string(cur);
+
+        if(get_type_data(cur, sym.type)) {
+            sym.constant.type = static_cast<var_t>(get<uint16_t>(cur));
+            sym.constant.bits = get<uint64_t>(cur);
+            symbols.emplace(sym.symbol_index, std::move(sym));
+        }
+    }
+
+    if(!cur.ok) {
+        return false;
+    }
+
+    cur = section_cursor(data, header.types, header);
+    for(uint32_t i = 0; i < header.types.count && cur.ok; ++i) {
+        std::string name      = get_string(cur);
+        UserType    type;
+        type.is_placeholder   = get<uint8_t>(cur);
+        type.is_packed        = get<uint8_t>(cur);
+        type.alignment        = get<uint32_t>(cur);
+        type.pos_first_used   = get<uint64_t>(cur);
+        type.line_first_used  = get<uint32_t>(cur);
+
+        const auto member_count = get<uint32_t>(cur);
+        for(uint32_t j = 0; j < member_count && cur.ok; ++j) {
+            auto& member = type.members.emplace_back();
+            member.name  = get_string(cur);
+            get_type_data(cur, member.type);
+        }
+
+        type.reindex_members();
+        types.emplace(std::move(name), std::move(type));
+    }
+
+    if(!cur.ok) {
+        return false;
+    }
+
+    cur = section_cursor(data, header.aliases, header);
+    for(uint32_t i = 0; i < header.aliases.count && cur.ok; ++i) {
+        std::string name = get_string(cur);
+        get_type_data(cur, aliases[std::move(name)]);
+    }
+
+    if(!cur.ok) {
+        return false;
+    }
+
+    cur = section_cursor(data, header.globals, header);
+    for(uint32_t i = 0; i < header.globals.count && cur.ok; ++i) {
+        std::string name = get_string(cur);
+        globals[std::move(name)] = get<uint32_t>(cur);
+    }
+
+    if(!cur.ok) {
+        return false;
+    }
+
+    cur = section_cursor(data, header.node_types, header);
+    if(header.node_types.count > header.node_types.size) { // every type takes up at least one byte.
+        return false;
+    }
+
+    node_types.resize(header.node_types.count);
+    for(uint32_t i = 0; i < header.node_types.count && cur.ok; ++i) {
+        get_type_data(cur, node_types[i]);
+    }
+
+    if(!cur.ok) {
+        return false;
+    }
+
+    cur = section_cursor(data, header.node_constants, header);
+    if(header.node_constants.count > header.node_constants.size) {
+        return false;
+    }
+
+    node_constants.resize(header.node_constants.count);
+    for(uint32_t i = 0; i < header.node_constants.count && cur.ok; ++i) {
+        node_constants[i].type = static_cast<var_t>(get<uint16_t>(cur));
+        node_constants[i].bits = get<uint64_t>(cur);
+    }
+
+    if(!cur.ok) {
+        return false;
+    }
+
+    parser.toplevel_decls_ = std::move(decls);
+    parser.sym_table_      = std::move(symbols);
+    parser.type_table_     = std::move(types);
+    parser.type_aliases_   = std::move(aliases);
+    parser.curr_sym_index_ = header.curr_sym_index;
+
+    parser.node_types_.clear();
+    parser.node_type_ids_.clear();
+    for(const auto& type : node_types) {
+        parser.intern_node_type(type);   // Types are unique, so this hands out the same IDs again.
+    }
+
+    parser.node_constants_ = std::move(node_constants);
+
+    parser.scope_stack_.clear();
+    if(header.flags & IMAGE_HAS_GLOBAL_SCOPE) {
+        parser.scope_stack_.emplace_back(std::move(globals));
+    }
+
+    state = true;
+    return true;
+}
+
+
+bool
+tak::load_image_file(const std::string& image_path, const uint64_t source_hash, Parser& parser) {
+
+#ifdef TAK_WINDOWS
+    HANDLE      file    = CreateFileA(image_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    HANDLE      mapping = nullptr;
+    const void* view    = nullptr;
+
+    if(file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    defer([&] {
+        if(view != nullptr)    { UnmapViewOfFile(view); }
+        if(mapping != nullptr) { CloseHandle(mapping); }
+        CloseHandle(file);
+    });
+
+    LARGE_INTEGER file_size = {};
+    if(!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        return false;
+    }
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if(mapping == nullptr) {
+        return false;
+    }
+
+    view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(view == nullptr) {
+        return false;
+    }
+
+    return read_image(static_cast<const uint8_t*>(view), static_cast<size_t>(file_size.QuadPart), source_hash, parser);
+
+#else
+    const int fd = open(image_path.c_str(), O_RDONLY);
+    if(fd == -1) {
+        return false;
+    }
+
+    struct stat file_info = {};
+    if(fstat(fd, &file_info) == -1 || file_info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(file_info.st_size);
+    void*        view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    close(fd); // the mapping stays valid.
+    if(view == MAP_FAILED) {
+        return false;
+    }
+
+    defer([&] { munmap(view, size); });
+    return read_image(static_cast<const uint8_t*>(view), size, source_hash, parser);
+#endif
+}
@@ -0,0 +1,478 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <image.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+
+struct ImageWriter {
+    std::vector<uint8_t> strings;
+    std::vector<uint8_t> nodes;
+    std::vector<uint8_t> toplevel;
+    std::vector<uint8_t> symbols;
+    std::vector<uint8_t> types;
+    std::vector<uint8_t> aliases;
+    std::vector<uint8_t> globals;
+    std::vector<uint8_t> node_types;
+    std::vector<uint8_t> node_constants;
+
+    std::unordered_map<std::string, uint32_t> interned;
+};
+
+
+template<typename T>
+static void
+put(std::vector<uint8_t>& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+static void
+put_string(ImageWriter& writer, std::vector<uint8_t>& out, const std::string& str) {
+
+    uint32_t offset = 0;
+    if(const auto it = writer.interned.find(str); it != writer.interned.end()) {
+        offset = it->second;
+    } else {
+        offset = static_cast<uint32_t>(writer.strings.size());
+        writer.strings.insert(writer.strings.end(), str.begin(), str.end());
+        writer.interned.emplace(str, offset);
+    }
+
+    put<uint32_t>(out, offset);
+    put<uint32_t>(out, static_cast<uint32_t>(str.size()));
+}
+
+static void
+put_type_data(ImageWriter& writer, std::vector<uint8_t>& out, const tak::TypeData& type) {
+
+    put<uint16_t>(out, type.pointer_depth);
+    put<uint64_t>(out, type.flags);
+    put<uint8_t>(out, type.kind);
+    put<uint32_t>(out, type.sym_ref);
+
+    put<uint32_t>(out, static_cast<uint32_t>(type.array_lengths.size()));
+    for(const uint32_t length : type.array_lengths) {
+        put<uint32_t>(out, length);
+    }
+
+    if(const auto* var_type = std::get_if<tak::var_t>(&type.name)) {
+        put<uint8_t>(out, 0);
+        put<uint16_t>(out, *var_type);
+    } else if(const auto* type_name = std::get_if<std::string>(&type.name)) {
+        put<uint8_t>(out, 1);
+        put_string(writer, out, *type_name);
+    } else {
+        put<uint8_t>(out, 2);
+    }
+
+    put<uint8_t>(out, type.parameters != nullptr);
+    if(type.parameters != nullptr) {
+        put<uint32_t>(out, static_cast<uint32_t>(type.parameters->size()));
+        for(const auto& param : *type.parameters) {
+            put_type_data(writer, out, param);
+        }
+    }
+
+    put<uint8_t>(out, type.return_type != nullptr);
+    if(type.return_type != nullptr) {
+        put_type_data(writer, out, *type.return_type);
+    }
+}
+
+
+//
+// AST serialization. A null child is written as NODE_NONE with nothing following it.
+//
+
+static bool put_node(ImageWriter& writer, const tak::AstNode* node);
+
+static bool
+put_optional_node(ImageWriter& writer, const std::optional<tak::AstNode*>& node) {
+    return put_node(writer, node.value_or(nullptr));
+}
+
+template<typename Container>
+static bool
+put_nodes(ImageWriter& writer, const Container& nodes) {
+
+    put<uint32_t>(writer.nodes, static_cast<uint32_t>(nodes.size()));
+    for(const auto* node : nodes) {
+        if(!put_node(writer, node)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool
+put_node(ImageWriter& writer, const tak::AstNode* node) {
+
+    using namespace tak;
+
+    if(node == nullptr) {
+        put<uint16_t>(writer.nodes, NODE_NONE);
+        return true;
+    }
+
+    put<uint16_t>(writer.nodes, node->type);
+    put<uint64_t>(writer.nodes, node->pos);
+    put<uint32_t>(writer.nodes, node->type_id);
+    put<uint32_t>(writer.nodes, node->const_id);
+
+    switch(node->type) {
+        case NODE_VARDECL: {
+            const auto* vardecl = dynamic_cast<const AstVardecl*>(node);
+            return put_node(writer, vardecl->identifier) && put_optional_node(writer, vardecl->init_value);
+        }
+
+        case NODE_PROCDECL: {
+            const auto* procdecl = dynamic_cast<const AstProcdecl*>(node);
+            if(procdecl->deferred_body) {
+                print("Cannot write module image: procedure at position {} still has an unparsed body.", node->pos);
+                return false;
+            }
+
+            return put_node(writer, procdecl->identifier)
+                && put_nodes(writer, procdecl->parameters)
+                && put_nodes(writer, procdecl->body);
+        }
+
+        case NODE_BINEXPR: {
+            const auto* binexpr = dynamic_cast<const AstBinexpr*>(node);
+            put<uint32_t>(writer.nodes, binexpr->_operator);
+            return put_node(writer, binexpr->left_op) && put_node(writer, binexpr->right_op);
+        }
+
+        case NODE_UNARYEXPR: {
+            const auto* unaryexpr = dynamic_cast<const AstUnaryexpr*>(node);
+            put<uint32_t>(writer.nodes, unaryexpr->_operator);
+            return put_node(writer, unaryexpr->operand);
+        }
+
+        case NODE_IDENT: {
+            put<uint32_t>(writer.nodes, dynamic_cast<const AstIdentifier*>(node)->symbol_index);
+            return true;
+        }
+
+        case NODE_BRANCH: {
+            const auto* branch = dynamic_cast<const AstBranch*>(node);
+            return put_nodes(writer, branch->conditions) && put_node(writer, branch->_else.value_or(nullptr));
+        }
+
+        case NODE_IF: {
+            const auto* _if = dynamic_cast<const AstIf*>(node);
+            return put_node(writer, _if->condition) && put_nodes(writer, _if->body);
+        }
+
+        case NODE_ELSE:    return put_nodes(writer, dynamic_cast<const AstElse*>(node)->body);
+        case NODE_DEFAULT: return put_nodes(writer, dynamic_cast<const AstDefault*>(node)->body);
+        case NODE_BLOCK:   return put_nodes(writer, dynamic_cast<const AstBlock*>(node)->children);
+
+        case NODE_FOR: {
+            const auto* _for = dynamic_cast<const AstFor*>(node);
+            return put_nodes(writer, _for->body)
+                && put_optional_node(writer, _for->init)
+                && put_optional_node(writer, _for->condition)
+                && put_optional_node(writer, _for->update);
+        }
+
+        case NODE_SWITCH: {
+            const auto* _switch = dynamic_cast<const AstSwitch*>(node);
+            return put_node(writer, _switch->target)
+                && put_node(writer, _switch->_default)
+                && put_nodes(writer, _switch->cases);
+        }
+
+        case NODE_CASE: {
+            const auto* _case = dynamic_cast<const AstCase*>(node);
+            put<uint8_t>(writer.nodes, _case->fallthrough);
+            return put_node(writer, _case->value) && put_nodes(writer, _case->body);
+        }
+
+        case NODE_WHILE: {
+            const auto* _while = dynamic_cast<const AstWhile*>(node);
+            return put_node(writer, _while->condition) && put_nodes(writer, _while->body);
+        }
+
+        case NODE_DOWHILE: {
+            const auto* dowhile = dynamic_cast<const AstDoWhile*>(node);
+            return put_node(writer, dowhile->condition) && put_nodes(writer, dowhile->body);
+        }
+
+        case NODE_CALL: {
+            const auto* call = dynamic_cast<const AstCall*>(node);
+            return put_node(writer, call->target) && put_nodes(writer, call->arguments);
+        }
+
+        case NODE_BRK:
+        case NODE_CONT:
+            return true;
+
+        case NODE_RET:
+            return put_optional_node(writer, dynamic_cast<const AstRet*>(node)->value);
+
+        case NODE_DEFER:
+            return put_node(writer, dynamic_cast<const AstDefer*>(node)->call);
+
+        case NODE_DEFER_IF: {
+            const auto* defer_if = dynamic_cast<const AstDeferIf*>(node);
+            return put_node(writer, defer_if->call) && put_node(writer, defer_if->condition);
+        }
+
+        case NODE_SIZEOF: {
+            const auto* _sizeof = dynamic_cast<const AstSizeof*>(node);
+            if(const auto* type = std::get_if<TypeData>(&_sizeof->target)) {
+                put<uint8_t>(writer.nodes, 0);
+                put_type_data(writer, writer.nodes, *type);
+                return true;
+            }
+
+            put<uint8_t>(writer.nodes, 1);
+            return put_node(writer, std::get<AstNode*>(_sizeof->target));
+        }
+
+        case NODE_SINGLETON_LITERAL: {
+            const auto* literal = dynamic_cast<const AstSingletonLiteral*>(node);
+            put<uint32_t>(writer.nodes, literal->literal_type);
+            put_string(writer, writer.nodes, literal->value);
+            return true;
+        }
+
+        case NODE_BRACED_EXPRESSION:
+            return put_nodes(writer, dynamic_cast<const AstBracedExpression*>(node)->members);
+
+        case NODE_STRUCT_DEFINITION:
+            put_string(writer, writer.nodes, dynamic_cast<const AstStructdef*>(node)->name);
+            return true;
+
+        case NODE_TYPE_ALIAS:
+            put_string(writer, writer.nodes, dynamic_cast<const AstTypeAlias*>(node)->name);
+            return true;
+
+        case NODE_ENUM_DEFINITION: {
+            const auto* enumdef = dynamic_cast<const AstEnumdef*>(node);
+            return put_node(writer, enumdef->_namespace) && put_node(writer, enumdef->alias);
+        }
+
+        case NODE_SUBSCRIPT: {
+            const auto* subscript = dynamic_cast<const AstSubscript*>(node);
+            return put_node(writer, subscript->operand) && put_node(writer, subscript->value);
+        }
+
+        case NODE_NAMESPACEDECL: {
+            const auto* _namespace = dynamic_cast<const AstNamespaceDecl*>(node);
+            put_string(writer, writer.nodes, _namespace->full_path);
+            return put_nodes(writer, _namespace->children);
+        }
+
+        case NODE_COMPOSEDECL: {
+            const auto* compose = dynamic_cast<const AstComposeDecl*>(node);
+            put_string(writer, writer.nodes, compose->type_name);
+            return put_nodes(writer, compose->children);
+        }
+
+        case NODE_CAST: {
+            const auto* cast = dynamic_cast<const AstCast*>(node);
+            put_type_data(writer, writer.nodes, cast->type);
+            return put_node(writer, cast->target);
+        }
+
+        case NODE_MEMBER_ACCESS: {
+            const auto* member_access = dynamic_cast<const AstMemberAccess*>(node);
+            put_string(writer, writer.nodes, member_access->path);
+            return put_node(writer, member_access->target);
+        }
+
+        default:
+            print("Cannot write module image: unknown node type {}.", static_cast<uint16_t>(node->type));
+            return false;
+    }
+}
+
+
+//
+// Tables. The parser stores these in unordered maps, so they get sorted first
+// to keep the image deterministic.
+//
+
+static void
+put_tables(ImageWriter& writer, tak::Parser& parser, tak::ImageHeader& header) {
+
+    std::vector<const tak::Symbol*> symbols;
+    symbols.reserve(parser.sym_table_.size());
+    for(const auto& [_, sym] : parser.sym_table_) {
+        symbols.emplace_back(&sym);
+    }
+
+    std::ranges::sort(symbols, {}, &tak::Symbol::symbol_index);
+    for(const auto* sym : symbols) {
+        put<uint32_t>(writer.symbols, sym->symbol_index);
+        put<uint32_t>(writer.symbols, sym->flags);
+        put<uint32_t>(writer.symbols, sym->line_number);
+        put<uint64_t>(writer.symbols, sym->src_pos);
+        put_string(writer, writer.symbols, sym->name);
+        put_type_data(writer, writer.symbols, sym->type);
+        put<uint16_t>(writer.symbols, sym->constant.type);
+        put<uint64_t>(writer.symbols, sym->constant.bits);
+    }
+
+    std::vector<std::pair<const std::string*, const tak::UserType*>> types;
+    types.reserve(parser.type_table_.size());
+    for(const auto& [name, type] : parser.type_table_) {
+        types.emplace_back(&name, &type);
+    }
+
+    std::ranges::sort(types, [](const auto& lhs, const auto& rhs) { return *lhs.first < *rhs.first; });
+    for(const auto& [name, type] : types) {
+        put_string(writer, writer.types, *name);
+        put<uint8_t>(writer.types, type->is_placeholder);
+        put<uint8_t>(writer.types, type->is_packed);
+        put<uint32_t>(writer.types, type->alignment);
+        put<uint64_t>(writer.types, type->pos_first_used);
+        put<uint32_t>(writer.types, type->line_first_used);
+        put<uint32_t>(writer.types, static_cast<uint32_t>(type->members.size()));
+        for(const auto& member : type->members) {
+            put_string(writer, writer.types, member.name);
+            put_type_data(writer, writer.types, member.type);
+        }
+    }
+
+    std::vector<std::pair<const std::string*, const tak::TypeData*>> aliases;
+    aliases.reserve(parser.type_aliases_.size());
+    for(const auto& [name, type] : parser.type_aliases_) {
+        aliases.emplace_back(&name, &type);
+    }
+
+    std::ranges::sort(aliases, [](const auto& lhs, const auto& rhs) { return *lhs.first < *rhs.first; });
+    for(const auto& [name, type] : aliases) {
+        put_string(writer, writer.aliases, *name);
+        put_type_data(writer, writer.aliases, *type);
+    }
+
+    std::vector<std::pair<std::string, uint32_t>> globals;
+    if(!parser.scope_stack_.empty()) {
+        header.flags |= tak::IMAGE_HAS_GLOBAL_SCOPE;
+        globals.assign(parser.scope_stack_.front().begin(), parser.scope_stack_.front().end());
+        std::ranges::sort(globals);
+    }
+
+    for(const auto& [name, index] : globals) {
+        put_string(writer, writer.globals, name);
+        put<uint32_t>(writer.globals, index);
+    }
+
+    for(const auto& type : parser.node_types_) {
+        put_type_data(writer, writer.node_types, type);
+    }
+
+    for(const auto& value : parser.node_constants_) {
+        put<uint16_t>(writer.node_constants, value.type);
+        put<uint64_t>(writer.node_constants, value.bits);
+    }
+
+    header.symbols.count        = static_cast<uint32_t>(symbols.size());
+    header.types.count          = static_cast<uint32_t>(types.size());
+    header.aliases.count        = static_cast<uint32_t>(aliases.size());
+    header.globals.count        = static_cast<uint32_t>(globals.size());
+    header.node_types.count     = static_cast<uint32_t>(parser.node_types_.size());
+    header.node_constants.count = static_cast<uint32_t>(parser.node_constants_.size());
+}
+
+
+uint64_t
+tak::hash_source(const std::string_view source) {
+
+    uint64_t hash = 0xCBF29CE484222325ULL; // FNV-1a
+    for(const char c : source) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+std::string
+tak::get_image_path(const std::string& source_file_name) {
+    return source_file_name + TAK_IMAGE_EXTENSION;
+}
+
+bool
+tak::write_image(Parser& parser, const uint64_t source_hash, std::vector<uint8_t>& out) {
+
+    ImageWriter writer;
+    ImageHeader header;
+
+    header.source_hash    = source_hash;
+    header.curr_sym_index = parser.curr_sym_index_;
+
+    for(const auto* decl : parser.toplevel_decls_) {
+        put<uint64_t>(writer.toplevel, writer.nodes.size());
+        if(!put_node(writer, decl)) {
+            return false;
+        }
+    }
+
+    header.toplevel.count = static_cast<uint32_t>(parser.toplevel_decls_.size());
+    put_tables(writer, parser, header);
+
+
+    //
+    // Lay the sections out one after another, directly behind the header.
+    //
+
+    uint64_t offset = sizeof(ImageHeader);
+    const auto place = [&](ImageSection& section, const std::vector<uint8_t>& bytes) {
+        section.offset = offset;
+        section.size   = bytes.size();
+        offset        += bytes.size();
+    };
+
+    place(header.strings,        writer.strings);
+    place(header.nodes,          writer.nodes);
+    place(header.toplevel,       writer.toplevel);
+    place(header.symbols,        writer.symbols);
+    place(header.types,          writer.types);
+    place(header.aliases,        writer.aliases);
+    place(header.globals,        writer.globals);
+    place(header.node_types,     writer.node_types);
+    place(header.node_constants, writer.node_constants);
+
+    out.clear();
+    out.reserve(offset);
+    put(out, header);
+
+    for(const auto* bytes : { &writer.strings, &writer.nodes, &writer.toplevel, &writer.symbols,
+                              &writer.types, &writer.aliases, &writer.globals, &writer.node_types, &writer.node_constants }) {
+        out.insert(out.end(), bytes->begin(), bytes->end());
+    }
+
+    return true;
+}
+
+bool
+tak::write_image_file(Parser& parser, const uint64_t source_hash, const std::string& image_path) {
+
+    std::vector<uint8_t> image;
+    if(!write_image(parser, source_hash, image)) {
+        return false;
+    }
+
+    std::ofstream output(image_path, std::ios::binary | std::ios::trunc);
+    if(!output.is_open()) {
+        print("Could not open module image \"{}\" for writing.", image_path);
+        return false;
+    }
+
+    if(!output.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()))) {
+        print("Failed to write module image \"{}\".", image_path);
+        return false;
+    }
+
+    return true;
+}
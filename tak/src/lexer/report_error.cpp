@@ -4,10 +4,25 @@
 
 #include <lexer.hpp>
 
+static thread_local std::vector<tak::LexerError>* captured_errors = nullptr;
+
+
+void
+tak::capture_lexer_errors(std::vector<LexerError>* errors) {
+    captured_errors = errors;
+}
 
 void
 tak::Lexer::_raise_error_impl(const std::string& message, size_t file_position, const uint32_t line) {
 
+    if(captured_errors != nullptr) {
+        auto& error    = captured_errors->emplace_back();
+        error.message  = message;
+        error.position = std::min(file_position, src_.size());
+        error.line     = line;
+        return;
+    }
+
     size_t line_start = file_position;
     size_t line_end   = file_position;
 
@@ -0,0 +1,282 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <lsp.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+using namespace tak;
+
+
+//
+// Positions. LSP counts characters in UTF-16 code units, so anything
+// outside the BMP (a 4 byte UTF-8 sequence) counts as two.
+//
+
+static size_t
+utf8_sequence_length(const char lead) {
+    const auto c = static_cast<uint8_t>(lead);
+    if(c < 0x80)         return 1;
+    if((c & 0xE0) == 0xC0) return 2;
+    if((c & 0xF0) == 0xE0) return 3;
+    if((c & 0xF8) == 0xF0) return 4;
+    return 1;
+}
+
+static void
+compute_line_starts(LspDocument& doc) {
+
+    doc.line_starts.clear();
+    doc.line_starts.emplace_back(0);
+
+    const char* begin = doc.text.data();
+    const char* end   = begin + doc.text.size();
+    for(const char* at = begin; (at = static_cast<const char*>(std::memchr(at, '\n', end - at))) != nullptr; ++at) {
+        doc.line_starts.emplace_back(static_cast<size_t>(at - begin) + 1);
+    }
+}
+
+size_t
+tak::lsp_offset(const LspDocument& doc, const JsonValue& position) {
+
+    const int64_t line      = position["line"].as_integer(-1);
+    const int64_t character = position["character"].as_integer(0);
+
+    if(line < 0) {
+        return 0;
+    }
+
+    if(static_cast<size_t>(line) >= doc.line_starts.size()) {
+        return doc.text.size();
+    }
+
+    size_t  offset = doc.line_starts[line];
+    int64_t units  = 0;
+
+    while(offset < doc.text.size() && doc.text[offset] != '\n' && units < character) {
+        const size_t length = utf8_sequence_length(doc.text[offset]);
+        units  += length == 4 ? 2 : 1;
+        offset += length;
+    }
+
+    return std::min(offset, doc.text.size());
+}
+
+std::string
+tak::lsp_position(const LspDocument& doc, size_t offset) {
+
+    offset = std::min(offset, doc.text.size());
+
+    const auto   found = std::upper_bound(doc.line_starts.begin(), doc.line_starts.end(), offset);
+    const size_t line  = static_cast<size_t>(found - doc.line_starts.begin()) - 1;
+    size_t       units = 0;
+
+    for(size_t i = doc.line_starts[line]; i < offset;) {
+        const size_t length = utf8_sequence_length(doc.text[i]);
+        units += length == 4 ? 2 : 1;
+        i     += length;
+    }
+
+    return fmt("{{\"line\":{},\"character\":{}}}", line, units);
+}
+
+std::string
+tak::lsp_range(const LspDocument& doc, const size_t begin, const size_t end) {
+    return fmt("{{\"start\":{},\"end\":{}}}", lsp_position(doc, begin), lsp_position(doc, std::max(begin, end)));
+}
+
+
+//
+// Text
+//
+
+void
+tak::set_document_text(LspDocument& doc, std::string&& text) {
+    doc.text = std::move(text);
+    compute_line_starts(doc);
+}
+
+bool
+tak::apply_document_change(LspDocument& doc, const JsonValue& change) {
+
+    if(change["text"].kind != JSON_STRING) {
+        return false;
+    }
+
+    if(!change.has("range")) {
+        set_document_text(doc, std::string(change["text"].string));
+        return true;
+    }
+
+    const size_t begin = lsp_offset(doc, change["range"]["start"]);
+    const size_t end   = std::max(begin, lsp_offset(doc, change["range"]["end"]));
+
+    doc.text.replace(begin, end - begin, change["text"].string);
+    compute_line_starts(doc);
+    return true;
+}
+
+
+//
+// Analysis
+//
+
+SourceEdit
+tak::diff_source(const std::string_view before, const std::string_view after) {
+
+    const size_t limit  = std::min(before.size(), after.size());
+    const size_t prefix = static_cast<size_t>(std::mismatch(before.begin(), before.begin() + limit, after.begin()).first - before.begin());
+    size_t       suffix = 0;
+
+    while(suffix < limit - prefix && before[before.size() - 1 - suffix] == after[after.size() - 1 - suffix]) {
+        ++suffix;
+    }
+
+    SourceEdit edit;
+    edit.begin   = prefix;
+    edit.old_end = before.size() - suffix;
+    edit.new_end = after.size() - suffix;
+    return edit;
+}
+
+static size_t
+token_end(const std::string_view text, const size_t pos) {
+
+    size_t end = pos;
+    while(end < text.size() && (std::isalnum(static_cast<uint8_t>(text[end])) || text[end] == '_')) {
+        ++end;
+    }
+
+    if(end == pos && pos < text.size() && text[pos] != '\n') {
+        ++end;
+    }
+
+    return end;
+}
+
+static bool
+parses_around_edit(const LspDocument& doc, const SourceEdit& edit, std::vector<LexerError>& errors) {
+
+    //
+    // Parses everything from the last declaration that begins before the edit up to
+    // the first one that begins after it. Unknown names just become placeholders here.
+    //
+
+    const auto& records   = doc.unit.records_;
+    const auto  pos_delta = static_cast<int64_t>(edit.new_end) - static_cast<int64_t>(edit.old_end);
+
+    const auto first = std::upper_bound(records.begin(), records.end(), edit.begin, [](const size_t pos, const DeclRecord& record) {
+        return pos < record.begin;
+    });
+
+    const auto last = std::lower_bound(records.begin(), records.end(), edit.old_end, [](const DeclRecord& record, const size_t pos) {
+        return record.begin < pos;
+    });
+
+    const size_t end = last == records.end()
+        ? doc.text.size()
+        : static_cast<size_t>(static_cast<int64_t>(last->begin) + pos_delta);
+
+    Lexer  lexer;
+    Parser parser;
+
+    lexer.src_.assign(doc.text.begin(), doc.text.end());
+    lexer.source_file_name_ = doc.path;
+    if(first != records.begin()) {
+        lexer.src_index_ = std::prev(first)->begin;
+        lexer.curr_line_ = std::prev(first)->line;
+    }
+
+    parser.push_scope();
+
+    const size_t errors_before = errors.size();
+    while(lexer.current() != TOKEN_END_OF_FILE && lexer.current().src_pos < end) {
+        AstNode* decl = parse_expression(parser, lexer, false);
+        if(decl == nullptr) {
+            if(errors.size() == errors_before) {
+                auto& error    = errors.emplace_back();
+                error.message  = "Failed to parse this declaration.";
+                error.position = lexer.current().src_pos;
+                error.line     = lexer.current().line;
+            }
+            break;
+        }
+
+        parser.toplevel_decls_.emplace_back(decl);
+    }
+
+    return errors.size() == errors_before;
+}
+
+static void
+append_diagnostic(std::string& out, const LspDocument& doc, const size_t pos, const uint32_t severity, const std::string_view code, const std::string& message) {
+    if(out.back() != '[') out += ',';
+    out += fmt("{{\"range\":{},\"severity\":{},\"source\":\"tak\"", lsp_range(doc, pos, token_end(doc.text, pos)), severity);
+    if(!code.empty()) {
+        out += ",\"code\":";
+        append_json_string(out, code);
+    }
+
+    out += ",\"message\":";
+    append_json_string(out, message);
+    out += '}';
+}
+
+std::string
+tak::analyze_document(LspDocument& doc) {
+
+    std::vector<LexerError> errors;
+    std::ostringstream      discarded;
+    std::ostream*           previous = &output_stream();
+    bool                    built    = true;
+
+    redirect_output(&discarded);
+    capture_lexer_errors(&errors);
+
+    const bool incremental = !doc.built_text.empty() && !doc.unit.records_.empty();
+    SourceEdit edit;
+
+    if(incremental) {
+        edit  = diff_source(doc.built_text, doc.text);
+        built = parses_around_edit(doc, edit, errors);
+    }
+
+    if(built) {
+        Lexer lexer;
+        lexer.src_.assign(doc.text.begin(), doc.text.end());
+        lexer.source_file_name_ = doc.path;
+
+        incremental_build(doc.unit, lexer, incremental ? &edit : nullptr);
+        doc.built_text = doc.unit.records_.empty() ? std::string() : doc.text;
+    }
+
+    capture_lexer_errors(nullptr);
+    redirect_output(previous);
+
+
+    //
+    // Syntax errors only while the edit doesn't parse, everything from the build otherwise.
+    //
+
+    std::string out = "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":";
+    append_json_string(out, doc.uri);
+    out += fmt(",\"version\":{},\"diagnostics\":[", doc.version);
+
+    for(const auto& error : errors) {
+        append_diagnostic(out, doc, error.position, 1, "", error.message);
+    }
+
+    if(built) {
+        for(const auto& diag : doc.unit.diagnostics_) {
+            const auto& info = get_diag_info(diag.code);
+            append_diagnostic(out, doc, diag.position, info.severity == DIAG_SEVERITY_ERROR ? 1 : 2, info.name, format_diagnostic(diag, doc.unit.parser_));
+        }
+    }
+
+    out += "]}}";
+    return out;
+}
@@ -0,0 +1,128 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <io.hpp>
+#include <lsp.hpp>
+
+#ifdef TAK_WINDOWS
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+
+//
+// tak-lsp: a language server over stdin and stdout.
+// stdout carries the protocol, so nothing else may ever be printed to it.
+//
+
+static bool
+read_message(std::string& payload) {
+
+    size_t      length = 0;
+    bool        found  = false;
+    std::string line;
+
+    while(true) {
+        line.clear();
+
+        int c = 0;
+        while((c = std::fgetc(stdin)) != EOF && c != '\n') {
+            line += static_cast<char>(c);
+        }
+
+        if(c == EOF) {
+            return false;
+        }
+
+        if(!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        if(line.empty()) {
+            break;
+        }
+
+        if(line.starts_with("Content-Length:")) {
+            length = std::strtoull(line.c_str() + 15, nullptr, 10);
+            found  = true;
+        }
+    }
+
+    if(!found) {
+        payload.clear();
+        return true;
+    }
+
+    payload.resize(length);
+    return std::fread(payload.data(), 1, length, stdin) == length;
+}
+
+static void
+write_message(const std::string& payload) {
+    const std::string frame = tak::lsp_frame(payload);
+    std::fwrite(frame.data(), 1, frame.size(), stdout);
+    std::fflush(stdout);
+}
+
+
+int main(const int argc, char** argv) {
+
+#ifdef TAK_WINDOWS
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    std::ofstream record;
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if(arg == "--record" && i + 1 < argc) {
+            record.open(argv[++i], std::ios::binary | std::ios::trunc);
+        } else if(arg == "--stdio") {
+            // What most editors pass, stdio is the only transport anyway.
+        } else {
+            std::fprintf(stderr, "Usage: tak-lsp [--stdio] [--record <session.jsonl>]\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    //
+    // Whatever the compiler prints goes nowhere, diagnostics are sent as messages instead.
+    //
+
+    std::ostringstream discarded;
+    tak::redirect_output(&discarded);
+
+    tak::LspServer           server;
+    std::string              payload;
+    std::vector<std::string> replies;
+
+    while(!server.exited() && read_message(payload)) {
+        if(payload.empty()) {
+            continue;
+        }
+
+        if(record.is_open()) {
+            std::string line = payload;
+            for(char& c : line) {
+                if(c == '\r' || c == '\n') c = ' ';
+            }
+
+            record << line << '\n';
+            record.flush();
+        }
+
+        replies.clear();
+        server.handle(payload, replies);
+        for(const auto& reply : replies) {
+            write_message(reply);
+        }
+
+        discarded.str(std::string());
+    }
+
+    tak::redirect_output(nullptr);
+    return server.exit_code();
+}
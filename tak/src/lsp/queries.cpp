@@ -0,0 +1,372 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <lsp.hpp>
+#include <support.hpp>
+#include <algorithm>
+
+using namespace tak;
+
+
+//
+// Queries are answered from the last build. While the editor's text has an edit the
+// build doesn't know about yet (it didn't parse), positions have to be moved across it.
+//
+
+struct BuildMapping {
+    SourceEdit edit;
+    bool       identical = true;
+
+    std::optional<size_t> to_built(const size_t offset) const {
+        if(identical || offset < edit.begin) return offset;
+        if(offset >= edit.new_end)           return offset - edit.new_end + edit.old_end;
+        return std::nullopt;
+    }
+
+    size_t to_text(const size_t offset) const {
+        if(identical || offset < edit.begin) return offset;
+        if(offset >= edit.old_end)           return offset - edit.old_end + edit.new_end;
+        return edit.begin;
+    }
+};
+
+static BuildMapping
+build_mapping(const LspDocument& doc) {
+    BuildMapping mapping;
+    if(doc.built_text != doc.text) {
+        mapping.identical = false;
+        mapping.edit      = diff_source(doc.built_text, doc.text);
+    }
+
+    return mapping;
+}
+
+static bool
+is_name_char(const char c) {
+    return std::isalnum(static_cast<uint8_t>(c)) || c == '_' || c == '\\';
+}
+
+static std::pair<size_t, size_t>
+word_at(const std::string_view text, const size_t offset) {
+    size_t begin = std::min(offset, text.size());
+    size_t end   = begin;
+
+    while(begin > 0 && is_name_char(text[begin - 1])) --begin;
+    while(end < text.size() && is_name_char(text[end])) ++end;
+    return { begin, end };
+}
+
+static std::string
+unqualified(const std::string& name) {
+    const size_t pos = name.find_last_of('\\');
+    return pos == std::string::npos ? name : name.substr(pos + 1);
+}
+
+static AstNode*
+decl_containing(const IncrementalUnit& unit, const size_t offset) {
+
+    const auto& records = unit.records_;
+    const auto  found   = std::upper_bound(records.begin(), records.end(), offset, [](const size_t pos, const DeclRecord& record) {
+        return pos < record.begin;
+    });
+
+    if(found == records.begin()) {
+        return nullptr;
+    }
+
+    return unit.parser_.toplevel_decls_[static_cast<size_t>(found - records.begin()) - 1];
+}
+
+static AstNode*
+node_at(const IncrementalUnit& unit, const std::string_view text, const size_t offset) {
+
+    //
+    // Prefer an identifier that starts within the word under the cursor,
+    // otherwise take the innermost typed expression that starts there.
+    //
+
+    AstNode* decl = decl_containing(unit, offset);
+    if(decl == nullptr) {
+        return nullptr;
+    }
+
+    const auto [begin, end] = word_at(text, offset);
+    AstNode*    ident       = nullptr;
+    AstNode*    typed       = nullptr;
+
+    walk_ast(decl, [&](AstNode* node) {
+        if(node->pos < begin || node->pos >= std::max(end, begin + 1)) {
+            return;
+        }
+
+        if(node->type == NODE_IDENT) {
+            ident = node;
+        } else if(node->type_id != INVALID_TYPE_ID) {
+            typed = node;
+        }
+    });
+
+    return ident != nullptr ? ident : typed;
+}
+
+
+//
+// Hover and go to definition
+//
+
+std::string
+tak::hover_json(LspDocument& doc, const JsonValue& position) {
+
+    const BuildMapping mapping = build_mapping(doc);
+    const auto         offset  = mapping.to_built(lsp_offset(doc, position));
+
+    if(!offset) {
+        return "null";
+    }
+
+    auto&    parser = doc.unit.parser_;
+    AstNode* node   = node_at(doc.unit, doc.built_text, *offset);
+
+    if(node == nullptr) {
+        return "null";
+    }
+
+    std::string contents;
+    if(const auto* ident = dynamic_cast<AstIdentifier*>(node)) {
+        const auto* sym = parser.lookup_unique_symbol(ident->symbol_index);
+        if(sym == nullptr) {
+            return "null";
+        }
+
+        const std::string_view name = std::string_view(sym->name).starts_with('\\')
+            ? std::string_view(sym->name).substr(1)
+            : std::string_view(sym->name);
+
+        if(sym->flags & SYM_PLACEHOLDER) {
+            contents = fmt("```tak\n{}\n```\nunresolved", name);
+        } else {
+            contents = fmt("```tak\n{} : {}\n```", name, typedata_to_str_msg(sym->type));
+        }
+
+        const auto* expr_type = parser.lookup_node_type(node);
+        if(expr_type != nullptr && typedata_to_str_msg(*expr_type) != typedata_to_str_msg(sym->type)) {
+            contents += fmt("\nexpression type: `{}`", typedata_to_str_msg(*expr_type));
+        }
+    }
+    else if(const auto* expr_type = parser.lookup_node_type(node)) {
+        contents = fmt("```tak\n{}\n```", typedata_to_str_msg(*expr_type));
+    }
+    else {
+        return "null";
+    }
+
+    const auto [begin, end] = word_at(doc.built_text, *offset);
+    std::string out = "{\"contents\":{\"kind\":\"markdown\",\"value\":";
+
+    append_json_string(out, contents);
+    out += fmt("}},\"range\":{}}}", lsp_range(doc, mapping.to_text(begin), mapping.to_text(end)));
+    return out;
+}
+
+std::string
+tak::definition_json(LspDocument& doc, const JsonValue& position) {
+
+    const BuildMapping mapping = build_mapping(doc);
+    const auto         offset  = mapping.to_built(lsp_offset(doc, position));
+
+    if(!offset) {
+        return "null";
+    }
+
+    const auto* ident = dynamic_cast<AstIdentifier*>(node_at(doc.unit, doc.built_text, *offset));
+    if(ident == nullptr) {
+        return "null";
+    }
+
+    const auto* sym = doc.unit.parser_.lookup_unique_symbol(ident->symbol_index);
+    if(sym == nullptr || sym->flags & SYM_PLACEHOLDER) {
+        return "null";
+    }
+
+    const size_t begin = mapping.to_text(sym->src_pos);
+    std::string  out   = "{\"uri\":";
+
+    append_json_string(out, doc.uri);
+    out += fmt(",\"range\":{}}}", lsp_range(doc, begin, begin + unqualified(sym->name).size()));
+    return out;
+}
+
+
+//
+// Document symbols
+//
+
+enum lsp_symbol_kind_t : uint8_t {
+    LSP_SYMBOL_NAMESPACE      = 3,
+    LSP_SYMBOL_CLASS          = 5,
+    LSP_SYMBOL_METHOD         = 6,
+    LSP_SYMBOL_ENUM           = 10,
+    LSP_SYMBOL_FUNCTION       = 12,
+    LSP_SYMBOL_VARIABLE       = 13,
+    LSP_SYMBOL_STRUCT         = 23,
+    LSP_SYMBOL_ENUM_MEMBER    = 22,
+    LSP_SYMBOL_TYPE_PARAMETER = 26,
+};
+
+static size_t
+find_name(const std::string_view text, const std::string& name, const size_t begin, const size_t end) {
+    const size_t found = text.substr(0, end).find(name, begin);
+    return found == std::string_view::npos ? begin : found;
+}
+
+static void
+append_document_symbols(
+    std::string& out,
+    LspDocument& doc,
+    const BuildMapping& mapping,
+    AstNode* node,
+    const size_t begin,
+    const size_t end,
+    const bool in_compose
+) {
+    auto& parser = doc.unit.parser_;
+
+    std::string       name;
+    std::string       detail;
+    lsp_symbol_kind_t kind = LSP_SYMBOL_VARIABLE;
+    size_t            name_pos = begin;
+
+    std::vector<AstNode*> children;
+
+    const auto symbol_of = [&](const AstIdentifier* ident) -> const Symbol* {
+        return ident != nullptr ? parser.lookup_unique_symbol(ident->symbol_index) : nullptr;
+    };
+
+    if(const auto* proc = dynamic_cast<AstProcdecl*>(node)) {
+        const auto* sym = symbol_of(proc->identifier);
+        if(sym == nullptr) return;
+        name     = unqualified(sym->name);
+        detail   = typedata_to_str_msg(sym->type);
+        name_pos = sym->src_pos;
+        kind     = in_compose ? LSP_SYMBOL_METHOD : LSP_SYMBOL_FUNCTION;
+    }
+    else if(const auto* var = dynamic_cast<AstVardecl*>(node)) {
+        const auto* sym = symbol_of(var->identifier);
+        if(sym == nullptr) return;
+        name     = unqualified(sym->name);
+        detail   = typedata_to_str_msg(sym->type);
+        name_pos = sym->src_pos;
+        kind     = LSP_SYMBOL_VARIABLE;
+    }
+    else if(const auto* structdef = dynamic_cast<AstStructdef*>(node)) {
+        name = unqualified(structdef->name);
+        kind = LSP_SYMBOL_STRUCT;
+    }
+    else if(const auto* alias = dynamic_cast<AstTypeAlias*>(node)) {
+        name = unqualified(alias->name);
+        kind = LSP_SYMBOL_TYPE_PARAMETER;
+    }
+    else if(const auto* nmspace = dynamic_cast<AstNamespaceDecl*>(node)) {
+        name     = unqualified(nmspace->full_path);
+        kind     = LSP_SYMBOL_NAMESPACE;
+        children = nmspace->children;
+    }
+    else if(const auto* compose = dynamic_cast<AstComposeDecl*>(node)) {
+        name     = unqualified(compose->type_name);
+        kind     = LSP_SYMBOL_CLASS;
+        children = compose->children;
+    }
+    else if(const auto* enumdef = dynamic_cast<AstEnumdef*>(node)) {
+        if(enumdef->alias == nullptr || enumdef->_namespace == nullptr) return;
+        name     = unqualified(enumdef->alias->name);
+        kind     = LSP_SYMBOL_ENUM;
+        children = enumdef->_namespace->children;
+    }
+    else {
+        return;
+    }
+
+    if(name_pos < begin || name_pos >= end) {
+        name_pos = find_name(doc.built_text, name, begin, end);
+    }
+
+    if(out.back() != '[') out += ',';
+    out += "{\"name\":";
+    append_json_string(out, name.empty() ? std::string("<anonymous>") : name);
+
+    if(!detail.empty()) {
+        out += ",\"detail\":";
+        append_json_string(out, detail);
+    }
+
+    out += fmt(",\"kind\":{},\"range\":{},\"selectionRange\":{}",
+        static_cast<uint32_t>(kind),
+        lsp_range(doc, mapping.to_text(begin), mapping.to_text(end)),
+        lsp_range(doc, mapping.to_text(name_pos), mapping.to_text(std::min(name_pos + name.size(), end)))
+    );
+
+    //
+    // Children only know where they begin, so each one runs up to the next.
+    //
+
+    if(!children.empty()) {
+        out += ",\"children\":[";
+        for(size_t i = 0; i < children.size(); ++i) {
+            const size_t child_begin = std::clamp(children[i]->pos, begin, end);
+            size_t       child_end   = i + 1 < children.size() ? std::clamp(children[i + 1]->pos, child_begin, end) : end;
+
+            if(i + 1 == children.size() && child_end > child_begin && doc.built_text[child_end - 1] == '}') {
+                --child_end;
+            }
+
+            while(child_end > child_begin && std::isspace(static_cast<uint8_t>(doc.built_text[child_end - 1]))) {
+                --child_end;
+            }
+
+            const auto* member = dynamic_cast<AstVardecl*>(children[i]);
+            if(kind != LSP_SYMBOL_ENUM) {
+                append_document_symbols(out, doc, mapping, children[i], child_begin, child_end, kind == LSP_SYMBOL_CLASS);
+                continue;
+            }
+
+            const auto* sym = member != nullptr ? symbol_of(member->identifier) : nullptr;
+            if(sym == nullptr) {
+                continue;
+            }
+
+            const auto   member_name = unqualified(sym->name);
+            const size_t pos         = std::clamp(sym->src_pos, begin, end);
+            const auto   range       = lsp_range(doc, mapping.to_text(pos), mapping.to_text(std::min(pos + member_name.size(), end)));
+
+            if(out.back() != '[') out += ',';
+            out += "{\"name\":";
+            append_json_string(out, member_name);
+            out += fmt(",\"kind\":{},\"range\":{},\"selectionRange\":{}}}", static_cast<uint32_t>(LSP_SYMBOL_ENUM_MEMBER), range, range);
+        }
+        out += ']';
+    }
+
+    out += '}';
+}
+
+std::string
+tak::document_symbols_json(LspDocument& doc) {
+
+    const BuildMapping mapping = build_mapping(doc);
+    const auto&        records = doc.unit.records_;
+    const auto&        decls   = doc.unit.parser_.toplevel_decls_;
+
+    std::string out = "[";
+    for(size_t i = 0; i < records.size() && i < decls.size(); ++i) {
+        size_t end = i + 1 < records.size() ? records[i + 1].begin : doc.built_text.size();
+        while(end > records[i].begin && std::isspace(static_cast<uint8_t>(doc.built_text[end - 1]))) {
+            --end;
+        }
+
+        append_document_symbols(out, doc, mapping, decls[i], records[i].begin, end, false);
+    }
+
+    out += ']';
+    return out;
+}
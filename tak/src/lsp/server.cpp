@@ -0,0 +1,228 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <lsp.hpp>
+#include <support.hpp>
+#include <io.hpp>
+
+using namespace tak;
+
+#define LSP_PARSE_ERROR      (-32700)
+#define LSP_INVALID_REQUEST  (-32600)
+#define LSP_METHOD_NOT_FOUND (-32601)
+
+
+static std::string
+make_response(const JsonValue& id, const std::string_view result) {
+    return fmt("{{\"jsonrpc\":\"2.0\",\"id\":{},\"result\":{}}}", json_to_string(id), result);
+}
+
+static std::string
+make_error(const JsonValue& id, const int code, const std::string_view message) {
+    std::string out = fmt("{{\"jsonrpc\":\"2.0\",\"id\":{},\"error\":{{\"code\":{},\"message\":", json_to_string(id), code);
+    append_json_string(out, message);
+    out += "}}";
+    return out;
+}
+
+std::string
+tak::lsp_frame(const std::string_view payload) {
+    return fmt("Content-Length: {}\r\n\r\n{}", payload.size(), payload);
+}
+
+std::string
+tak::uri_to_path(const std::string_view uri) {
+
+    std::string_view rest = uri;
+    if(rest.starts_with("file://")) {
+        rest.remove_prefix(7);
+    }
+
+    std::string path;
+    for(size_t i = 0; i < rest.size(); ++i) {
+        if(rest[i] == '%' && i + 2 < rest.size() && std::isxdigit(static_cast<uint8_t>(rest[i + 1])) && std::isxdigit(static_cast<uint8_t>(rest[i + 2]))) {
+            path += static_cast<char>(std::stoi(std::string(rest.substr(i + 1, 2)), nullptr, 16));
+            i    += 2;
+        } else {
+            path += rest[i];
+        }
+    }
+
+    return path;
+}
+
+std::string
+tak::path_to_uri(const std::string& path) {
+
+    static constexpr std::string_view hex = "0123456789ABCDEF";
+
+    std::string uri = "file://";
+    for(const char c : path) {
+        const auto byte = static_cast<uint8_t>(c);
+        if(std::isalnum(byte) || c == '/' || c == '-' || c == '_' || c == '.' || c == '~') {
+            uri += c;
+        } else {
+            uri += '%';
+            uri += hex[byte >> 4];
+            uri += hex[byte & 0xF];
+        }
+    }
+
+    return uri;
+}
+
+
+//
+// Documents
+//
+
+LspDocument*
+tak::LspServer::document(const JsonValue& params) {
+    const auto found = documents_.find(std::string(params["textDocument"]["uri"].as_string()));
+    return found != documents_.end() ? found->second.get() : nullptr;
+}
+
+const LspDocument*
+tak::LspServer::find_document(const std::string_view uri) const {
+    const auto found = documents_.find(std::string(uri));
+    return found != documents_.end() ? found->second.get() : nullptr;
+}
+
+void
+tak::LspServer::did_open(const JsonValue& params, std::vector<std::string>& replies) {
+
+    const auto& item = params["textDocument"];
+    if(item["uri"].kind != JSON_STRING || item["text"].kind != JSON_STRING) {
+        return;
+    }
+
+    auto& doc    = documents_[item["uri"].string];
+    doc          = std::make_unique<LspDocument>();
+    doc->uri     = item["uri"].string;
+    doc->path    = uri_to_path(doc->uri);
+    doc->version = item["version"].as_integer();
+
+    set_document_text(*doc, std::string(item["text"].string));
+    replies.emplace_back(analyze_document(*doc));
+}
+
+void
+tak::LspServer::did_change(const JsonValue& params, std::vector<std::string>& replies) {
+
+    LspDocument* doc = document(params);
+    if(doc == nullptr) {
+        return;
+    }
+
+    for(const auto& change : params["contentChanges"].elements) {
+        apply_document_change(*doc, change);
+    }
+
+    doc->version = params["textDocument"]["version"].as_integer(doc->version);
+    replies.emplace_back(analyze_document(*doc));
+}
+
+void
+tak::LspServer::did_close(const JsonValue& params, std::vector<std::string>& replies) {
+
+    const auto found = documents_.find(std::string(params["textDocument"]["uri"].as_string()));
+    if(found == documents_.end()) {
+        return;
+    }
+
+    std::string out = "{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":";
+    append_json_string(out, found->first);
+    out += ",\"diagnostics\":[]}}";
+
+    replies.emplace_back(std::move(out));
+    documents_.erase(found);
+}
+
+
+//
+// Messages
+//
+
+void
+tak::LspServer::handle(const std::string_view payload, std::vector<std::string>& replies) {
+
+    const auto message = parse_json(payload);
+    if(!message || message->kind != JSON_OBJECT) {
+        replies.emplace_back(make_error(JsonValue(), LSP_PARSE_ERROR, "Failed to parse the message."));
+        return;
+    }
+
+    dispatch(*message, replies);
+}
+
+void
+tak::LspServer::dispatch(const JsonValue& message, std::vector<std::string>& replies) {
+
+    const auto  method     = message["method"].as_string();
+    const auto& params     = message["params"];
+    const auto& id         = message["id"];
+    const bool  is_request = message.has("id");
+
+    if(method.empty()) {
+        return; // A response to something we never send.
+    }
+
+    if(method == "exit") {
+        exited_ = true;
+        return;
+    }
+
+    if(shutdown_ && is_request) {
+        replies.emplace_back(make_error(id, LSP_INVALID_REQUEST, "The server is shutting down."));
+        return;
+    }
+
+    if(method == "initialize") {
+        replies.emplace_back(make_response(id,
+            "{\"capabilities\":{"
+                "\"textDocumentSync\":{\"openClose\":true,\"change\":2},"
+                "\"hoverProvider\":true,"
+                "\"definitionProvider\":true,"
+                "\"documentSymbolProvider\":true"
+            "},\"serverInfo\":{\"name\":\"tak-lsp\"}}"
+        ));
+    }
+    else if(method == "shutdown") {
+        shutdown_ = true;
+        replies.emplace_back(make_response(id, "null"));
+    }
+    else if(method == "textDocument/didOpen")   did_open(params, replies);
+    else if(method == "textDocument/didChange") did_change(params, replies);
+    else if(method == "textDocument/didClose")  did_close(params, replies);
+    else if(method == "textDocument/hover" || method == "textDocument/definition" || method == "textDocument/documentSymbol") {
+        LspDocument* doc = document(params);
+        if(doc == nullptr) {
+            replies.emplace_back(make_response(id, "null"));
+        }
+        else if(method == "textDocument/hover") {
+            replies.emplace_back(make_response(id, hover_json(*doc, params["position"])));
+        }
+        else if(method == "textDocument/definition") {
+            replies.emplace_back(make_response(id, definition_json(*doc, params["position"])));
+        }
+        else {
+            replies.emplace_back(make_response(id, document_symbols_json(*doc)));
+        }
+    }
+    else if(is_request) {
+        replies.emplace_back(make_error(id, LSP_METHOD_NOT_FOUND, fmt("Unsupported method \"{}\".", method)));
+    }
+
+    // Anything else is a notification we don't care about (initialized, didSave, $/...).
+}
+
+bool
+tak::LspServer::exited() const {
+    return exited_;
+}
+
+int
+tak::LspServer::exit_code() const {
+    return shutdown_ ? 0 : 1;
+}
@@ -1,16 +1,20 @@
 #include <exception>
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <charconv>
+#include <thread>
 #include <io.hpp>
-
-#define CURRENT_TEST "tests/test1.txt"
-
-
-bool do_compile(const std::string& source_file_name);
+#include <driver.hpp>
+#include <trace.hpp>
+#include <server.hpp>
 
 
 void
 handle_uncaught_exception() {
 
+    tak::flush_output();
+
     const std::exception_ptr exception = std::current_exception();
     try {
         std::rethrow_exception(exception);
@@ -27,28 +31,211 @@ handle_uncaught_exception() {
 }
 
 
-int main() {
+static int
+usage_error(const std::string& message) {
+
+    tak::print<tak::TFG_RED, tak::TBG_NONE, tak::TSTYLE_BOLD>("{}", message);
+    tak::print(
+        "Usage: tak [options] <source files...>\n"
+        "       tak --server[=<socket>] | --stop-server[=<socket>]\n"
+        "\n"
+        "  -j <n>, -j<n>                 Compile n files at once.\n"
+        "  --check-threads <n>           Check procedure bodies on n threads (--parallel-check uses all of them).\n"
+        "  --lazy-bodies                 Parse procedure bodies only once they're needed.\n"
+        "  --image-cache                 Load and store a module image next to each source file.\n"
+        "  --entry <name>                Only check what the entry point can reach, can be repeated.\n"
+        "  --warn-unreachable            Warn about everything --entry skipped.\n"
+        "  --diagnostics=text|json|sarif, --diagnostics-out <path>\n"
+        "  --dump-ast, --dump-symbols, --dump-types, --dump=text|json|binary, --dump-out <path>\n"
+        "  --call-graph-dot <path>, --call-graph <path>\n"
+        "  --time-report[=text|json], --time-report-out <path>, --mem-report, --layout-report\n"
+        "  --trace=<path>, --color=auto|always|never, --connect[=<socket>]"
+    );
+
+    return EXIT_FAILURE;
+}
+
+
+static bool
+parse_count(const std::string_view text, uint32_t& count) {
+
+    //
+    // Counts passed to -j and --check-threads: a whole, positive decimal number.
+    //
+
+    uint32_t   value = 0;
+    const auto end   = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), end, value);
+
+    if(ec != std::errc{} || ptr != end || value == 0) {
+        return false;
+    }
+
+    count = value;
+    return true;
+}
+
+
+int main(const int argc, char** argv) {
 
     std::set_terminate(handle_uncaught_exception);
-    if(!do_compile(CURRENT_TEST)) {
+
+    tak::CompileOptions      options;
+    std::vector<std::string> source_file_names;
+    std::string              trace_path;
+    std::string              server_path;
+    bool                     run_server  = false;
+    bool                     stop_server = false;
+    bool                     connect     = false;
+
+    static constexpr std::string_view value_options[] = {
+        "-j", "--check-threads", "--diagnostics-out", "--entry", "--call-graph-dot", "--call-graph", "--time-report-out", "--dump-out",
+    };
+
+    for(int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if(i + 1 >= argc && std::ranges::find(value_options, arg) != std::end(value_options)) {
+            return usage_error(tak::fmt("{} needs a value.", arg));
+        }
+
+        if(arg == "--lazy-bodies") {
+            options.lazy_proc_bodies = true;
+        } else if(arg == "--image-cache") {
+            options.use_image_cache = true;
+        } else if(arg == "--mem-report") {
+            options.mem_report = true;
+        } else if(arg == "--layout-report") {
+            options.layout_report = true;
+        } else if(arg == "-j" || (arg.starts_with("-j") && arg.size() > 2)) {
+            const std::string_view count = arg.size() > 2 ? std::string_view(arg).substr(2) : std::string_view(argv[++i]);
+            if(!parse_count(count, options.jobs)) {
+                return usage_error(tak::fmt("-j expects a positive number of files, got \"{}\".", count));
+            }
+        } else if(arg == "--check-threads") {
+            const std::string_view count = argv[++i];
+            if(!parse_count(count, options.check_threads)) {
+                return usage_error(tak::fmt("--check-threads expects a positive number of threads, got \"{}\".", count));
+            }
+        } else if(arg == "--parallel-check") {
+            options.check_threads = std::max(1u, std::thread::hardware_concurrency());
+        } else if(arg == "--diagnostics=text") {
+            options.diagnostics_format = tak::DIAG_FORMAT_TEXT;
+        } else if(arg == "--diagnostics=json") {
+            options.diagnostics_format = tak::DIAG_FORMAT_JSON;
+        } else if(arg == "--diagnostics=sarif") {
+            options.diagnostics_format = tak::DIAG_FORMAT_SARIF;
+        } else if(arg == "--diagnostics-out") {
+            options.diagnostics_path = argv[++i];
+        } else if(arg == "--entry") {
+            options.entry_points.emplace_back(argv[++i]);
+        } else if(arg == "--warn-unreachable") {
+            options.warn_unreachable = true;
+        } else if(arg == "--call-graph-dot") {
+            options.call_graph_dot = argv[++i];
+        } else if(arg == "--call-graph") {
+            options.call_graph_path = argv[++i];
+        } else if(arg == "--time-report" || arg == "--time-report=text") {
+            options.time_report = true;
+        } else if(arg == "--time-report=json") {
+            options.time_report      = true;
+            options.time_report_json = true;
+        } else if(arg == "--time-report-out") {
+            options.time_report      = true;
+            options.time_report_json = true;
+            options.time_report_path = argv[++i];
+        } else if(arg == "--dump-ast") {
+            options.dumps |= tak::DUMP_AST;
+        } else if(arg == "--dump-symbols") {
+            options.dumps |= tak::DUMP_SYMBOLS;
+        } else if(arg == "--dump-types") {
+            options.dumps |= tak::DUMP_TYPES;
+        } else if(arg == "--dump=text") {
+            options.dump_format = tak::DUMP_FORMAT_TEXT;
+        } else if(arg == "--dump=json") {
+            options.dump_format = tak::DUMP_FORMAT_JSON;
+        } else if(arg == "--dump=binary") {
+            options.dump_format = tak::DUMP_FORMAT_BINARY;
+        } else if(arg == "--dump-out") {
+            options.dump_path = argv[++i];
+        } else if(arg == "--color=always") {
+            tak::set_color_mode(tak::COLOR_ALWAYS);
+        } else if(arg == "--color=never") {
+            tak::set_color_mode(tak::COLOR_NEVER);
+        } else if(arg == "--color=auto") {
+            tak::set_color_mode(tak::COLOR_AUTO);
+        } else if(arg.starts_with("--trace=") && arg.size() > 8) {
+            trace_path = arg.substr(8);
+        } else if(arg == "--server" || arg.starts_with("--server=")) {
+            run_server  = true;
+            server_path = arg.size() > 9 ? arg.substr(9) : "";
+        } else if(arg == "--stop-server" || arg.starts_with("--stop-server=")) {
+            stop_server = true;
+            server_path = arg.size() > 14 ? arg.substr(14) : "";
+        } else if(arg == "--connect" || arg.starts_with("--connect=")) {
+            connect     = true;
+            server_path = arg.size() > 10 ? arg.substr(10) : "";
+        } else if(arg.starts_with('-')) {
+            return usage_error(tak::fmt("Unknown option \"{}\".", arg));
+        } else {
+            source_file_names.emplace_back(arg);
+        }
+    }
+
+    if(server_path.empty()) {
+        server_path = tak::default_server_socket_path();
+    }
+
+    if(run_server) {
+        return tak::run_compile_server(server_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if(stop_server) {
+        return tak::stop_compile_server(server_path) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if(source_file_names.empty()) {
+        return usage_error("No input files.");
+    }
+
+    if(source_file_names.size() > 1
+        && (!options.diagnostics_path.empty() || !options.call_graph_dot.empty() || !options.call_graph_path.empty()
+            || !options.time_report_path.empty() || !options.dump_path.empty())) {
+        tak::print<tak::TFG_RED, tak::TBG_NONE, tak::TSTYLE_BOLD>("--diagnostics-out, --call-graph(-dot), --time-report-out and --dump-out take a single input file.");
         return EXIT_FAILURE;
     }
 
-    /*
-    Lexer lxr;
-    if(!lxr.init(CURRENT_TEST)) {
+    if(options.dump_format == tak::DUMP_FORMAT_BINARY && options.dump_path.empty()) {
+        tak::print<tak::TFG_RED, tak::TBG_NONE, tak::TSTYLE_BOLD>("--dump=binary needs --dump-out.");
         return EXIT_FAILURE;
     }
 
-    do {
-        lxr.advance(1);
-        lexer_display_token_data(lxr.current());
-    } while(lxr.current() != TOKEN_END_OF_FILE && lxr.current() != TOKEN_ILLEGAL);
+    //
+    // With --connect the server does the compiling. If it can't be reached the file gets compiled here as usual.
+    //
+
+    if(connect) {
+        if(!tak::server_can_compile(options) || !trace_path.empty()) {
+            tak::print<tak::TFG_RED, tak::TBG_NONE, tak::TSTYLE_BOLD>("--connect only does plain compiles, it can't be combined with reports, dumps or other output options.");
+            return EXIT_FAILURE;
+        }
+
+        if(const auto compiled = tak::compile_with_server(server_path, source_file_names)) {
+            return *compiled ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if(!trace_path.empty()) {
+        tak::start_tracing();
+    }
 
-    if(lxr.current() == TOKEN_ILLEGAL) {
-        lxr.raise_error("Illegal token!", lxr.current().src_pos);
+    const bool compiled = tak::do_compile_files(source_file_names, options);
+    if(!trace_path.empty() && !tak::write_trace(trace_path)) {
+        return EXIT_FAILURE;
+    }
+
+    if(!compiled) {
+        return EXIT_FAILURE;
     }
-    */
 
     return EXIT_SUCCESS;
 }
\ No newline at end of file
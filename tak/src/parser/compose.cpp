@@ -20,17 +20,16 @@ compose_add_type_method(tak::UserType* type, const std::string& type_name, tak::
     const auto  method_name = tak::split_string(proc->name, '\\').back();
 
     if(name != nullptr && *name == type_name && first.pointer_depth == 1 && first.array_lengths.empty()) {
-        for(const auto& member : type->members) {
-            if(member.name == method_name) {
-                lxr.raise_error(tak::fmt("Cannot create method {} because type {} already has a member of the same name.",
-                    method_name, type_name));
+        tak::MemberData method(method_name, {});
+        method.type.sym_ref = proc->symbol_index;
 
-                return false;
-            }
+        if(!type->add_member(std::move(method))) {
+            lxr.raise_error(tak::fmt("Cannot create method {} because type {} already has a member of the same name.",
+                method_name, type_name));
+
+            return false;
         }
 
-        type->members.emplace_back(tak::MemberData{ method_name, {} });
-        type->members.back().type.sym_ref = proc->symbol_index;
         proc->type.flags |= tak::TYPE_PROC_METHOD;
     }
 
@@ -159,6 +159,43 @@ tak::parse_parameterized_vardecl(Parser& parser, Lexer& lxr) {
 }
 
 
+static bool
+skip_procedure_body(tak::AstProcdecl* node, tak::Parser& parser, tak::Lexer& lxr) {
+
+    assert(node != nullptr);
+    assert(lxr.current() == tak::TOKEN_LBRACE);
+
+    //
+    // Record where the body starts, then find the matching brace
+    // without building any nodes. The body gets parsed later by tak::parse_deferred_body.
+    //
+
+    tak::DeferredBody body;
+    body.open       = lxr.current();
+    body.src_index  = lxr.src_index_;
+    body.line       = lxr.curr_line_;
+    body.namespaces = parser.namespace_stack_;
+
+    uint32_t depth = 1;
+    while(depth > 0) {
+        lxr.advance(1);
+        if(lxr.current() == tak::TOKEN_END_OF_FILE || lxr.current() == tak::TOKEN_ILLEGAL) {
+            lxr.raise_error("Unterminated procedure body.", body.open.src_pos, body.open.line);
+            return false;
+        }
+
+        if(lxr.current() == tak::TOKEN_LBRACE)      { ++depth; }
+        else if(lxr.current() == tak::TOKEN_RBRACE) { --depth; }
+    }
+
+    body.end_pos        = lxr.current().src_pos;
+    node->deferred_body = std::move(body);
+
+    lxr.advance(1);
+    return true;
+}
+
+
 tak::AstNode*
 tak::parse_procdecl(Symbol* proc, Parser& parser, Lexer& lxr) {
 
@@ -286,6 +323,15 @@ tak::parse_procdecl(Symbol* proc, Parser& parser, Lexer& lxr) {
         return nullptr;
     }
 
+    if(parser.lazy_proc_bodies_) {
+        if(!skip_procedure_body(node, parser, lxr)) {
+            return nullptr;
+        }
+
+        state = true;
+        return node;
+    }
+
     lxr.advance(1);
     while(lxr.current() != TOKEN_RBRACE) {
         auto* expr = parse_expression(parser, lxr, false);
@@ -550,6 +596,7 @@ tak::parse_decl(Parser& parser, Lexer& lxr) {
             proc_ptr              = parser.lookup_unique_symbol(replace);
             proc_ptr->type.kind   = TYPE_KIND_PROCEDURE;
             proc_ptr->type.flags  = typeflags;
+            proc_ptr->type.name   = std::monostate(); // same as create_symbol.
         } else {
             proc_ptr = parser.create_symbol(name, src_pos, line, TYPE_KIND_PROCEDURE, typeflags);
         }
@@ -598,3 +645,84 @@ tak::parse_decl(Parser& parser, Lexer& lxr) {
     var_ptr->flags = symflags;
     return parse_vardecl(var_ptr, parser, lxr);
 }
+
+
+bool
+tak::parse_deferred_body(AstProcdecl* node, Parser& parser, Lexer& lxr) {
+
+    assert(node != nullptr);
+    assert(node->deferred_body.has_value());
+
+    static constexpr std::string_view msg = "Failed to resolve {} \"{}\", first usage is here.";
+
+    const DeferredBody body = std::move(*node->deferred_body);
+    node->deferred_body.reset();
+
+    const Token    tmp_token      = lxr.current_;
+    const size_t   tmp_pos        = lxr.src_index_;
+    const uint32_t tmp_line       = lxr.curr_line_;
+    const uint32_t prev_sym_index = parser.curr_sym_index_;
+    const size_t   prev_types     = parser.type_table_.size();
+    auto           tmp_namespaces = std::move(parser.namespace_stack_);
+
+    lxr.current_            = body.open;
+    lxr.src_index_          = body.src_index;
+    lxr.curr_line_          = body.line;
+    parser.namespace_stack_ = body.namespaces;
+
+    parser.push_scope();
+    defer([&] {
+        parser.pop_scope();
+        parser.namespace_stack_ = std::move(tmp_namespaces);
+        lxr.current_            = tmp_token; // restore.
+        lxr.src_index_          = tmp_pos;
+        lxr.curr_line_          = tmp_line;
+    });
+
+
+    //
+    // Parameters were declared inside a scope that no longer exists, so re-insert them.
+    //
+
+    for(const auto* param : node->parameters) {
+        const auto* sym = parser.lookup_unique_symbol(param->identifier->symbol_index);
+        parser.scope_stack_.back()[sym->name] = sym->symbol_index;
+    }
+
+    lxr.advance(1);
+    while(lxr.current() != TOKEN_RBRACE) {
+        auto* expr = parse_expression(parser, lxr, false);
+        if(expr == nullptr) {
+            return false;
+        }
+
+        expr->parent = node;
+        node->body.emplace_back(expr);
+    }
+
+
+    //
+    // Every global has been declared by now. Anything that's still a placeholder
+    // after parsing the body will never get resolved.
+    //
+
+    bool state = true;
+    for(uint32_t i = prev_sym_index + 1; i <= parser.curr_sym_index_; ++i) {
+        const auto* sym = parser.lookup_unique_symbol(i);
+        if(sym->flags & SYM_PLACEHOLDER) {
+            lxr.raise_error(fmt(msg, "symbol", sym->name), sym->src_pos, sym->line_number);
+            state = false;
+        }
+    }
+
+    if(parser.type_table_.size() > prev_types) {
+        for(const auto &[name, type] : parser.type_table_) {
+            if(type.is_placeholder) {
+                lxr.raise_error(fmt(msg, "type", name), type.pos_first_used, type.line_first_used);
+                state = false;
+            }
+        }
+    }
+
+    return state;
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 //
 
 #include <parser.hpp>
+#include <layout.hpp>
 
 
 tak::AstNode*
@@ -109,6 +110,63 @@ tak::parse_callconv(Parser& parser, Lexer& lxr) {
 }
 
 
+tak::AstNode*
+tak::parse_struct_attributes(Parser& parser, Lexer& lxr) {
+
+    parser_assert(lxr.current().value == "packed" || lxr.current().value == "align", "Expected \"@packed\" or \"@align\".");
+
+    bool     is_packed = false;
+    uint32_t alignment = 0;
+
+    while(true) {
+        if(lxr.current().value == "packed") {
+            is_packed = true;
+            lxr.advance(1);
+        } else {
+            if(lxr.peek(1) != TOKEN_LPAREN || lxr.peek(2) != TOKEN_INTEGER_LITERAL || lxr.peek(3) != TOKEN_RPAREN) {
+                lxr.raise_error("Expected alignment, for example @align(16).");
+                return nullptr;
+            }
+
+            lxr.advance(2);
+            const auto value = lexer_token_lit_to_int(lxr.current());
+            if(!value || *value == 0 || *value > MAX_STRUCT_ALIGNMENT || (*value & (*value - 1)) != 0) {
+                lxr.raise_error("Alignment must be a power of two, no larger than " + std::to_string(MAX_STRUCT_ALIGNMENT) + '.');
+                return nullptr;
+            }
+
+            alignment = static_cast<uint32_t>(*value);
+            lxr.advance(2);
+        }
+
+        if(lxr.current() != TOKEN_AT) {
+            break;
+        }
+
+        lxr.advance(1);
+        if(lxr.current() != TOKEN_IDENTIFIER || (lxr.current().value != "packed" && lxr.current().value != "align")) {
+            lxr.raise_error("Only @packed and @align can be combined in front of a struct.");
+            return nullptr;
+        }
+    }
+
+    if(lxr.current() != TOKEN_KW_STRUCT) {
+        lxr.raise_error("Expected struct definition after layout directive.");
+        return nullptr;
+    }
+
+    auto* node = parse_structdef(parser, lxr);
+    if(node == nullptr) {
+        return nullptr;
+    }
+
+    auto* user_t      = parser.lookup_type(dynamic_cast<AstStructdef*>(node)->name);
+    user_t->is_packed = is_packed;
+    user_t->alignment = alignment;
+    return node;
+}
+
+
 tak::AstNode*
 tak::parse_compiler_directive(Parser& parser, Lexer& lxr) {
 
@@ -121,6 +179,8 @@ tak::parse_compiler_directive(Parser& parser, Lexer& lxr) {
 
     if(lxr.current().value == "alias")    return parse_type_alias(parser, lxr);
     if(lxr.current().value == "callconv") return parse_callconv(parser, lxr);
+    if(lxr.current().value == "packed")   return parse_struct_attributes(parser, lxr);
+    if(lxr.current().value == "align")    return parse_struct_attributes(parser, lxr);
 
     //
     // Nothing else here for now.
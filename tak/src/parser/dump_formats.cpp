@@ -0,0 +1,391 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <dump.hpp>
+#include <support.hpp>
+#include <algorithm>
+#include <fstream>
+
+using namespace tak;
+
+
+tak::DumpWriter::DumpWriter(std::ostream& out, const bool styled) : out_(out), styled_(styled) {
+    buffer_.reserve(flush_threshold + 4096);
+}
+
+tak::DumpWriter::~DumpWriter() {
+    flush();
+}
+
+void
+tak::DumpWriter::write(const std::string_view str) {
+    buffer_ += str;
+    if(buffer_.size() >= flush_threshold) flush();
+}
+
+void
+tak::DumpWriter::write(const void* data, const size_t size) {
+    buffer_.append(static_cast<const char*>(data), size);
+    if(buffer_.size() >= flush_threshold) flush();
+}
+
+void
+tak::DumpWriter::spaces(const uint32_t count) {
+    buffer_.append(count, ' ');
+}
+
+void
+tak::DumpWriter::heading(const std::string_view text, const uint16_t style) {
+
+    //
+    // Escape sequences go through the same functions print uses, so they behave the same way on Windows.
+    //
+
+    if(styled_) {
+        flush();
+        term_set_style(style);
+    }
+
+    buffer_ += text;
+    buffer_ += '\n';
+
+    if(styled_) {
+        flush();
+        term_reset();
+    }
+}
+
+void
+tak::DumpWriter::flush() {
+    if(!buffer_.empty()) {
+        out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        buffer_.clear();
+    }
+}
+
+bool
+tak::DumpWriter::good() const {
+    return static_cast<bool>(out_);
+}
+
+
+//
+// Shared between the JSON and binary formats.
+//
+
+static std::string_view
+node_text(const AstNode* node) {
+    switch(node->type) {
+        case NODE_SINGLETON_LITERAL: return dynamic_cast<const AstSingletonLiteral*>(node)->value;
+        case NODE_STRUCT_DEFINITION: return dynamic_cast<const AstStructdef*>(node)->name;
+        case NODE_NAMESPACEDECL:     return dynamic_cast<const AstNamespaceDecl*>(node)->full_path;
+        case NODE_TYPE_ALIAS:        return dynamic_cast<const AstTypeAlias*>(node)->name;
+        case NODE_MEMBER_ACCESS:     return dynamic_cast<const AstMemberAccess*>(node)->path;
+        case NODE_COMPOSEDECL:       return dynamic_cast<const AstComposeDecl*>(node)->type_name;
+        default:                     return "";
+    }
+}
+
+static token_t
+node_token(const AstNode* node) {
+    switch(node->type) {
+        case NODE_BINEXPR:           return dynamic_cast<const AstBinexpr*>(node)->_operator;
+        case NODE_UNARYEXPR:         return dynamic_cast<const AstUnaryexpr*>(node)->_operator;
+        case NODE_SINGLETON_LITERAL: return dynamic_cast<const AstSingletonLiteral*>(node)->literal_type;
+        default:                     return TOKEN_NONE;
+    }
+}
+
+static std::string
+member_type_str(Parser& parser, const MemberData& member) {
+    if(member.type.sym_ref != INVALID_SYMBOL_INDEX) {
+        const auto* sym = parser.lookup_unique_symbol(member.type.sym_ref);
+        return sym != nullptr ? typedata_to_str_msg(sym->type) : std::string("?");
+    }
+
+    return typedata_to_str_msg(member.type);
+}
+
+static std::vector<const Symbol*>
+sorted_symbols(const Parser& parser) {
+
+    std::vector<const Symbol*> symbols;
+    symbols.reserve(parser.sym_table_.size());
+    for(const auto& [index, sym] : parser.sym_table_) {
+        symbols.emplace_back(&sym);
+    }
+
+    std::ranges::sort(symbols, {}, &Symbol::symbol_index);
+    return symbols;
+}
+
+static std::vector<std::pair<const std::string*, const UserType*>>
+sorted_types(const Parser& parser) {
+
+    std::vector<std::pair<const std::string*, const UserType*>> types;
+    types.reserve(parser.type_table_.size());
+    for(const auto& [name, type] : parser.type_table_) {
+        types.emplace_back(&name, &type);
+    }
+
+    std::ranges::sort(types, [](const auto& lhs, const auto& rhs) { return *lhs.first < *rhs.first; });
+    return types;
+}
+
+
+//
+// JSON.
+//
+
+static void
+write_json_string(DumpWriter& out, const std::string_view str) {
+    std::string quoted;
+    append_json_string(quoted, str);
+    out.write(quoted);
+}
+
+static void
+write_json_node(Parser& parser, AstNode* node, DumpWriter& out) {
+
+    out.write("{\"node\": ");
+    write_json_string(out, node_type_name(node->type));
+    out.write(fmt(", \"pos\": {}", node->pos));
+
+    if(const auto* ident = dynamic_cast<const AstIdentifier*>(node)) {
+        out.write(fmt(", \"symbol\": {}", ident->symbol_index));
+    }
+
+    if(const token_t token = node_token(node); token != TOKEN_NONE) {
+        out.write(", \"token\": ");
+        write_json_string(out, token_type_to_string(token));
+    }
+
+    if(const std::string_view text = node_text(node); !text.empty()) {
+        out.write(", \"text\": ");
+        write_json_string(out, text);
+    }
+
+    if(const TypeData* type = parser.lookup_node_type(node)) {
+        out.write(", \"type\": ");
+        write_json_string(out, typedata_to_str_msg(*type));
+    }
+
+    if(node->const_id != INVALID_CONSTANT_ID) {
+        out.write(fmt(", \"const_id\": {}", node->const_id));
+    }
+
+    bool first = true;
+    for_each_child(node, [&](AstNode* child) {
+        out.write(first ? ", \"children\": [\n" : ",\n");
+        write_json_node(parser, child, out);
+        first = false;
+    });
+
+    out.write(first ? "}" : "]}");
+}
+
+void
+tak::dump_json(Parser& parser, const uint8_t sections, DumpWriter& out) {
+
+    bool first_section = true;
+    const auto begin_section = [&](const std::string_view name) {
+        out.write(first_section ? "{\n" : ",\n");
+        write_json_string(out, name);
+        out.write(": [");
+        first_section = false;
+    };
+
+    if(sections & DUMP_AST) {
+        begin_section("ast");
+        for(size_t i = 0; i < parser.toplevel_decls_.size(); ++i) {
+            out.write(i == 0 ? "\n" : ",\n");
+            write_json_node(parser, parser.toplevel_decls_[i], out);
+        }
+        out.write("\n]");
+    }
+
+    if(sections & DUMP_SYMBOLS) {
+        begin_section("symbols");
+        const auto symbols = sorted_symbols(parser);
+        for(size_t i = 0; i < symbols.size(); ++i) {
+            const Symbol* sym = symbols[i];
+            out.write(fmt("{}{{\"index\": {}, \"name\": ", i == 0 ? "\n" : ",\n", sym->symbol_index));
+            write_json_string(out, sym->name);
+            out.write(fmt(", \"line\": {}, \"pos\": {}, \"flags\": {}, \"type\": ", sym->line_number, sym->src_pos, sym->flags));
+            write_json_string(out, typedata_to_str_msg(sym->type));
+            out.write("}");
+        }
+        out.write("\n]");
+    }
+
+    if(sections & DUMP_TYPES) {
+        begin_section("types");
+        const auto types = sorted_types(parser);
+        for(size_t i = 0; i < types.size(); ++i) {
+            const auto& [name, type] = types[i];
+            out.write(i == 0 ? "\n{\"name\": " : ",\n{\"name\": ");
+            write_json_string(out, *name);
+            out.write(fmt(", \"placeholder\": {}, \"members\": [", type->is_placeholder ? "true" : "false"));
+
+            for(size_t j = 0; j < type->members.size(); ++j) {
+                const auto& member = type->members[j];
+                out.write(j == 0 ? "{\"name\": " : ", {\"name\": ");
+                write_json_string(out, member.name);
+                out.write(", \"type\": ");
+                write_json_string(out, member_type_str(parser, member));
+                if(member.type.sym_ref != INVALID_SYMBOL_INDEX) {
+                    out.write(fmt(", \"method_symbol\": {}", member.type.sym_ref));
+                }
+                out.write("}");
+            }
+
+            out.write("]}");
+        }
+        out.write("\n]");
+    }
+
+    out.write(first_section ? "{}\n" : "\n}\n");
+}
+
+
+//
+// Binary.
+//
+
+template<typename T>
+static void
+write_records(DumpWriter& out, const std::vector<T>& records) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.write(records.data(), records.size() * sizeof(T));
+}
+
+static std::pair<uint32_t, uint32_t>
+add_string(std::vector<char>& strings, const std::string_view str) {
+    const auto offset = static_cast<uint32_t>(strings.size());
+    strings.insert(strings.end(), str.begin(), str.end());
+    return {offset, static_cast<uint32_t>(str.size())};
+}
+
+static void
+collect_node_records(Parser& parser, AstNode* node, const uint32_t parent, std::vector<DumpNodeRecord>& nodes, std::vector<char>& strings) {
+
+    const auto index  = static_cast<uint32_t>(nodes.size());
+    auto&      record = nodes.emplace_back();
+
+    record.pos      = node->pos;
+    record.parent   = parent;
+    record.type_id  = node->type_id;
+    record.const_id = node->const_id;
+    record.kind     = node->type;
+    record.token    = node_token(node);
+
+    if(const auto* ident = dynamic_cast<const AstIdentifier*>(node)) {
+        record.symbol = ident->symbol_index;
+    }
+
+    const auto [offset, length] = add_string(strings, node_text(node));
+    record.text_offset = offset;
+    record.text_length = length;
+
+    for_each_child(node, [&](AstNode* child) {
+        collect_node_records(parser, child, index, nodes, strings);
+    });
+}
+
+void
+tak::dump_binary(Parser& parser, const uint8_t sections, DumpWriter& out) {
+
+    DumpHeader                    header;
+    std::vector<DumpNodeRecord>   nodes;
+    std::vector<DumpSymbolRecord> symbols;
+    std::vector<DumpTypeRecord>   types;
+    std::vector<DumpMemberRecord> members;
+    std::vector<char>             strings;
+
+    if(sections & DUMP_AST) {
+        for(auto* decl : parser.toplevel_decls_) {
+            collect_node_records(parser, decl, INVALID_DUMP_REF, nodes, strings);
+        }
+    }
+
+    if(sections & DUMP_SYMBOLS) {
+        for(const Symbol* sym : sorted_symbols(parser)) {
+            auto& record   = symbols.emplace_back();
+            record.src_pos = sym->src_pos;
+            record.index   = sym->symbol_index;
+            record.flags   = sym->flags;
+            record.line    = sym->line_number;
+
+            std::tie(record.name_offset, record.name_length) = add_string(strings, sym->name);
+            std::tie(record.type_offset, record.type_length) = add_string(strings, typedata_to_str_msg(sym->type));
+        }
+    }
+
+    if(sections & DUMP_TYPES) {
+        for(const auto& [name, type] : sorted_types(parser)) {
+            auto& record        = types.emplace_back();
+            record.first_member = static_cast<uint32_t>(members.size());
+            record.member_count = static_cast<uint32_t>(type->members.size());
+            record.placeholder  = type->is_placeholder;
+
+            std::tie(record.name_offset, record.name_length) = add_string(strings, *name);
+            for(const auto& member : type->members) {
+                auto& member_record  = members.emplace_back();
+                member_record.symbol = member.type.sym_ref;
+
+                std::tie(member_record.name_offset, member_record.name_length) = add_string(strings, member.name);
+                std::tie(member_record.type_offset, member_record.type_length) = add_string(strings, member_type_str(parser, member));
+            }
+        }
+    }
+
+    header.sections     = sections;
+    header.node_count   = static_cast<uint32_t>(nodes.size());
+    header.symbol_count = static_cast<uint32_t>(symbols.size());
+    header.type_count   = static_cast<uint32_t>(types.size());
+    header.member_count = static_cast<uint32_t>(members.size());
+    header.strings_size = static_cast<uint32_t>(strings.size());
+
+    out.write(&header, sizeof(header));
+    write_records(out, nodes);
+    write_records(out, symbols);
+    write_records(out, types);
+    write_records(out, members);
+    write_records(out, strings);
+}
+
+
+bool
+tak::write_dumps(Parser& parser, const uint8_t sections, const dump_format_t format, const std::string& path) {
+
+    std::ofstream file;
+    if(!path.empty()) {
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if(!file.is_open()) {
+            print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("Could not open {} for writing.", path);
+            return false;
+        }
+    }
+
+    std::ostream& stream = path.empty() ? output_stream() : file;
+    DumpWriter    out(stream, path.empty() && format == DUMP_FORMAT_TEXT);
+
+    switch(format) {
+        case DUMP_FORMAT_JSON:   dump_json(parser, sections, out); break;
+        case DUMP_FORMAT_BINARY: dump_binary(parser, sections, out); break;
+        default:
+            if(sections & DUMP_AST)     parser.dump_nodes(out);
+            if(sections & DUMP_SYMBOLS) parser.dump_symbols(out);
+            if(sections & DUMP_TYPES)   parser.dump_types(out);
+            break;
+    }
+
+    out.flush();
+    if(!out.good()) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("Failed to write dump to {}.", path.empty() ? "stdout" : path);
+        return false;
+    }
+
+    return true;
+}
@@ -136,10 +136,15 @@ tak::parse_enumdef(Parser& parser, Lexer& lxr) {
             lxr.raise_error("Expected identifier.");
         }
 
-        auto member_name = parser.namespace_as_string() + std::string(lxr.current().value);
+        auto    member_name = parser.namespace_as_string() + std::string(lxr.current().value);
+        Symbol* sym         = nullptr;
+
         if(parser.scoped_symbol_exists_at_current_scope(member_name)) {
-            lxr.raise_error("Redeclaration of enum member.");
-            return nullptr;
+            sym = parser.lookup_unique_symbol(parser.lookup_scoped_symbol(member_name));
+            if(!(sym->flags & SYM_PLACEHOLDER)) {
+                lxr.raise_error("Redeclaration of enum member.");
+                return nullptr;
+            }
         }
 
         if(parser.namespace_exists(std::string(lxr.current().value))) {
@@ -149,10 +154,20 @@ tak::parse_enumdef(Parser& parser, Lexer& lxr) {
 
 
         //
-        // Create a symbol for the enum member.
+        // Create a symbol for the enum member, or fill in the placeholder an earlier use
+        // (or an incremental rebuild) left behind.
         //
 
-        auto* sym        = parser.create_symbol(member_name, lxr.current().src_pos, lxr.current().line, TYPE_KIND_VARIABLE, TYPE_FLAGS_NONE, *type);
+        if(sym != nullptr) {
+            sym->type        = *type;
+            sym->type.kind   = TYPE_KIND_VARIABLE;
+            sym->flags       = SYM_FLAGS_NONE;
+            sym->src_pos     = lxr.current().src_pos;
+            sym->line_number = lxr.current().line;
+        } else {
+            sym = parser.create_symbol(member_name, lxr.current().src_pos, lxr.current().line, TYPE_KIND_VARIABLE, TYPE_FLAGS_NONE, *type);
+        }
+
         auto* decl       = new AstVardecl();
         decl->identifier = new AstIdentifier();
         decl->pos        = lxr.current().src_pos;
@@ -202,6 +217,8 @@ tak::parse_enumdef(Parser& parser, Lexer& lxr) {
             lit->literal_type = TOKEN_INTEGER_LITERAL;
         }
 
+        sym->constant = make_int_constant(std::get<var_t>(type->name), enum_index); // Enum definitions never get checked.
+
 
         //
         // Check for terminal, move on to the next value.
@@ -587,6 +587,11 @@ tak::parse_binary_expression(AstNode* left_operand, Parser& parser, Lexer& lxr)
     parser_assert(lxr.current().kind == KIND_BINARY_EXPR_OPERATOR, "Expected binary operator.");
     parser_assert(left_operand != nullptr, "Null left operand passed.");
 
+    if(lxr.current() == TOKEN_TYPE_ASSIGNMENT || lxr.current() == TOKEN_CONST_TYPE_ASSIGNMENT) {
+        lxr.raise_error("Unexpected type assignment within expression.");
+        return nullptr;
+    }
+
 
     bool  state    = false;
     auto* binexpr  = new AstBinexpr();
@@ -620,7 +625,17 @@ tak::parse_binary_expression(AstNode* left_operand, Parser& parser, Lexer& lxr)
     }
 
 
-    while(lxr.current().kind == KIND_BINARY_EXPR_OPERATOR && precedence_of(lxr.current().type) <= precedence_of(binexpr->_operator)) {
+    //
+    // ':' and '::' have no precedence, the recursive call reports them.
+    //
+
+    while(lxr.current().kind == KIND_BINARY_EXPR_OPERATOR) {
+        if(lxr.current() != TOKEN_TYPE_ASSIGNMENT
+            && lxr.current() != TOKEN_CONST_TYPE_ASSIGNMENT
+            && precedence_of(lxr.current().type) > precedence_of(binexpr->_operator)) {
+            break;
+        }
+
         binexpr->right_op = parse_binary_expression(binexpr->right_op, parser, lxr);
         if(binexpr->right_op == nullptr) {
             return nullptr;
@@ -20,15 +20,6 @@ is_type_invalid_as_member(const std::string& struct_name, const tak::TypeData& t
     return type.kind == tak::TYPE_KIND_PROCEDURE && type.pointer_depth < 1;
 }
 
-static bool
-member_already_exists(const std::vector<tak::MemberData>* members, const std::string& member_name) {
-    for(const auto& member : *members) {
-        if(member.name == member_name) return true;
-    }
-
-    return false;
-}
-
 tak::AstNode*
 tak::parse_structdef(Parser& parser, Lexer& lxr) {
 
@@ -75,7 +66,7 @@ tak::parse_structdef(Parser& parser, Lexer& lxr) {
 
 
     //
-    // We need to create the type and then get a pointer to its member list AFTER and modify it.
+    // We need to create the type and then get a pointer to it AFTER and modify it.
     // This is because members may refer back to the struct sometimes. Like if a member was
     // foo^, where foo is the struct.
     //
@@ -90,7 +81,7 @@ tak::parse_structdef(Parser& parser, Lexer& lxr) {
     //
 
     lxr.advance(2);
-    std::vector<MemberData>* members = replace == nullptr ? parser.lookup_type_members(type_name) : &replace->members;
+    UserType* user_t = replace == nullptr ? parser.lookup_type(type_name) : replace;
 
     while(lxr.current() != TOKEN_RBRACE) {
 
@@ -127,13 +118,13 @@ tak::parse_structdef(Parser& parser, Lexer& lxr) {
                 return nullptr;
             }
 
-            if(member_already_exists(members, name)) {
+            MemberData member(name, *type);
+            member.type.flags |= is_const ? TYPE_CONSTANT | TYPE_DEFAULT_INIT : TYPE_DEFAULT_INIT;
+
+            if(!user_t->add_member(std::move(member))) {
                 lxr.raise_error("Member with this name already exists.", curr_pos, line);
                 return nullptr;
             }
-
-            members->emplace_back(MemberData(name, *type));
-            members->back().type.flags |= is_const ? TYPE_CONSTANT | TYPE_DEFAULT_INIT : TYPE_DEFAULT_INIT;
         } else {
             return nullptr;
         }
@@ -81,6 +81,9 @@ tak::parse_type(Parser& parser, Lexer& lxr) {
         const auto canonical_name = parser.get_canonical_type_name(*name);
         if(parser.type_alias_exists(canonical_name)) {
             data = parser.lookup_type_alias(canonical_name);
+            if(parser.alias_log_ != nullptr) {
+                parser.alias_log_->emplace_back(canonical_name);
+            }
         }
         else {
             if(!parser.type_exists(canonical_name)) {
@@ -130,7 +133,7 @@ tak::parse_type(Parser& parser, Lexer& lxr) {
     if(lxr.current() == TOKEN_LSQUARE_BRACKET) {
         data.flags |= TYPE_ARRAY;
         if(const auto arr_data = parse_array_data(lxr)) {
-            data.array_lengths = *arr_data;
+            data.array_lengths.assign(arr_data->begin(), arr_data->end());
         } else {
             return std::nullopt;
         }
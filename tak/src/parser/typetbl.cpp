@@ -3,6 +3,7 @@
 //
 
 #include <parser.hpp>
+#include <algorithm>
 
 
 bool
@@ -17,10 +18,36 @@ tak::Parser::create_type(const std::string& name, std::vector<MemberData>&& type
     auto& user_t          = type_table_[name];
     user_t.members        = type_data;
     user_t.is_placeholder = false;
+    user_t.reindex_members();
 
     return true;
 }
 
+const tak::MemberData*
+tak::UserType::find_member(const std::string& name) const {
+    const auto found = member_indices.find(name);
+    return found != member_indices.end() ? &members[found->second] : nullptr;
+}
+
+bool
+tak::UserType::add_member(MemberData&& member) {
+    if(!member_indices.emplace(member.name, static_cast<uint32_t>(members.size())).second) {
+        return false;
+    }
+
+    members.emplace_back(std::move(member));
+    return true;
+}
+
+void
+tak::UserType::reindex_members() {
+    member_indices.clear();
+    member_indices.reserve(members.size());
+    for(uint32_t i = 0; i < members.size(); ++i) {
+        member_indices.emplace(members[i].name, i);
+    }
+}
+
 bool
 tak::Parser::create_placeholder_type(const std::string& name, const size_t pos, const uint32_t line) {
     assert(!type_exists(name));
@@ -61,3 +88,133 @@ tak::Parser::lookup_type_alias(const std::string& name) {
     assert(type_aliases_.contains(name));
     return type_aliases_[name];
 }
+
+
+//
+// Expression types. Every distinct type the checker produces is stored once,
+// and nodes refer to it by ID. Unlike types_are_identical, flags and sym_ref matter here.
+//
+
+static uint64_t
+hash_type_data(const tak::TypeData& type) {
+
+    uint64_t hash = 0xCBF29CE484222325ULL; // FNV-1a
+    const auto mix = [&](const uint64_t value) {
+        for(size_t i = 0; i < sizeof(value); ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 0x100000001B3ULL;
+        }
+    };
+
+    mix(type.pointer_depth);
+    mix(type.flags);
+    mix(type.kind);
+    mix(type.sym_ref);
+    mix(type.name.index());
+
+    for(const uint32_t length : type.array_lengths) {
+        mix(length);
+    }
+
+    if(const auto* var_type = std::get_if<tak::var_t>(&type.name)) {
+        mix(*var_type);
+    } else if(const auto* name = std::get_if<std::string>(&type.name)) {
+        mix(std::hash<std::string>{}(*name));
+    }
+
+    if(type.parameters != nullptr) {
+        for(const auto& param : *type.parameters) {
+            mix(hash_type_data(param));
+        }
+    }
+
+    if(type.return_type != nullptr) {
+        mix(hash_type_data(*type.return_type));
+    }
+
+    return hash;
+}
+
+static bool
+type_data_equal(const tak::TypeData& first, const tak::TypeData& second) {
+
+    if(first.pointer_depth != second.pointer_depth
+        || first.flags != second.flags
+        || first.kind != second.kind
+        || first.sym_ref != second.sym_ref
+        || first.name != second.name
+        || first.array_lengths != second.array_lengths
+        || (first.parameters == nullptr) != (second.parameters == nullptr)
+        || (first.return_type == nullptr) != (second.return_type == nullptr)
+    ) {
+        return false;
+    }
+
+    if(first.parameters != nullptr) {
+        if(!std::ranges::equal(*first.parameters, *second.parameters, type_data_equal)) {
+            return false;
+        }
+    }
+
+    return first.return_type == nullptr || type_data_equal(*first.return_type, *second.return_type);
+}
+
+uint32_t
+tak::intern_type(std::vector<TypeData>& types, std::unordered_multimap<uint64_t, uint32_t>& type_ids, const TypeData& type) {
+
+    const uint64_t hash = hash_type_data(type);
+    const auto [begin, end] = type_ids.equal_range(hash);
+
+    for(auto it = begin; it != end; ++it) {
+        if(type_data_equal(types[it->second - 1], type)) {
+            return it->second;
+        }
+    }
+
+    types.emplace_back(type);
+    const auto type_id = static_cast<uint32_t>(types.size());
+    type_ids.emplace(hash, type_id);
+    return type_id;
+}
+
+uint32_t
+tak::Parser::intern_node_type(const TypeData& type) {
+    return intern_type(node_types_, node_type_ids_, type);
+}
+
+const tak::TypeData*
+tak::Parser::lookup_node_type(const uint32_t type_id) {
+    if(type_id == INVALID_TYPE_ID || type_id > node_types_.size()) {
+        return nullptr;
+    }
+
+    return &node_types_[type_id - 1];
+}
+
+const tak::TypeData*
+tak::Parser::lookup_node_type(const AstNode* node) {
+    assert(node != nullptr);
+    return lookup_node_type(node->type_id);
+}
+
+uint32_t
+tak::Parser::add_node_constant(const ConstantValue& value) {
+    assert(value.type != VAR_NONE);
+    node_constants_.emplace_back(value);
+    return static_cast<uint32_t>(node_constants_.size());
+}
+
+const tak::ConstantValue*
+tak::Parser::lookup_node_constant(const uint32_t const_id) {
+    if(const_id == INVALID_CONSTANT_ID || const_id > node_constants_.size()) {
+        return nullptr;
+    }
+
+    return &node_constants_[const_id - 1];
+}
+
+const tak::ConstantValue*
+tak::Parser::lookup_node_constant(const AstNode* node) {
+    assert(node != nullptr);
+    return lookup_node_constant(node->const_id);
+}
@@ -0,0 +1,162 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <parser.hpp>
+
+
+void
+tak::for_each_child(AstNode* node, const std::function<void(AstNode*)>& callback) {
+
+    assert(node != nullptr);
+
+    const auto visit = [&](AstNode* child) {
+        if(child != nullptr) { callback(child); }
+    };
+
+    const auto visit_optional = [&](const std::optional<AstNode*>& child) {
+        if(child.has_value()) { visit(*child); }
+    };
+
+    const auto visit_all = [&](const auto& children) {
+        for(AstNode* child : children) { visit(child); }
+    };
+
+
+    switch(node->type) {
+        case NODE_VARDECL: {
+            const auto* vardecl = dynamic_cast<AstVardecl*>(node);
+            visit(vardecl->identifier);
+            visit_optional(vardecl->init_value);
+            break;
+        }
+
+        case NODE_PROCDECL: {
+            const auto* procdecl = dynamic_cast<AstProcdecl*>(node);
+            visit(procdecl->identifier);
+            visit_all(procdecl->parameters);
+            visit_all(procdecl->body);
+            break;
+        }
+
+        case NODE_BINEXPR: {
+            const auto* binexpr = dynamic_cast<AstBinexpr*>(node);
+            visit(binexpr->left_op);
+            visit(binexpr->right_op);
+            break;
+        }
+
+        case NODE_BRANCH: {
+            const auto* branch = dynamic_cast<AstBranch*>(node);
+            visit_all(branch->conditions);
+            if(branch->_else.has_value()) { visit(*branch->_else); }
+            break;
+        }
+
+        case NODE_IF: {
+            const auto* _if = dynamic_cast<AstIf*>(node);
+            visit(_if->condition);
+            visit_all(_if->body);
+            break;
+        }
+
+        case NODE_FOR: {
+            const auto* _for = dynamic_cast<AstFor*>(node);
+            visit_optional(_for->init);
+            visit_optional(_for->condition);
+            visit_optional(_for->update);
+            visit_all(_for->body);
+            break;
+        }
+
+        case NODE_SWITCH: {
+            const auto* _switch = dynamic_cast<AstSwitch*>(node);
+            visit(_switch->target);
+            visit_all(_switch->cases);
+            visit(_switch->_default);
+            break;
+        }
+
+        case NODE_CASE: {
+            const auto* _case = dynamic_cast<AstCase*>(node);
+            visit(_case->value);
+            visit_all(_case->body);
+            break;
+        }
+
+        case NODE_WHILE: {
+            const auto* _while = dynamic_cast<AstWhile*>(node);
+            visit(_while->condition);
+            visit_all(_while->body);
+            break;
+        }
+
+        case NODE_DOWHILE: {
+            const auto* dowhile = dynamic_cast<AstDoWhile*>(node);
+            visit_all(dowhile->body);
+            visit(dowhile->condition);
+            break;
+        }
+
+        case NODE_CALL: {
+            const auto* call = dynamic_cast<AstCall*>(node);
+            visit(call->target);
+            visit_all(call->arguments);
+            break;
+        }
+
+        case NODE_DEFER_IF: {
+            const auto* defer_if = dynamic_cast<AstDeferIf*>(node);
+            visit(defer_if->condition);
+            visit(defer_if->call);
+            break;
+        }
+
+        case NODE_SIZEOF: {
+            if(auto* const* target = std::get_if<AstNode*>(&dynamic_cast<AstSizeof*>(node)->target)) {
+                visit(*target);
+            }
+            break;
+        }
+
+        case NODE_ENUM_DEFINITION: {
+            const auto* enumdef = dynamic_cast<AstEnumdef*>(node);
+            visit(enumdef->alias);
+            visit(enumdef->_namespace);
+            break;
+        }
+
+        case NODE_SUBSCRIPT: {
+            const auto* subscript = dynamic_cast<AstSubscript*>(node);
+            visit(subscript->operand);
+            visit(subscript->value);
+            break;
+        }
+
+        case NODE_ELSE:               visit_all(dynamic_cast<AstElse*>(node)->body); break;
+        case NODE_DEFAULT:            visit_all(dynamic_cast<AstDefault*>(node)->body); break;
+        case NODE_BLOCK:              visit_all(dynamic_cast<AstBlock*>(node)->children); break;
+        case NODE_BRACED_EXPRESSION:  visit_all(dynamic_cast<AstBracedExpression*>(node)->members); break;
+        case NODE_NAMESPACEDECL:      visit_all(dynamic_cast<AstNamespaceDecl*>(node)->children); break;
+        case NODE_COMPOSEDECL:        visit_all(dynamic_cast<AstComposeDecl*>(node)->children); break;
+        case NODE_UNARYEXPR:          visit(dynamic_cast<AstUnaryexpr*>(node)->operand); break;
+        case NODE_RET:                visit_optional(dynamic_cast<AstRet*>(node)->value); break;
+        case NODE_DEFER:              visit(dynamic_cast<AstDefer*>(node)->call); break;
+        case NODE_CAST:               visit(dynamic_cast<AstCast*>(node)->target); break;
+        case NODE_MEMBER_ACCESS:      visit(dynamic_cast<AstMemberAccess*>(node)->target); break;
+
+        default:
+            break; // No children.
+    }
+}
+
+void
+tak::walk_ast(AstNode* node, const std::function<void(AstNode*)>& callback) {
+
+    assert(node != nullptr);
+
+    callback(node);
+    for_each_child(node, [&](AstNode* child) {
+        walk_ast(child, callback);
+    });
+}
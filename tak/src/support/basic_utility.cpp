@@ -177,6 +177,45 @@ tak::precedence_of(const token_t _operator) {
     }
 }
 
+std::string_view
+tak::node_type_name(const node_t type) {
+    switch(type) {
+        case NODE_VARDECL:           return "vardecl";
+        case NODE_PROCDECL:          return "procdecl";
+        case NODE_BINEXPR:           return "binexpr";
+        case NODE_UNARYEXPR:         return "unaryexpr";
+        case NODE_IDENT:             return "identifier";
+        case NODE_BRANCH:            return "branch";
+        case NODE_IF:                return "if";
+        case NODE_ELSE:              return "else";
+        case NODE_FOR:               return "for";
+        case NODE_SWITCH:            return "switch";
+        case NODE_CASE:              return "case";
+        case NODE_DEFAULT:           return "default";
+        case NODE_WHILE:             return "while";
+        case NODE_DOWHILE:           return "dowhile";
+        case NODE_BLOCK:             return "block";
+        case NODE_CALL:              return "call";
+        case NODE_BRK:               return "brk";
+        case NODE_CONT:              return "cont";
+        case NODE_RET:               return "ret";
+        case NODE_DEFER:             return "defer";
+        case NODE_DEFER_IF:          return "defer_if";
+        case NODE_SIZEOF:            return "sizeof";
+        case NODE_SINGLETON_LITERAL: return "literal";
+        case NODE_BRACED_EXPRESSION: return "braced expression";
+        case NODE_STRUCT_DEFINITION: return "struct definition";
+        case NODE_ENUM_DEFINITION:   return "enum definition";
+        case NODE_SUBSCRIPT:         return "subscript";
+        case NODE_NAMESPACEDECL:     return "namespace";
+        case NODE_COMPOSEDECL:       return "compose";
+        case NODE_CAST:              return "cast";
+        case NODE_TYPE_ALIAS:        return "type alias";
+        case NODE_MEMBER_ACCESS:     return "member access";
+        default:                     return "none";
+    }
+}
+
 uint16_t
 tak::var_t_to_size_bytes(const var_t type) {
 
@@ -360,3 +399,25 @@ tak::split_string(std::string str, const char delim) {
 
     return chunks;
 }
+
+void
+tak::append_json_string(std::string& out, const std::string_view str) {
+
+    out += '"';
+    for(const char c : str) {
+        switch(c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20) {
+                    out += fmt("\\u{:04x}", static_cast<uint32_t>(c));
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
@@ -0,0 +1,129 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <support.hpp>
+#include <io.hpp>
+#include <bit>
+#include <cmath>
+
+
+tak::ConstantValue
+tak::make_int_constant(const var_t type, uint64_t bits) {
+
+    //
+    // Wraps the value to the width of the type, the way it would be stored at runtime.
+    //
+
+    ConstantValue value;
+    value.type = type;
+
+    if(type == VAR_BOOLEAN) {
+        value.bits = bits != 0;
+        return value;
+    }
+
+    assert(PRIMITIVE_IS_INTEGER(type));
+    const uint32_t width = var_t_to_size_bytes(type) * 8U;
+
+    if(width < 64) {
+        const uint64_t mask = (1ULL << width) - 1;
+        bits &= mask;
+        if(PRIMITIVE_IS_SIGNED(type) && (bits >> (width - 1) & 1)) {
+            bits |= ~mask;
+        }
+    }
+
+    value.bits = bits;
+    return value;
+}
+
+tak::ConstantValue
+tak::make_float_constant(const var_t type, double value) {
+
+    assert(PRIMITIVE_IS_FLOAT(type));
+    if(type == VAR_F32) {
+        value = static_cast<float>(value);
+    }
+
+    ConstantValue constant;
+    constant.type = type;
+    constant.bits = std::bit_cast<uint64_t>(value);
+    return constant;
+}
+
+double
+tak::constant_to_double(const ConstantValue& value) {
+
+    if(PRIMITIVE_IS_FLOAT(value.type)) {
+        return std::bit_cast<double>(value.bits);
+    }
+
+    if(PRIMITIVE_IS_SIGNED(value.type)) {
+        return static_cast<double>(static_cast<int64_t>(value.bits));
+    }
+
+    return static_cast<double>(value.bits);
+}
+
+tak::ConstantValue
+tak::convert_constant(const ConstantValue& value, const var_t to) {
+
+    if(value.type == VAR_NONE) {
+        return {};
+    }
+
+    if(to == VAR_BOOLEAN) {
+        return make_int_constant(VAR_BOOLEAN, PRIMITIVE_IS_FLOAT(value.type) ? constant_to_double(value) != 0.0 : value.bits != 0);
+    }
+
+    if(PRIMITIVE_IS_FLOAT(to)) {
+        return make_float_constant(to, constant_to_double(value));
+    }
+
+    if(!PRIMITIVE_IS_INTEGER(to)) {
+        return {};
+    }
+
+    if(!PRIMITIVE_IS_FLOAT(value.type)) {
+        return make_int_constant(to, value.bits);
+    }
+
+
+    //
+    // Floats are truncated towards zero. Anything that doesn't fit in 64 bits has no
+    // defined result, so it just isn't a constant.
+    //
+
+    static constexpr double two_pow_63 = 9223372036854775808.0;
+    static constexpr double two_pow_64 = 18446744073709551616.0;
+
+    const double real = std::trunc(constant_to_double(value));
+    if(real >= -two_pow_63 && real < two_pow_63) {
+        return make_int_constant(to, static_cast<uint64_t>(static_cast<int64_t>(real)));
+    }
+
+    if(real >= 0.0 && real < two_pow_64) {
+        return make_int_constant(to, static_cast<uint64_t>(real));
+    }
+
+    return {};
+}
+
+std::string
+tak::constant_to_string(const ConstantValue& value) {
+
+    switch(value.type) {
+        case VAR_NONE:    return "<unknown>";
+        case VAR_BOOLEAN: return value.bits ? "true" : "false";
+        case VAR_F32:
+        case VAR_F64:     return std::format("{}", constant_to_double(value));
+        default:          break;
+    }
+
+    if(PRIMITIVE_IS_SIGNED(value.type)) {
+        return std::to_string(static_cast<int64_t>(value.bits));
+    }
+
+    return std::to_string(value.bits);
+}
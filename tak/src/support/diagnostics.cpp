@@ -0,0 +1,376 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <diagnostics.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iostream>
+
+using namespace tak;
+
+
+static constexpr std::array<DiagInfo, DIAG_CODE_COUNT> diag_table = {{
+    {"operands-untyped",             DIAG_SEVERITY_ERROR, "Unable to deduce type of one or more operands."},
+    {"logical-operator-left",        DIAG_SEVERITY_ERROR, "Logical operator '{}' cannot be applied to lefthand type {}."},
+    {"logical-operator-right",       DIAG_SEVERITY_ERROR, "Logical operator '{}' cannot be applied to righthand type {}."},
+    {"operator-left",                DIAG_SEVERITY_ERROR, "Operator '{}' cannot be applied to lefthand type {}."},
+    {"right-coercion",               DIAG_SEVERITY_ERROR, "Cannot coerce type of righthand expression ({}) to {}"},
+    {"unary-operator",               DIAG_SEVERITY_ERROR, "Cannot apply unary operator {} to type {}."},
+    {"unary-minus",                  DIAG_SEVERITY_ERROR, "Cannot apply unary minus to type {}."},
+    {"bitwise-not",                  DIAG_SEVERITY_ERROR, "Cannot apply bitwise operator ~ to type {}"},
+    {"increment-decrement",          DIAG_SEVERITY_ERROR, "Cannot apply operator {} to type {}"},
+    {"logical-not",                  DIAG_SEVERITY_ERROR, "Cannot apply logical operator ! to type {}"},
+    {"dereference",                  DIAG_SEVERITY_ERROR, "Cannot dereference type {}."},
+    {"address-of",                   DIAG_SEVERITY_ERROR, "Cannot get the address of type {}."},
+    {"uninitialized-symbol",         DIAG_SEVERITY_ERROR, "Referencing uninitialized or invalid symbol \"{}\"."},
+    {"right-undeduced",              DIAG_SEVERITY_ERROR, "Could not deduce type of righthand expression."},
+    {"array-mismatch",               DIAG_SEVERITY_ERROR, "Array of type {} is not equivalent to {}."},
+    {"assigned-untyped",             DIAG_SEVERITY_ERROR, "Expression assigned to \"{}\" does not have a type."},
+    {"inferred-context",             DIAG_SEVERITY_ERROR, "Cannot assign type {} in an inferred context."},
+    {"inferred-array-unassigned",    DIAG_SEVERITY_ERROR, "Arrays with inferred sizes (e.g. '[]') must be assigned when created."},
+    {"right-untyped",                DIAG_SEVERITY_ERROR, "Righthand expression does not have a type."},
+    {"assignment-mismatch",          DIAG_SEVERITY_ERROR, "Cannot assign variable \"{}\" of type {} to {}."},
+    {"invalid-cast",                 DIAG_SEVERITY_ERROR, "Cannot cast type {} to {}."},
+    {"method-argument-count",        DIAG_SEVERITY_ERROR, "Calling method with {} arguments, but it takes {}."},
+    {"named-method-argument-count",  DIAG_SEVERITY_ERROR, "Calling method \"{}\" with {} arguments, but it takes {}."},
+    {"argument-untyped",             DIAG_SEVERITY_ERROR, "Cannot deduce type of argument {} in this call."},
+    {"argument-conversion",          DIAG_SEVERITY_ERROR, "Cannot convert argument {} of type {} to expected parameter type {}."},
+    {"call-target-untyped",          DIAG_SEVERITY_ERROR, "Unable to deduce type of call target"},
+    {"not-callable",                 DIAG_SEVERITY_ERROR, "Attempt to call non-callable type."},
+    {"call-argument-count",          DIAG_SEVERITY_ERROR, "Attempting to call procedure of type {} with {} arguments, but it takes {}."},
+    {"return-mismatch",              DIAG_SEVERITY_ERROR, "Invalid return statement: does not match return type for procedure \"{}\"."},
+    {"return-coercion",              DIAG_SEVERITY_ERROR, "Cannot coerce type {} to procedure return type {} (compiling procedure \"{}\")."},
+    {"member-access-untyped",        DIAG_SEVERITY_ERROR, "Attempting to access non-existant type as a struct."},
+    {"member-access-type",           DIAG_SEVERITY_ERROR, "Cannot perform member access on type {}."},
+    {"no-such-member",               DIAG_SEVERITY_ERROR, "Cannot access \"{}\" within type \"{}\"."},
+    {"defer-if-untyped",             DIAG_SEVERITY_ERROR, "defer_if condition does not produce a type."},
+    {"not-logical",                  DIAG_SEVERITY_ERROR, "Type {} cannot be used as a logical expression."},
+    {"expression-untyped",           DIAG_SEVERITY_ERROR, "Expression does not evaluate to a type."},
+    {"branch-untyped",               DIAG_SEVERITY_ERROR, "Invalid branch condition: contained expression does not produce a type."},
+    {"for-init-untyped",             DIAG_SEVERITY_ERROR, "For-loop initialization clause does not produce a type."},
+    {"for-condition-untyped",        DIAG_SEVERITY_ERROR, "For-loop condition does not produce a type."},
+    {"for-condition-type",           DIAG_SEVERITY_ERROR, "Type {} cannot be used as a for-loop condition."},
+    {"switch-target-untyped",        DIAG_SEVERITY_ERROR, "Switch target does not produce a type."},
+    {"switch-target-type",           DIAG_SEVERITY_ERROR, "Type {} cannot be used as a switch target."},
+    {"case-untyped",                 DIAG_SEVERITY_ERROR, "Case value does not produce a type."},
+    {"case-coercion",                DIAG_SEVERITY_ERROR, "Cannot coerce type of case value ({}) to {}."},
+    {"while-condition-untyped",      DIAG_SEVERITY_ERROR, "Loop condition does not produce a type."},
+    {"while-condition-type",         DIAG_SEVERITY_ERROR, "Type {} cannot be used as a condition for a while-loop."},
+    {"subscript-value-untyped",      DIAG_SEVERITY_ERROR, "Value within subscript operator does not evaluate to a type."},
+    {"subscript-operand-untyped",    DIAG_SEVERITY_ERROR, "Subscript operand does not evaluate to a type."},
+    {"subscript-value-type",         DIAG_SEVERITY_ERROR, "Type {} Cannot be used as a subscript value."},
+    {"subscript-operand-type",       DIAG_SEVERITY_ERROR, "Type {} cannot be subscripted into."},
+    {"braced-struct-type",           DIAG_SEVERITY_ERROR, "Cannot assign this braced expression to lefthand type {}."},
+    {"braced-member-count",          DIAG_SEVERITY_ERROR, "Number of elements within braced expression ({}) does not match the struct type {} ({} members)."},
+    {"braced-element-untyped",       DIAG_SEVERITY_ERROR, "Could not deduce type of element {} in braced expression."},
+    {"braced-element-coercion",      DIAG_SEVERITY_ERROR, "Cannot coerce element {} of braced expression to type {} ({} was given)."},
+    {"constant-division-by-zero",    DIAG_SEVERITY_WARNING, "Division by zero in constant expression, it will not be folded."},
+    {"constant-shift-range",         DIAG_SEVERITY_WARNING, "Shift amount {} is out of range for type {}."},
+    {"constant-truncated",           DIAG_SEVERITY_WARNING, "Constant value {} does not fit in type {} and becomes {}."},
+    {"unreachable-declaration",      DIAG_SEVERITY_WARNING, "{} is not reachable from any entry point and was not checked."},
+}};
+
+
+const DiagInfo&
+tak::get_diag_info(const diag_code_t code) {
+    assert(code < DIAG_CODE_COUNT);
+    return diag_table[code];
+}
+
+std::string
+tak::format_diagnostic(const Diagnostic& diag, Parser& parser) {
+
+    const std::string_view format = get_diag_info(diag.code).format;
+
+    std::string output;
+    size_t      arg_index = 0;
+
+    for(size_t i = 0; i < format.size(); ++i) {
+        if(format[i] != '{' || i + 1 >= format.size() || format[i + 1] != '}') {
+            output += format[i];
+            continue;
+        }
+
+        ++i;
+        if(arg_index >= diag.args.size()) {
+            output += "<?>";
+            continue;
+        }
+
+        const auto& arg = diag.args[arg_index++];
+        switch(arg.kind) {
+            case DIAG_ARG_TOKEN:   output += token_to_string(static_cast<token_t>(arg.value)); break;
+            case DIAG_ARG_INTEGER: output += std::to_string(arg.value); break;
+            case DIAG_ARG_STRING:  output += arg.text; break;
+            case DIAG_ARG_TYPE:
+                if(const auto* type = parser.lookup_node_type(static_cast<uint32_t>(arg.value))) {
+                    output += typedata_to_str_msg(*type);
+                } else {
+                    output += "<unknown type>";
+                }
+                break;
+
+            default: panic("format_diagnostic: invalid argument kind.");
+        }
+    }
+
+    return output;
+}
+
+DiagSummary
+tak::sort_diagnostics(std::vector<Diagnostic>& diagnostics, const bool truncated) {
+
+    //
+    // The same expression can get visited more than once (method call targets are, for example),
+    // which would report the same thing twice at the same position.
+    //
+
+    std::ranges::stable_sort(diagnostics, [](const Diagnostic& lhs, const Diagnostic& rhs) {
+        return lhs.position < rhs.position;
+    });
+
+    std::vector<Diagnostic> unique;
+    unique.reserve(diagnostics.size());
+
+    size_t group_begin = 0;
+    for(auto& diag : diagnostics) {
+        if(!unique.empty() && unique.back().position != diag.position) {
+            group_begin = unique.size();
+        }
+
+        if(std::find(unique.begin() + static_cast<std::ptrdiff_t>(group_begin), unique.end(), diag) == unique.end()) {
+            unique.emplace_back(std::move(diag));
+        }
+    }
+
+    diagnostics = std::move(unique);
+
+    DiagSummary summary;
+    summary.truncated = truncated;
+
+    for(const auto& diag : diagnostics) {
+        if(get_diag_info(diag.code).severity == DIAG_SEVERITY_ERROR) {
+            ++summary.errors;
+        } else {
+            ++summary.warnings;
+        }
+    }
+
+    return summary;
+}
+
+
+//
+// Line starts are only worked out once there's something to emit.
+//
+
+struct SourceLocation {
+    uint32_t line   = 1;
+    uint32_t column = 1;
+    size_t   begin  = 0;  // Where the line starts in the source.
+    size_t   end    = 0;  // One past the last character of the line.
+};
+
+static std::vector<size_t>
+get_line_starts(const std::vector<char>& src) {
+
+    std::vector<size_t> line_starts = { 0 };
+    for(size_t i = 0; i < src.size(); ++i) {
+        if(src[i] == '\n') line_starts.emplace_back(i + 1);
+    }
+
+    return line_starts;
+}
+
+static SourceLocation
+get_source_location(const std::vector<size_t>& line_starts, const std::vector<char>& src, size_t position) {
+
+    position = std::min(position, src.empty() ? 0 : src.size() - 1);
+    const auto it = std::ranges::upper_bound(line_starts, position) - 1;
+
+    SourceLocation loc;
+    loc.line   = static_cast<uint32_t>(it - line_starts.begin()) + 1;
+    loc.column = static_cast<uint32_t>(position - *it) + 1;
+    loc.begin  = *it;
+    loc.end    = it + 1 != line_starts.end() ? *(it + 1) - 1 : src.size();
+
+    if(loc.end > loc.begin && src[loc.end - 1] == '\r') {
+        --loc.end;
+    }
+
+    return loc;
+}
+
+
+static std::string_view
+severity_to_string(const diag_severity_t severity) {
+    return severity == DIAG_SEVERITY_ERROR ? "error" : "warning";
+}
+
+
+static std::string
+render_text(const std::vector<Diagnostic>& diagnostics, const DiagSummary& summary, Lexer& lxr, Parser& parser, const bool colored) {
+
+    //
+    // Same layout as Lexer::raise_error, just built up in one string.
+    //
+
+    const std::string_view bold  = colored ? "\x1b[1m"  : "";
+    const std::string_view red   = colored ? "\x1b[91m" : "";
+    const std::string_view reset = colored ? "\x1b[m"   : "";
+
+    const auto  line_starts = get_line_starts(lxr.src_);
+    std::string out;
+
+    for(const auto& diag : diagnostics) {
+        const auto& info    = get_diag_info(diag.code);
+        const auto  loc     = get_source_location(line_starts, lxr.src_, diag.position);
+        const auto  message = fmt("{}: {}", info.severity == DIAG_SEVERITY_ERROR ? "ERROR" : "WARNING", format_diagnostic(diag, parser));
+
+        out += fmt("{}in {}:{}\n{}", bold, lxr.source_file_name_, loc.line, reset);
+        if(loc.begin < loc.end && loc.column - 1 < loc.end - loc.begin) {
+            std::string filler(loc.end - loc.begin, '~');
+            filler[loc.column - 1] = '^';
+
+            out.append(lxr.src_.data() + loc.begin, loc.end - loc.begin);
+            out += '\n';
+            out += filler;
+            out += '\n';
+        }
+
+        out += fmt("{}{}{}\n\n\n{}", red, std::string(loc.column - 1, ' '), message, reset);
+    }
+
+    if(summary.truncated) {
+        out += fmt("{}Maximum error count reached, any further errors were not reported.\n{}", bold, reset);
+    }
+
+    return out;
+}
+
+static std::string
+render_json(const std::vector<Diagnostic>& diagnostics, const DiagSummary& summary, Lexer& lxr, Parser& parser) {
+
+    const auto  line_starts = get_line_starts(lxr.src_);
+    std::string out;
+
+    out += "{\n  \"file\": ";
+    append_json_string(out, lxr.source_file_name_);
+    out += fmt(",\n  \"errors\": {},\n  \"warnings\": {},\n  \"truncated\": {},\n  \"diagnostics\": [",
+        summary.errors, summary.warnings, summary.truncated ? "true" : "false");
+
+    for(size_t i = 0; i < diagnostics.size(); ++i) {
+        const auto& diag = diagnostics[i];
+        const auto& info = get_diag_info(diag.code);
+        const auto  loc  = get_source_location(line_starts, lxr.src_, diag.position);
+
+        out += i == 0 ? "\n    {" : ",\n    {";
+        out += "\"code\": ";
+        append_json_string(out, info.name);
+        out += fmt(", \"severity\": \"{}\", \"offset\": {}, \"line\": {}, \"column\": {}, \"message\": ",
+            severity_to_string(info.severity), diag.position, loc.line, loc.column);
+        append_json_string(out, format_diagnostic(diag, parser));
+        out += "}";
+    }
+
+    out += diagnostics.empty() ? "]\n}\n" : "\n  ]\n}\n";
+    return out;
+}
+
+static std::string
+render_sarif(const std::vector<Diagnostic>& diagnostics, const DiagSummary& summary, Lexer& lxr, Parser& parser) {
+
+    const auto  line_starts = get_line_starts(lxr.src_);
+    std::string out;
+
+    //
+    // Only the rules that actually show up get listed, results point at them by index.
+    //
+
+    std::vector<diag_code_t> rules;
+    std::vector<int32_t>     rule_index(DIAG_CODE_COUNT, -1);
+
+    for(const auto& diag : diagnostics) {
+        if(rule_index[diag.code] == -1) {
+            rule_index[diag.code] = static_cast<int32_t>(rules.size());
+            rules.emplace_back(diag.code);
+        }
+    }
+
+    out += "{\n"
+           "  \"$schema\": \"https://json.schemastore.org/sarif-2.1.0.json\",\n"
+           "  \"version\": \"2.1.0\",\n"
+           "  \"runs\": [{\n"
+           "    \"tool\": {\"driver\": {\"name\": \"tak\", \"rules\": [";
+
+    for(size_t i = 0; i < rules.size(); ++i) {
+        const auto& info = get_diag_info(rules[i]);
+        out += i == 0 ? "\n      {\"id\": " : ",\n      {\"id\": ";
+        append_json_string(out, info.name);
+        out += ", \"shortDescription\": {\"text\": ";
+        append_json_string(out, info.format);
+        out += fmt("}}, \"defaultConfiguration\": {{\"level\": \"{}\"}}}}", severity_to_string(info.severity));
+    }
+
+    out += rules.empty() ? "]}},\n" : "\n    ]}},\n";
+    out += fmt("    \"properties\": {{\"truncated\": {}}},\n", summary.truncated ? "true" : "false");
+    out += "    \"results\": [";
+
+    for(size_t i = 0; i < diagnostics.size(); ++i) {
+        const auto& diag = diagnostics[i];
+        const auto& info = get_diag_info(diag.code);
+        const auto  loc  = get_source_location(line_starts, lxr.src_, diag.position);
+
+        out += i == 0 ? "\n      {\"ruleId\": " : ",\n      {\"ruleId\": ";
+        append_json_string(out, info.name);
+        out += fmt(", \"ruleIndex\": {}, \"level\": \"{}\", \"message\": {{\"text\": ", rule_index[diag.code], severity_to_string(info.severity));
+        append_json_string(out, format_diagnostic(diag, parser));
+        out += "}, \"locations\": [{\"physicalLocation\": {\"artifactLocation\": {\"uri\": ";
+        append_json_string(out, lxr.source_file_name_);
+        out += fmt("}}, \"region\": {{\"startLine\": {}, \"startColumn\": {}, \"charOffset\": {}}}}}}}]}}",
+            loc.line, loc.column, diag.position);
+    }
+
+    out += diagnostics.empty() ? "]\n  }]\n}\n" : "\n    ]\n  }]\n}\n";
+    return out;
+}
+
+
+bool
+tak::emit_diagnostics(
+    const std::vector<Diagnostic>& diagnostics,
+    const DiagSummary& summary,
+    Lexer& lxr,
+    Parser& parser,
+    const diag_format_t format,
+    const std::string& output_path
+) {
+
+    std::string out;
+    switch(format) {
+        case DIAG_FORMAT_TEXT:  out = render_text(diagnostics, summary, lxr, parser, output_path.empty() && output_colors_enabled()); break;
+        case DIAG_FORMAT_JSON:  out = render_json(diagnostics, summary, lxr, parser);  break;
+        case DIAG_FORMAT_SARIF: out = render_sarif(diagnostics, summary, lxr, parser); break;
+        default: panic("emit_diagnostics: invalid format.");
+    }
+
+    if(output_path.empty()) {
+#ifdef TAK_WINDOWS
+        try_enable_windows_virtual_terminal_sequences();
+#endif
+        write_output(out);
+        return true;
+    }
+
+    std::ofstream file(output_path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open() || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("Failed to write diagnostics to {}.", output_path);
+        return false;
+    }
+
+    return true;
+}
@@ -6,7 +6,20 @@
 #include <lexer.hpp>
 #include <parser.hpp>
 #include <checker.hpp>
+#include <driver.hpp>
+#include <image.hpp>
+#include <mem_report.hpp>
+#include <layout.hpp>
+#include <reachability.hpp>
+#include <call_graph.hpp>
+#include <time_report.hpp>
+#include <trace.hpp>
+#include <thread_pool.hpp>
 #include <exception>
+#include <fstream>
+#include <condition_variable>
+#include <mutex>
+#include <sstream>
 
 using namespace tak;
 
@@ -34,8 +47,30 @@ check_leftover_placeholders(Parser& parser, Lexer& lexer) {
     return state;
 }
 
-static bool
-do_parse(Parser& parser, Lexer& lexer) {
+//
+// What a toplevel declaration shows up as in a trace.
+//
+
+static std::string
+toplevel_decl_name(Parser& parser, AstNode* decl) {
+
+    const auto symbol_name = [&](const AstIdentifier* ident) {
+        const auto* sym = parser.lookup_unique_symbol(ident->symbol_index);
+        return sym != nullptr ? sym->name : std::string("<unknown>");
+    };
+
+    if(const auto* proc = dynamic_cast<AstProcdecl*>(decl))         return symbol_name(proc->identifier);
+    if(const auto* var = dynamic_cast<AstVardecl*>(decl))           return symbol_name(var->identifier);
+    if(const auto* nmspace = dynamic_cast<AstNamespaceDecl*>(decl)) return fmt("namespace {}", nmspace->full_path);
+    if(const auto* compose = dynamic_cast<AstComposeDecl*>(decl))   return fmt("compose {}", compose->type_name);
+    if(const auto* structdef = dynamic_cast<AstStructdef*>(decl))   return fmt("struct {}", structdef->name);
+    if(const auto* alias = dynamic_cast<AstTypeAlias*>(decl))       return fmt("alias {}", alias->name);
+
+    return "toplevel declaration";
+}
+
+bool
+tak::do_parse(Parser& parser, Lexer& lexer, TimeReport* times) {
 
     AstNode* toplevel_decl = nullptr;
 
@@ -43,59 +78,286 @@ do_parse(Parser& parser, Lexer& lexer) {
         parser.push_scope(); // global scope
     }
 
-    do {
-        toplevel_decl = parse_expression(parser, lexer, false);
-        if(toplevel_decl == nullptr) {
-            break;
-        }
-        // TODO: verify valid at toplevel
-        parser.toplevel_decls_.emplace_back(toplevel_decl);
-    } while(true);
+    {
+        PhaseTimer timer(times, "parse");
+        TraceScope parse_scope("parse", "parse");
+        do {
+            TraceScope scope("parse", "toplevel declaration");
+            toplevel_decl = parse_expression(parser, lexer, false);
+            if(toplevel_decl == nullptr) {
+                scope.cancel();
+                break;
+            }
+            // TODO: verify valid at toplevel
+            parser.toplevel_decls_.emplace_back(toplevel_decl);
+            if(tracing_enabled()) {
+                scope.set_name(toplevel_decl_name(parser, toplevel_decl));
+            }
+        } while(true);
+    }
+
+    //
+    // Deferred procedure bodies get parsed during checking and still need the global scope.
+    //
 
-    parser.pop_scope();
-    if(lexer.current() != TOKEN_END_OF_FILE || !check_leftover_placeholders(parser, lexer)) {
+    if(!parser.lazy_proc_bodies_) {
+        parser.pop_scope();
+    }
+
+    if(lexer.current() != TOKEN_END_OF_FILE) {
         return false;
     }
 
-    return true;
+    PhaseTimer timer(times, "resolve placeholders");
+    TraceScope scope("parse", "resolve placeholders");
+    return check_leftover_placeholders(parser, lexer);
 }
 
 static bool
-do_check(Parser& parser, Lexer& lexer) {
+do_check(Parser& parser, Lexer& lexer, const CompileOptions& options, TimeReport* times) {
+
+    //
+    // Deferred bodies get parsed while checking, which can't happen off the main thread.
+    //
 
     CheckerContext ctx(lexer, parser);
-    for(const auto& decl : parser.toplevel_decls_) {
-        if(NODE_NEEDS_VISITING(decl->type)) {
-            visit_node(decl, ctx);
+    std::optional<Reachability> reachability;
+
+    if(!options.entry_points.empty()) {
+        PhaseTimer timer(times, "reachability");
+        reachability = compute_reachability(parser, lexer, options.entry_points);
+        if(!reachability) {
+            return false;
         }
     }
 
-    if(ctx.error_count_ > 0) {
-        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("\n{}: BUILD FAILED", lexer.source_file_name_);
-        print<TFG_NONE, TBG_NONE, TSTYLE_NONE>("Finished with {} errors, {} warnings.", ctx.error_count_, ctx.warning_count_);
+    const auto* reachable = reachability ? &reachability->reachable : nullptr;
+    {
+        PhaseTimer timer(times, "check");
+        TraceScope scope("check", "check");
+        if(options.check_threads > 1 && !parser.lazy_proc_bodies_) {
+            visit_toplevel_parallel(ctx, options.check_threads, reachable);
+        } else {
+            visit_toplevel(ctx, reachable);
+        }
+    }
+
+    if(reachability && options.warn_unreachable) {
+        for(const uint32_t symbol_index : reachability->unreachable) {
+            const auto* sym = parser.lookup_unique_symbol(symbol_index);
+            ctx.report(DIAG_UNREACHABLE_DECLARATION, sym->src_pos, sym->name);
+        }
+    }
+
+    if(times != nullptr) {
+        times->diagnostics = ctx.diagnostics_.size();
+    }
+
+    PhaseTimer timer(times, "diagnostics");
+    return emit_checker_diagnostics(ctx, options.diagnostics_format, options.diagnostics_path);
+}
+
+bool
+tak::do_create_ast(Parser& parser, Lexer& lexer, const CompileOptions& options, TimeReport* times) {
+    return do_parse(parser, lexer, times) && do_check(parser, lexer, options, times);
+}
+
+static bool
+compile_file(Parser& parser, Lexer& lexer, const std::string& source_file_name, const CompileOptions& options, TimeReport* times) {
+
+    parser.lazy_proc_bodies_ = options.lazy_proc_bodies;
+    {
+        PhaseTimer timer(times, "read");
+        if(!lexer.init(source_file_name)) {
+            return false;
+        }
+    }
+
+
+    //
+    // If there's an image for this exact source we can skip straight past checking.
+    //
+
+    const uint64_t    source_hash = hash_source({lexer.src_.data(), lexer.src_.size()});
+    const std::string image_path  = get_image_path(source_file_name);
+
+    bool loaded = false;
+    if(options.use_image_cache) {
+        PhaseTimer timer(times, "image load");
+        loaded = load_image_file(image_path, source_hash, parser);
+    }
+
+    if(!loaded) {
+        if(!do_create_ast(parser, lexer, options, times)) {
+            return false;
+        }
+
+        if(options.use_image_cache && options.entry_points.empty()) { // Unreachable bodies were never checked.
+            PhaseTimer timer(times, "image write");
+            write_image_file(parser, source_hash, image_path);
+        }
+    }
+
+    if(options.dumps != DUMP_NONE && !write_dumps(parser, options.dumps, options.dump_format, options.dump_path)) {
         return false;
     }
 
-#ifdef TAK_DEBUG
-    parser.dump_nodes();
-    parser.dump_symbols();
-    parser.dump_types();
-#endif
+    if(options.mem_report) {
+        print_memory_report(collect_memory_report(parser));
+    }
+
+    if(options.layout_report) {
+        print_layout_report(parser);
+    }
+
+    if(!options.call_graph_dot.empty() || !options.call_graph_path.empty()) {
+        PhaseTimer      timer(times, "call graph");
+        const CallGraph graph = build_call_graph(parser);
+        if(!options.call_graph_dot.empty() && !write_call_graph_dot(graph, parser, options.call_graph_dot)) {
+            return false;
+        }
+
+        if(!options.call_graph_path.empty() && !write_call_graph_binary(graph, parser, options.call_graph_path)) {
+            return false;
+        }
+    }
 
     return true;
 }
 
+//
+// Lexing happens on demand while parsing (and while checking, for deferred bodies), so it can't
+// be timed as a phase of its own. Instead the source gets tokenized again in a separate pass.
+// Anything the lexer would complain about has already been reported by the parser.
+//
+
+static void
+measure_lexing(TimeReport& report, const Lexer& lexer) {
+
+    Lexer              scan;
+    std::ostringstream discarded;
+    std::ostream*      previous = &output_stream();
+
+    scan.src_              = lexer.src_;
+    scan.source_file_name_ = lexer.source_file_name_;
+    redirect_output(&discarded);
+
+    {
+        PhaseTimer timer(&report, "lexing (separate pass)");
+        for(scan.advance(1); scan.current() != TOKEN_END_OF_FILE && scan.current() != TOKEN_ILLEGAL; scan.advance(1)) {
+            ++report.tokens;
+        }
+    }
+
+    redirect_output(previous);
+    report.phases.back().nested = true;
+}
+
 static bool
-do_create_ast(Parser& parser, const std::string& source_file_name) {
+emit_time_report(TimeReport& report, Parser& parser, const Lexer& lexer, const CompileOptions& options) {
+
+    measure_lexing(report, lexer);
+    report.bytes    = lexer.src_.size();
+    report.symbols  = parser.sym_table_.size();
+    report.types    = parser.type_table_.size();
+    report.peak_rss = options.jobs > 1 ? 0 : peak_rss_bytes(); // Other files share the process.
+
+    for(auto* decl : parser.toplevel_decls_) {
+        walk_ast(decl, [&](AstNode*) { ++report.nodes; });
+    }
 
-    Lexer lexer;
-    return lexer.init(source_file_name) && do_parse(parser, lexer) && do_check(parser, lexer);
+    if(!options.time_report_json) {
+        print_time_report(report);
+        return true;
+    }
+
+    const std::string json = time_report_json(report);
+    if(options.time_report_path.empty()) {
+        write_output(json);
+        return true;
+    }
+
+    std::ofstream file(options.time_report_path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open() || !file.write(json.data(), static_cast<std::streamsize>(json.size()))) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("Failed to write time report to {}.", options.time_report_path);
+        return false;
+    }
+
+    return true;
 }
 
 bool
-do_compile(const std::string& source_file_name) {
+tak::do_compile(const std::string& source_file_name, const CompileOptions& options) {
 
-    Parser parser;
-    if(!do_create_ast(parser, source_file_name)) return false;
-    return true;
-}
\ No newline at end of file
+    Parser      parser;
+    Lexer       lexer;
+    TimeReport  report;
+    TimeReport* times = options.time_report ? &report : nullptr;
+
+    report.file = source_file_name;
+    TraceScope scope("file", source_file_name);
+
+    const bool compiled = compile_file(parser, lexer, source_file_name, options, times);
+    if(times != nullptr && !emit_time_report(report, parser, lexer, options)) {
+        return false;
+    }
+
+    return compiled;
+}
+
+bool
+tak::do_compile_files(const std::vector<std::string>& source_file_names, const CompileOptions& options) {
+
+    const size_t count  = source_file_names.size();
+    size_t       failed = 0;
+
+    if(options.jobs <= 1 || count <= 1) {
+        for(const auto& name : source_file_names) {
+            failed += !do_compile(name, options);
+        }
+    } else {
+
+        //
+        // Every file gets its own parser and lexer on a pool thread, and writes its output to its own buffer.
+        // Buffers are written out in input order, each one as soon as it and every file before it are done.
+        //
+
+        std::vector<std::ostringstream> outputs(count);
+        std::vector<uint8_t>            results(count, 0);
+        std::vector<uint8_t>            done(count, 0);
+        std::mutex                      done_lock;
+        std::condition_variable         file_done;
+
+        ThreadPool pool(std::min<size_t>(options.jobs, count));
+        for(size_t i = 0; i < count; ++i) {
+            pool.submit([&, i] {
+                redirect_output(&outputs[i]);
+                results[i] = do_compile(source_file_names[i], options);
+                redirect_output(nullptr);
+
+                std::lock_guard lock(done_lock);
+                done[i] = 1;
+                file_done.notify_one();
+            });
+        }
+
+        for(size_t i = 0; i < count; ++i) {
+            {
+                std::unique_lock lock(done_lock);
+                file_done.wait(lock, [&] { return done[i] != 0; });
+            }
+
+            const std::string output = outputs[i].str();
+            write_output(output);
+            failed += !results[i];
+        }
+
+        pool.wait();
+    }
+
+    if(failed != 0 && count > 1) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("{} of {} files failed to compile.", failed, count);
+    }
+
+    return failed == 0;
+}
@@ -0,0 +1,1023 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <incremental.hpp>
+#include <checker.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace tak;
+
+#define FNV_OFFSET_BASIS 0xCBF29CE484222325ULL
+#define FNV_PRIME        0x100000001B3ULL
+
+
+struct LexerState {
+    Token    current;
+    size_t   src_index = 0;
+    uint32_t line      = 1;
+};
+
+struct DeclStash {                                                   // What a declaration owned before the rebuild.
+    std::vector<Symbol>                                          globals;
+    std::vector<std::pair<std::string, std::vector<MemberData>>> data_members;
+    std::vector<std::pair<std::string, TypeData>>                aliases;
+    std::vector<MemberData>                                      methods;
+};
+
+struct ChangeSet {
+    std::unordered_set<uint32_t>    symbols;
+    std::unordered_set<std::string> types;
+    std::unordered_set<std::string> aliases;
+    std::unordered_set<std::string> new_names;                       // Unqualified, see depends_on_changes.
+};
+
+
+static LexerState
+save_lexer(const Lexer& lxr) {
+    return { lxr.current_, lxr.src_index_, lxr.curr_line_ };
+}
+
+static void
+restore_lexer(Lexer& lxr, const LexerState& state) {
+    lxr.current_   = state.current;
+    lxr.src_index_ = state.src_index;
+    lxr.curr_line_ = state.line;
+}
+
+static void
+seek_lexer(Lexer& lxr, const size_t src_pos, const uint32_t line) {
+    lxr.current_   = Token();
+    lxr.src_index_ = src_pos;
+    lxr.curr_line_ = line;
+}
+
+static uint64_t
+hash_token(uint64_t hash, const Token& tok) {
+
+    const auto mix = [&](const uint8_t byte) {
+        hash ^= byte;
+        hash *= FNV_PRIME;
+    };
+
+    for(size_t i = 0; i < sizeof(tok.type); ++i) {
+        mix(static_cast<uint8_t>(static_cast<uint32_t>(tok.type) >> (i * 8)));
+    }
+
+    for(const char c : tok.value) {
+        mix(static_cast<uint8_t>(c));
+    }
+
+    mix(0xFF);
+    return hash;
+}
+
+static bool
+at_end(Lexer& lxr) {
+    return lxr.current() == TOKEN_END_OF_FILE || lxr.current() == TOKEN_ILLEGAL;
+}
+
+static std::string
+unqualified_name(const std::string& name) {
+    const size_t pos = name.find_last_of('\\');
+    return pos == std::string::npos ? name : name.substr(pos + 1);
+}
+
+template<typename T>
+static void
+sort_unique(std::vector<T>& vec) {
+    std::ranges::sort(vec);
+    vec.erase(std::unique(vec.begin(), vec.end()), vec.end());
+}
+
+template<typename T>
+static bool
+contains(const std::vector<T>& vec, const T& value) {
+    return std::ranges::find(vec, value) != vec.end();
+}
+
+
+//
+// Fingerprinting
+//
+
+static tak::DeclFingerprint
+fingerprint_range(Lexer& lxr, const LexerState& begin, const size_t end) {
+
+    const auto after = save_lexer(lxr);
+    restore_lexer(lxr, begin);
+
+    DeclFingerprint fingerprint;
+    fingerprint.key  = FNV_OFFSET_BASIS;
+    fingerprint.hash = FNV_OFFSET_BASIS;
+
+    while(!at_end(lxr) && lxr.current().src_pos < end) {
+        if(fingerprint.token_count < 2) {
+            fingerprint.key = hash_token(fingerprint.key, lxr.current());
+        }
+
+        fingerprint.hash = hash_token(fingerprint.hash, lxr.current());
+        ++fingerprint.token_count;
+        lxr.advance(1);
+    }
+
+    restore_lexer(lxr, after);
+    return fingerprint;
+}
+
+static uint64_t
+candidate_key(Lexer& lxr) {
+    return hash_token(hash_token(FNV_OFFSET_BASIS, lxr.current()), lxr.peek(1));
+}
+
+static bool
+matches_at(Lexer& lxr, const DeclFingerprint& fingerprint) {
+
+    //
+    // On a match the lexer is left on the first token after the declaration.
+    //
+
+    const auto start = save_lexer(lxr);
+    uint64_t   hash  = FNV_OFFSET_BASIS;
+
+    for(uint32_t i = 0; i < fingerprint.token_count; ++i) {
+        if(at_end(lxr)) {
+            restore_lexer(lxr, start);
+            return false;
+        }
+
+        hash = hash_token(hash, lxr.current());
+        lxr.advance(1);
+    }
+
+    if(hash != fingerprint.hash) {
+        restore_lexer(lxr, start);
+        return false;
+    }
+
+    return true;
+}
+
+
+//
+// Type comparison, used to tell whether a reparsed declaration still looks the same from the outside.
+//
+
+static bool
+same_type(const TypeData& first, const TypeData& second) {
+
+    if(first.pointer_depth != second.pointer_depth
+        || first.flags != second.flags
+        || first.kind != second.kind
+        || first.sym_ref != second.sym_ref
+        || first.array_lengths != second.array_lengths) {
+        return false;
+    }
+
+    if(first.kind != TYPE_KIND_PROCEDURE && first.name != second.name) { // Not set consistently for procedures.
+        return false;
+    }
+
+    if((first.parameters == nullptr) != (second.parameters == nullptr)
+        || (first.return_type == nullptr) != (second.return_type == nullptr)) {
+        return false;
+    }
+
+    if(first.parameters != nullptr) {
+        if(first.parameters->size() != second.parameters->size()) {
+            return false;
+        }
+
+        for(size_t i = 0; i < first.parameters->size(); ++i) {
+            if(!same_type((*first.parameters)[i], (*second.parameters)[i])) {
+                return false;
+            }
+        }
+    }
+
+    return first.return_type == nullptr || same_type(*first.return_type, *second.return_type);
+}
+
+static bool
+same_members(const std::vector<MemberData>& first, const std::vector<MemberData>& second) {
+    return std::ranges::equal(first, second, [](const MemberData& lhs, const MemberData& rhs) {
+        return lhs.name == rhs.name && same_type(lhs.type, rhs.type);
+    });
+}
+
+static std::vector<MemberData>
+data_members_of(const UserType& type) {
+    std::vector<MemberData> members;
+    for(const auto& member : type.members) {
+        if(member.type.sym_ref == INVALID_SYMBOL_INDEX) {
+            members.emplace_back(member);
+        }
+    }
+
+    return members;
+}
+
+
+//
+// Records. describe_decl runs right after a declaration gets parsed,
+// collect_used_types after parsing and once more after checking.
+//
+
+static void
+describe_decl(Parser& parser, AstNode* decl, tak::DeclRecord& record) {
+
+    std::vector<uint32_t> referenced;
+
+    walk_ast(decl, [&](AstNode* node) {
+        switch(node->type) {
+            case NODE_VARDECL:
+                record.owned_symbols.emplace_back(dynamic_cast<AstVardecl*>(node)->identifier->symbol_index);
+                break;
+            case NODE_PROCDECL:
+                record.owned_symbols.emplace_back(dynamic_cast<AstProcdecl*>(node)->identifier->symbol_index);
+                break;
+            case NODE_IDENT:
+                referenced.emplace_back(dynamic_cast<AstIdentifier*>(node)->symbol_index);
+                break;
+            case NODE_STRUCT_DEFINITION:
+                record.defined_types.emplace_back(dynamic_cast<AstStructdef*>(node)->name);
+                break;
+            case NODE_TYPE_ALIAS:
+                record.defined_aliases.emplace_back(dynamic_cast<AstTypeAlias*>(node)->name);
+                break;
+            case NODE_COMPOSEDECL:
+                record.composed_type = dynamic_cast<AstComposeDecl*>(node)->type_name;
+                break;
+            default:
+                break;
+        }
+    });
+
+    sort_unique(record.owned_symbols);
+    sort_unique(referenced);
+    sort_unique(record.used_aliases);
+
+    record.used_symbols.clear();
+    std::ranges::set_difference(referenced, record.owned_symbols, std::back_inserter(record.used_symbols));
+
+    for(const uint32_t index : record.owned_symbols) {
+        const auto* sym = parser.lookup_unique_symbol(index);
+        if(sym->flags & SYM_GLOBAL) {
+            record.symbol_interface.emplace_back(*sym);
+        }
+    }
+
+    for(const auto& name : record.defined_types) {
+        const auto* user_t = parser.lookup_type(name);
+        record.type_interface.emplace_back(data_members_of(*user_t));
+        record.layout_interface.emplace_back(user_t->is_packed, user_t->alignment);
+    }
+
+    for(const auto& name : record.defined_aliases) {
+        record.alias_interface.emplace_back(parser.lookup_type_alias(name));
+    }
+}
+
+static void
+collect_type_names(const TypeData& type, std::vector<std::string>& out) {
+
+    if(const auto* name = std::get_if<std::string>(&type.name)) {
+        out.emplace_back(*name);
+    }
+
+    if(type.parameters != nullptr) {
+        for(const auto& param : *type.parameters) {
+            collect_type_names(param, out);
+        }
+    }
+
+    if(type.return_type != nullptr) {
+        collect_type_names(*type.return_type, out);
+    }
+}
+
+static void
+collect_used_types(Parser& parser, AstNode* decl, tak::DeclRecord& record) {
+
+    std::vector<std::string> names = record.defined_types;
+
+    for(const auto& alias : record.alias_interface) {
+        collect_type_names(alias, names);
+    }
+
+    for(const auto* indices : { &record.owned_symbols, &record.used_symbols }) {
+        for(const uint32_t index : *indices) {
+            if(parser.sym_table_.contains(index)) {
+                collect_type_names(parser.sym_table_[index].type, names);
+            }
+        }
+    }
+
+    walk_ast(decl, [&](AstNode* node) {
+        if(node->type == NODE_CAST) {
+            collect_type_names(dynamic_cast<AstCast*>(node)->type, names);
+        } else if(node->type == NODE_SIZEOF) {
+            if(const auto* type = std::get_if<TypeData>(&dynamic_cast<AstSizeof*>(node)->target)) {
+                collect_type_names(*type, names);
+            }
+        }
+    });
+
+
+    //
+    // Member access reaches through nested structs, so follow data members as well.
+    //
+
+    for(size_t i = 0; i < names.size(); ++i) {
+        const auto found = parser.type_table_.find(names[i]);
+        if(found == parser.type_table_.end()) {
+            continue;
+        }
+
+        for(const auto& member : found->second.members) {
+            const auto* member_type = std::get_if<std::string>(&member.type.name);
+            if(member_type != nullptr && !contains(names, *member_type)) {
+                names.emplace_back(*member_type);
+            }
+        }
+    }
+
+    sort_unique(names);
+    record.used_types = std::move(names);
+}
+
+
+//
+// Taking declarations out of the tables and putting them back.
+// A stashed declaration leaves placeholders behind, so that references from other
+// declarations stay valid and a redeclaration of the same name reuses the same symbol index.
+//
+
+static void
+stash_decl(Parser& parser, const tak::DeclRecord& record, DeclStash& stash) {
+
+    for(const uint32_t index : record.owned_symbols) {
+        auto* sym = parser.lookup_unique_symbol(index);
+        if(sym->flags & SYM_GLOBAL) {
+            stash.globals.emplace_back(*sym);
+            sym->flags = SYM_PLACEHOLDER;
+            sym->type  = TypeData();
+        }
+    }
+
+    for(const auto& name : record.defined_types) {
+        auto* type = parser.lookup_type(name);
+        stash.data_members.emplace_back(name, data_members_of(*type));
+        std::erase_if(type->members, [](const MemberData& member) { return member.type.sym_ref == INVALID_SYMBOL_INDEX; });
+        type->reindex_members();
+        type->is_placeholder = true;
+    }
+
+    for(const auto& name : record.defined_aliases) {
+        stash.aliases.emplace_back(name, parser.lookup_type_alias(name));
+        parser.type_aliases_.erase(name);
+    }
+
+    if(!record.composed_type.empty() && parser.type_exists(record.composed_type)) {
+        auto* type = parser.lookup_type(record.composed_type);
+        std::erase_if(type->members, [&](const MemberData& member) {
+            if(member.type.sym_ref != INVALID_SYMBOL_INDEX && contains(record.owned_symbols, member.type.sym_ref)) {
+                stash.methods.emplace_back(member);
+                return true;
+            }
+            return false;
+        });
+
+        type->reindex_members();
+    }
+}
+
+static void
+erase_locals(Parser& parser, const tak::DeclRecord& record) {
+    for(const uint32_t index : record.owned_symbols) {
+        if(const auto found = parser.sym_table_.find(index);
+            found != parser.sym_table_.end() && !(found->second.flags & (SYM_GLOBAL | SYM_PLACEHOLDER))) {
+            parser.sym_table_.erase(found);
+        }
+    }
+}
+
+static bool
+can_unstash(Parser& parser, const DeclStash& stash) {
+
+    //
+    // Something else might have claimed these names since the stash (a duplicated declaration, for example).
+    // In that case the declaration gets reparsed so the usual redeclaration errors show up.
+    //
+
+    for(const auto& sym : stash.globals) {
+        if(!(parser.lookup_unique_symbol(sym.symbol_index)->flags & SYM_PLACEHOLDER)) {
+            return false;
+        }
+    }
+
+    for(const auto& [name, _] : stash.data_members) {
+        if(!parser.type_exists(name) || !parser.lookup_type(name)->is_placeholder) {
+            return false;
+        }
+    }
+
+    for(const auto& [name, _] : stash.aliases) {
+        if(parser.type_alias_exists(name)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void
+unstash_decl(Parser& parser, AstNode* decl, tak::DeclRecord& record, DeclStash& stash, const size_t begin, const uint32_t line) {
+
+    const auto pos_delta  = static_cast<int64_t>(begin) - static_cast<int64_t>(record.begin);
+    const auto line_delta = static_cast<int64_t>(line)  - static_cast<int64_t>(record.line);
+
+    const auto relocate = [&](Symbol& sym) {
+        sym.src_pos     = static_cast<size_t>(static_cast<int64_t>(sym.src_pos) + pos_delta);
+        sym.line_number = static_cast<uint32_t>(static_cast<int64_t>(sym.line_number) + line_delta);
+    };
+
+    for(auto& sym : stash.globals) {
+        relocate(sym);
+        parser.sym_table_[sym.symbol_index] = std::move(sym);
+    }
+
+    for(const uint32_t index : record.owned_symbols) {
+        auto& sym = parser.sym_table_[index];
+        if(!(sym.flags & SYM_GLOBAL)) {
+            relocate(sym);
+        }
+    }
+
+    for(auto& [name, members] : stash.data_members) {
+        auto* type = parser.lookup_type(name);
+        type->members.insert(type->members.begin(), members.begin(), members.end());
+        type->reindex_members();
+        type->is_placeholder = false;
+    }
+
+    for(auto& [name, type] : stash.aliases) {
+        parser.create_type_alias(name, type);
+    }
+
+    if(!stash.methods.empty()) {
+        if(!parser.type_exists(record.composed_type)) {
+            parser.create_placeholder_type(record.composed_type, begin, line);
+        }
+
+        auto* type = parser.lookup_type(record.composed_type);
+        type->members.insert(type->members.end(), stash.methods.begin(), stash.methods.end());
+        type->reindex_members();
+    }
+
+    if(pos_delta != 0) {
+        walk_ast(decl, [&](AstNode* node) {
+            node->pos = static_cast<size_t>(static_cast<int64_t>(node->pos) + pos_delta);
+        });
+    }
+
+    record.begin = begin;
+    record.line  = line;
+}
+
+
+//
+// Dependency tracking
+//
+
+static bool
+is_constant_variable(const Symbol& sym) {
+
+    //
+    // Constants and enum members are folded into whatever uses them, and the value
+    // they fold to isn't known until checking. Users get reparsed whenever they are.
+    //
+
+    return sym.type.kind == TYPE_KIND_VARIABLE && sym.type.flags & TYPE_CONSTANT;
+}
+
+static void
+record_changes(Parser& parser, const tak::DeclRecord& old, ChangeSet& changes) {
+
+    for(const auto& before : old.symbol_interface) {
+        const auto* now = parser.lookup_unique_symbol(before.symbol_index);
+        if(now->flags & SYM_PLACEHOLDER
+            || before.type.flags & TYPE_INFERRED   // the real type only exists after checking.
+            || is_constant_variable(before)        // same for the folded value.
+            || now->flags != before.flags
+            || !same_type(now->type, before.type)) {
+            changes.symbols.emplace(before.symbol_index);
+        }
+    }
+
+    for(size_t i = 0; i < old.defined_types.size(); ++i) {
+        const auto& name = old.defined_types[i];
+        if(!parser.type_exists(name)
+            || parser.lookup_type(name)->is_placeholder
+            || !same_members(data_members_of(*parser.lookup_type(name)), old.type_interface[i])
+            || std::make_pair(parser.lookup_type(name)->is_packed, parser.lookup_type(name)->alignment) != old.layout_interface[i]) {
+            changes.types.emplace(name);
+        }
+    }
+
+    for(size_t i = 0; i < old.defined_aliases.size(); ++i) {
+        const auto& name = old.defined_aliases[i];
+        if(!parser.type_alias_exists(name) || !same_type(parser.lookup_type_alias(name), old.alias_interface[i])) {
+            changes.aliases.emplace(name);
+        }
+    }
+}
+
+static void
+record_new_names(const tak::DeclRecord& record, const std::unordered_set<std::string>& old_names, ChangeSet& changes) {
+
+    //
+    // Name resolution walks outwards through namespaces, so a new name can shadow
+    // an existing one wherever the unqualified names match.
+    //
+
+    const auto check = [&](const std::string& name) {
+        if(!old_names.contains(name)) {
+            changes.new_names.emplace(unqualified_name(name));
+        }
+    };
+
+    for(const auto& sym : record.symbol_interface) { check(sym.name); }
+    for(const auto& name : record.defined_types)   { check(name); }
+    for(const auto& name : record.defined_aliases) { check(name); }
+}
+
+static bool
+depends_on_changes(Parser& parser, const tak::DeclRecord& record, const ChangeSet& changes) {
+
+    for(const uint32_t index : record.used_symbols) {
+        if(changes.symbols.contains(index)) {
+            return true;
+        }
+
+        if(!changes.new_names.empty() && parser.sym_table_.contains(index)
+            && changes.new_names.contains(unqualified_name(parser.sym_table_[index].name))) {
+            return true;
+        }
+    }
+
+    for(const auto& name : record.used_types) {
+        if(changes.types.contains(name) || changes.new_names.contains(unqualified_name(name))) {
+            return true;
+        }
+    }
+
+    for(const auto& name : record.used_aliases) {
+        if(changes.aliases.contains(name) || changes.new_names.contains(unqualified_name(name))) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+//
+// Parsing
+//
+
+static AstNode*
+parse_toplevel_decl(Parser& parser, Lexer& lxr, tak::DeclRecord& record) {
+
+    const auto  start = save_lexer(lxr);
+    const Token first = lxr.current();
+
+    parser.alias_log_ = &record.used_aliases;
+    AstNode* decl     = parse_expression(parser, lxr, false);
+    parser.alias_log_ = nullptr;
+
+    if(decl == nullptr) {
+        return nullptr;
+    }
+
+    record.begin       = first.src_pos;
+    record.line        = first.line;
+    record.fingerprint = fingerprint_range(lxr, start, lxr.current().src_pos);
+
+    describe_decl(parser, decl, record);
+    collect_used_types(parser, decl, record);    // Again after checking, once inferred types are known.
+    return decl;
+}
+
+static std::pair<size_t, uint32_t>
+find_first_usage(Lexer& lxr, const tak::DeclRecord& record, const std::string_view name) {
+
+    const auto state = save_lexer(lxr);
+    seek_lexer(lxr, record.begin, record.line);
+
+    std::pair<size_t, uint32_t> usage = { record.begin, record.line };
+    for(uint32_t i = 0; i < record.fingerprint.token_count && !at_end(lxr); ++i) {
+        if(lxr.current().value == name) {
+            usage = { lxr.current().src_pos, lxr.current().line };
+            break;
+        }
+
+        lxr.advance(1);
+    }
+
+    restore_lexer(lxr, state);
+    return usage;
+}
+
+static bool
+resolve_leftover_placeholders(IncrementalUnit& unit, Lexer& lxr) {
+
+    //
+    // Placeholders left behind by declarations that were removed are fine as long as nothing refers to them.
+    // Anything else is the same error the regular build would give.
+    //
+
+    static constexpr std::string_view msg = "Failed to resolve {} \"{}\", first usage is here.";
+
+    auto& parser = unit.parser_;
+    bool  state  = true;
+
+    auto& globals = parser.scope_stack_.front();
+    for(auto it = globals.begin(); it != globals.end();) {
+        const auto* sym = parser.lookup_unique_symbol(it->second);
+        if(!(sym->flags & SYM_PLACEHOLDER)) {
+            ++it;
+            continue;
+        }
+
+        const auto user = std::ranges::find_if(unit.records_, [&](const DeclRecord& record) {
+            return contains(record.used_symbols, sym->symbol_index);
+        });
+
+        if(user == unit.records_.end()) {
+            parser.sym_table_.erase(sym->symbol_index);
+            it = globals.erase(it);
+            continue;
+        }
+
+        const auto [pos, line] = find_first_usage(lxr, *user, unqualified_name(sym->name));
+        lxr.raise_error(fmt(msg, "symbol", sym->name), pos, line);
+        state = false;
+        ++it;
+    }
+
+    for(auto it = parser.type_table_.begin(); it != parser.type_table_.end();) {
+        if(!it->second.is_placeholder) {
+            ++it;
+            continue;
+        }
+
+        const auto user = std::ranges::find_if(unit.records_, [&](const DeclRecord& record) {
+            return contains(record.used_types, it->first);
+        });
+
+        if(user == unit.records_.end() && it->second.members.empty()) {
+            it = parser.type_table_.erase(it);
+            continue;
+        }
+
+        if(user != unit.records_.end()) {
+            const auto [pos, line] = find_first_usage(lxr, *user, unqualified_name(it->first));
+            lxr.raise_error(fmt(msg, "type", it->first), pos, line);
+        } else {
+            lxr.raise_error(fmt(msg, "type", it->first), it->second.pos_first_used, it->second.line_first_used);
+        }
+
+        state = false;
+        ++it;
+    }
+
+    return state;
+}
+
+
+static void
+compact_node_constants(IncrementalUnit& unit) {
+
+    //
+    // Constants of dropped declarations stay in the table until this runs, so it only does once the
+    // table has doubled since last time. Live constants are renumbered in declaration order.
+    //
+
+    auto& parser = unit.parser_;
+    if(parser.node_constants_.size() <= std::max<size_t>(unit.live_constants_ * 2, 1024)) {
+        return;
+    }
+
+    std::vector<ConstantValue> live;
+    live.reserve(unit.live_constants_);
+
+    for(auto* decl : parser.toplevel_decls_) {
+        walk_ast(decl, [&](AstNode* node) {
+            if(const auto* value = parser.lookup_node_constant(node)) {
+                live.emplace_back(*value);
+                node->const_id = static_cast<uint32_t>(live.size());
+            }
+        });
+    }
+
+    parser.node_constants_ = std::move(live);
+    unit.live_constants_   = parser.node_constants_.size();
+}
+
+
+void
+tak::reset_incremental_unit(IncrementalUnit& unit) {
+
+    auto& parser = unit.parser_;
+    for(const auto* decl : parser.toplevel_decls_) {
+        delete decl;
+    }
+
+    parser.toplevel_decls_.clear();
+    parser.sym_table_.clear();
+    parser.type_table_.clear();
+    parser.type_aliases_.clear();
+    parser.node_types_.clear();
+    parser.node_type_ids_.clear();
+    parser.node_constants_.clear();
+    parser.type_layouts_.clear();
+    parser.scope_stack_.clear();
+    parser.namespace_stack_.clear();
+    parser.curr_sym_index_ = INVALID_SYMBOL_INDEX;
+
+    unit.records_.clear();
+    unit.live_constants_ = 0;
+}
+
+bool
+tak::incremental_build(IncrementalUnit& unit, Lexer& lxr, const SourceEdit* edit) {
+
+    auto& parser = unit.parser_;
+    assert(!parser.lazy_proc_bodies_);
+
+    unit.stats_ = IncrementalStats();
+    unit.diagnostics_.clear();
+    parser.type_layouts_.clear();
+    if(parser.scope_stack_.empty()) {
+        parser.push_scope(); // global scope
+    }
+
+    std::vector<AstNode*>   old_decls   = std::move(parser.toplevel_decls_);
+    std::vector<DeclRecord> old_records = std::move(unit.records_);
+    std::vector<DeclStash>  stashes(old_records.size());
+    std::vector<bool>       consumed(old_records.size(), false);
+    std::vector<bool>       needs_check;
+
+    parser.toplevel_decls_.clear();
+    unit.records_.clear();
+
+
+    //
+    // With an edit, clean declarations that end before it stay where they are and never leave the tables.
+    // Clean declarations after it are expected at their old position moved by the size difference.
+    //
+
+    size_t                             kept      = 0;
+    int64_t                            pos_delta = 0;
+    std::unordered_map<size_t, size_t> shifted;
+
+    if(edit != nullptr) {
+        pos_delta = static_cast<int64_t>(edit->new_end) - static_cast<int64_t>(edit->old_end);
+        while(kept + 1 < old_records.size() && old_records[kept + 1].begin <= edit->begin && old_records[kept].check_clean) {
+            ++kept;
+        }
+
+        for(size_t i = kept; i < old_records.size(); ++i) {
+            if(old_records[i].begin >= edit->old_end && old_records[i].check_clean) {
+                shifted.emplace(static_cast<size_t>(static_cast<int64_t>(old_records[i].begin) + pos_delta), i);
+            }
+        }
+    }
+
+
+    //
+    // Take every other previous declaration out of the tables. Reused ones get put back
+    // once the scan reaches them, which keeps the order of declarations intact.
+    //
+
+    std::unordered_multimap<uint64_t, size_t> candidates;
+    std::unordered_set<std::string>           old_names;
+
+    for(size_t i = 0; i < old_records.size(); ++i) {
+        if(i >= kept) {
+            stash_decl(parser, old_records[i], stashes[i]);
+            if(old_records[i].check_clean) {
+                candidates.emplace(old_records[i].fingerprint.key, i);
+            }
+        }
+
+        for(const auto& sym : old_records[i].symbol_interface) { old_names.emplace(sym.name); }
+        for(const auto& name : old_records[i].defined_types)   { old_names.emplace(name); }
+        for(const auto& name : old_records[i].defined_aliases) { old_names.emplace(name); }
+    }
+
+    for(size_t i = 0; i < kept; ++i) {
+        parser.toplevel_decls_.emplace_back(old_decls[i]);
+        unit.records_.emplace_back(std::move(old_records[i]));
+        needs_check.emplace_back(false);
+        consumed[i] = true;
+        ++unit.stats_.reused;
+    }
+
+    if(kept > 0) {
+        seek_lexer(lxr, old_records[kept].begin, old_records[kept].line);
+    }
+
+    const auto fail = [&] {
+        for(size_t i = 0; i < old_decls.size(); ++i) {
+            if(!consumed[i]) { delete old_decls[i]; }
+        }
+
+        reset_incremental_unit(unit);
+        return false;
+    };
+
+
+    //
+    // Scan the new source.
+    //
+
+    while(!at_end(lxr)) {
+
+        const Token first  = lxr.current();
+        bool        reused = false;
+
+        if(const auto found = shifted.find(first.src_pos); found != shifted.end()) {
+            const size_t index = found->second;
+            if(!consumed[index] && can_unstash(parser, stashes[index])) {
+
+                //
+                // Skip over the declaration, the next token is wherever the next one begins.
+                //
+
+                const int64_t line_delta = static_cast<int64_t>(first.line) - static_cast<int64_t>(old_records[index].line);
+                if(index + 1 < old_records.size()) {
+                    seek_lexer(lxr,
+                        static_cast<size_t>(static_cast<int64_t>(old_records[index + 1].begin) + pos_delta),
+                        static_cast<uint32_t>(static_cast<int64_t>(old_records[index + 1].line) + line_delta)
+                    );
+                } else {
+                    seek_lexer(lxr, lxr.src_.size(), first.line);
+                }
+
+                unstash_decl(parser, old_decls[index], old_records[index], stashes[index], first.src_pos, first.line);
+                parser.toplevel_decls_.emplace_back(old_decls[index]);
+                unit.records_.emplace_back(std::move(old_records[index]));
+                needs_check.emplace_back(false);
+
+                consumed[index] = true;
+                ++unit.stats_.reused;
+                continue;
+            }
+        }
+
+        const auto [cand_begin, cand_end] = candidates.equal_range(candidate_key(lxr));
+        for(auto it = cand_begin; it != cand_end; ++it) {
+            const size_t index = it->second;
+            if(consumed[index] || !can_unstash(parser, stashes[index]) || !matches_at(lxr, old_records[index].fingerprint)) {
+                continue;
+            }
+
+            unstash_decl(parser, old_decls[index], old_records[index], stashes[index], first.src_pos, first.line);
+            parser.toplevel_decls_.emplace_back(old_decls[index]);
+            unit.records_.emplace_back(std::move(old_records[index]));
+            needs_check.emplace_back(false);
+
+            consumed[index] = true;
+            reused          = true;
+            ++unit.stats_.reused;
+            break;
+        }
+
+        if(reused) {
+            continue;
+        }
+
+        DeclRecord record;
+        AstNode*   decl = parse_toplevel_decl(parser, lxr, record);
+        if(decl == nullptr) {
+            return fail();
+        }
+
+        parser.toplevel_decls_.emplace_back(decl);
+        unit.records_.emplace_back(std::move(record));
+        needs_check.emplace_back(true);
+        ++unit.stats_.reparsed;
+    }
+
+    if(lxr.current() != TOKEN_END_OF_FILE) {
+        return fail();
+    }
+
+
+    //
+    // Whatever wasn't reused is gone. Collect what changed compared to the previous build.
+    //
+
+    ChangeSet changes;
+    for(size_t i = 0; i < old_records.size(); ++i) {
+        if(consumed[i]) {
+            continue;
+        }
+
+        record_changes(parser, old_records[i], changes);
+        erase_locals(parser, old_records[i]);
+        delete old_decls[i];
+        ++unit.stats_.dropped;
+    }
+
+    for(size_t i = 0; i < unit.records_.size(); ++i) {
+        if(needs_check[i]) {
+            record_new_names(unit.records_[i], old_names, changes);
+        }
+    }
+
+
+    //
+    // Reparse reused declarations that depend on something that changed.
+    // That can change more things, so repeat until nothing else is affected.
+    //
+
+    const LexerState end_state = save_lexer(lxr);
+    bool             repeat    = !changes.symbols.empty() || !changes.types.empty() || !changes.aliases.empty() || !changes.new_names.empty();
+
+    while(repeat) {
+        repeat = false;
+        for(size_t i = 0; i < unit.records_.size(); ++i) {
+            if(needs_check[i] || !depends_on_changes(parser, unit.records_[i], changes)) {
+                continue;
+            }
+
+            DeclRecord old = std::move(unit.records_[i]);
+            DeclStash  discard;
+
+            stash_decl(parser, old, discard);
+            erase_locals(parser, old);
+            delete parser.toplevel_decls_[i];
+            parser.toplevel_decls_[i] = nullptr;
+
+            seek_lexer(lxr, old.begin, old.line);
+            DeclRecord record;
+            AstNode*   decl = parse_toplevel_decl(parser, lxr, record);
+            if(decl == nullptr) {
+                parser.toplevel_decls_.erase(parser.toplevel_decls_.begin() + static_cast<std::ptrdiff_t>(i));
+                return fail();
+            }
+
+            parser.toplevel_decls_[i] = decl;
+            unit.records_[i]          = std::move(record);
+            needs_check[i]            = true;
+
+            record_changes(parser, old, changes);
+            --unit.stats_.reused;
+            ++unit.stats_.invalidated;
+            repeat = true;
+        }
+    }
+
+    restore_lexer(lxr, end_state);
+    if(!resolve_leftover_placeholders(unit, lxr)) {
+        return false;
+    }
+
+
+    //
+    // Check whatever got parsed this time around.
+    //
+
+    CheckerContext ctx(lxr, parser);
+    for(size_t i = 0; i < parser.toplevel_decls_.size() && !ctx.truncated_; ++i) {
+        if(!needs_check[i]) {
+            continue;
+        }
+
+        auto*          decl        = parser.toplevel_decls_[i];
+        const uint32_t errors      = ctx.error_count_;
+        const size_t   diagnostics = ctx.diagnostics_.size();
+
+        if(NODE_NEEDS_VISITING(decl->type)) {
+            visit_node(decl, ctx);
+        }
+
+        //
+        // Warnings count as well, a reused declaration wouldn't report them again.
+        //
+
+        unit.records_[i].check_clean = ctx.error_count_ == errors && ctx.diagnostics_.size() == diagnostics;
+        collect_used_types(parser, decl, unit.records_[i]);
+    }
+
+    compact_node_constants(unit);
+
+    const bool state  = emit_checker_diagnostics(ctx, DIAG_FORMAT_TEXT);
+    unit.diagnostics_ = std::move(ctx.diagnostics_);
+    return state;
+}
@@ -3,8 +3,138 @@
 //
 
 #include <io.hpp>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+
 #ifdef TAK_WINDOWS
 #include <Windows.h>
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+//
+// Each thread can send its output somewhere else, so that files compiled at the same time
+// don't interleave their errors. The driver collects them and writes them out in order.
+//
+// Output that isn't redirected goes into one shared buffer that gets written to the stdout file
+// descriptor directly, in large chunks. Each print or stream write is appended under a lock,
+// so a line always lands in one piece. When stdout is a terminal the buffer is written out after
+// every call instead, so the user still sees output as it happens.
+//
+
+static thread_local std::ostream* thread_output = nullptr;
+static std::atomic<uint8_t>       color_mode    = tak::COLOR_AUTO;
+
+class StdoutWriter final : public std::streambuf {
+public:
+
+    static constexpr size_t flush_threshold = 64 * 1024;
+
+    StdoutWriter() {
+#ifdef TAK_WINDOWS
+        is_terminal_ = _isatty(_fileno(stdout)) != 0;
+#else
+        is_terminal_ = isatty(STDOUT_FILENO) != 0;
+#endif
+        buffer_.reserve(flush_threshold);
+    }
+
+    void write(const std::string_view text) {
+        std::lock_guard lock(lock_);
+        buffer_.append(text);
+        if(is_terminal_ || buffer_.size() >= flush_threshold) {
+            flush_locked();
+        }
+    }
+
+    void flush() {
+        std::lock_guard lock(lock_);
+        flush_locked();
+    }
+
+    bool is_terminal() const {
+        return is_terminal_;
+    }
+
+protected:
+
+    std::streamsize xsputn(const char* data, const std::streamsize size) override {
+        write(std::string_view(data, static_cast<size_t>(size)));
+        return size;
+    }
+
+    int_type overflow(const int_type ch) override {
+        if(!traits_type::eq_int_type(ch, traits_type::eof())) {
+            const char c = traits_type::to_char_type(ch);
+            write(std::string_view(&c, 1));
+        }
+
+        return traits_type::not_eof(ch);
+    }
+
+    int sync() override {
+        flush();
+        return 0;
+    }
+
+private:
+
+    void flush_locked() {
+        const char* data      = buffer_.data();
+        size_t      remaining = buffer_.size();
+
+        while(remaining > 0) {
+#ifdef TAK_WINDOWS
+            const size_t written = std::fwrite(data, 1, remaining, stdout);
+            if(written == 0) break;
+#else
+            const ssize_t written = ::write(STDOUT_FILENO, data, remaining);
+            if(written < 0 && errno == EINTR) continue;
+            if(written <= 0) break;
+#endif
+            data      += written;
+            remaining -= static_cast<size_t>(written);
+        }
+
+#ifdef TAK_WINDOWS
+        std::fflush(stdout);
+#endif
+        buffer_.clear();
+    }
+
+    std::mutex  lock_;
+    std::string buffer_;
+    bool        is_terminal_ = false;
+};
+
+static StdoutWriter&
+stdout_writer() {
+
+    //
+    // Never destroyed, other static destructors and worker threads may still print on the way out.
+    // Whatever is left in the buffer gets written by the atexit handler.
+    //
+
+    static StdoutWriter* writer = [] {
+        auto* created = new StdoutWriter();
+        std::atexit([] { stdout_writer().flush(); });
+        return created;
+    }();
+
+    return *writer;
+}
+
+static std::ostream&
+stdout_stream() {
+    static std::ostream* stream = new std::ostream(&stdout_writer());
+    return *stream;
+}
+
+#ifdef TAK_WINDOWS
 static bool win_virtual_sequences_enabled = false;
 
 
@@ -29,6 +159,10 @@ tak::try_enable_windows_virtual_terminal_sequences() {
 
 void
 tak::term_set_fg(const termcolor_fg_t foreground) {
+    if(!output_colors_enabled()) {
+        return;
+    }
+
 #ifdef TAK_WINDOWS
     if(!win_virtual_sequences_enabled) {
         try_enable_windows_virtual_terminal_sequences();
@@ -38,11 +172,15 @@ tak::term_set_fg(const termcolor_fg_t foreground) {
     if(foreground == TFG_NONE) {
         return;
     }
-    std::cout << fmt("\x1b[{}m", std::to_string(foreground));
+    write_output(fmt("\x1b[{}m", static_cast<uint16_t>(foreground)));
 }
 
 void
 tak::term_set_bg(const termcolor_bg_t background) {
+    if(!output_colors_enabled()) {
+        return;
+    }
+
 #ifdef TAK_WINDOWS
     if(!win_virtual_sequences_enabled) {
         try_enable_windows_virtual_terminal_sequences();
@@ -52,11 +190,15 @@ tak::term_set_bg(const termcolor_bg_t background) {
     if(background == TBG_NONE) {
         return;
     }
-    std::cout << fmt("\x1b[{}m", std::to_string(background));
+    write_output(fmt("\x1b[{}m", static_cast<uint16_t>(background)));
 }
 
 void
 tak::term_set_style(const uint16_t style_mask) {
+    if(!output_colors_enabled()) {
+        return;
+    }
+
 #ifdef TAK_WINDOWS
     if(!win_virtual_sequences_enabled) {
         try_enable_windows_virtual_terminal_sequences();
@@ -67,19 +209,99 @@ tak::term_set_style(const uint16_t style_mask) {
         return;
     }
 
-    if(style_mask & TSTYLE_BOLD)      std::cout << "\x1b[1m";
-    if(style_mask & TSTYLE_ITALIC)    std::cout << "\x1b[3m";
-    if(style_mask & TSTYLE_UNDERLINE) std::cout << "\x1b[4m";
+    std::string codes;
+    append_term_codes(codes, TFG_NONE, TBG_NONE, style_mask);
+    write_output(codes);
 }
 
 void
 tak::term_reset() {
+    if(!output_colors_enabled()) {
+        return;
+    }
 #ifdef TAK_WINDOWS
     if(!win_virtual_sequences_enabled) {
         return;
     }
 #endif
-    std::cout << "\x1b[m";
+    write_output("\x1b[m");
+}
+
+void
+tak::append_term_codes(std::string& out, const termcolor_fg_t foreground, const termcolor_bg_t background, const uint16_t style_mask) {
+#ifdef TAK_WINDOWS
+    if(!win_virtual_sequences_enabled) {
+        try_enable_windows_virtual_terminal_sequences();
+    }
+#endif
+
+    if(foreground != TFG_NONE) std::format_to(std::back_inserter(out), "\x1b[{}m", static_cast<uint16_t>(foreground));
+    if(background != TBG_NONE) std::format_to(std::back_inserter(out), "\x1b[{}m", static_cast<uint16_t>(background));
+
+    if(style_mask & TSTYLE_BOLD)      out += "\x1b[1m";
+    if(style_mask & TSTYLE_ITALIC)    out += "\x1b[3m";
+    if(style_mask & TSTYLE_UNDERLINE) out += "\x1b[4m";
+}
+
+void
+tak::set_color_mode(const color_mode_t mode) {
+    color_mode.store(mode, std::memory_order_relaxed);
 }
 
+bool
+tak::output_colors_enabled() {
+
+    static const bool terminal_wants_color = [] {
+        const char* no_color = std::getenv("NO_COLOR");
+        return stdout_writer().is_terminal() && (no_color == nullptr || no_color[0] == '\0');
+    }();
 
+    switch(color_mode.load(std::memory_order_relaxed)) {
+        case COLOR_ALWAYS: return true;
+        case COLOR_NEVER:  return false;
+        default:           return terminal_wants_color;
+    }
+}
+
+std::ostream&
+tak::output_stream() {
+    return thread_output != nullptr ? *thread_output : stdout_stream();
+}
+
+void
+tak::write_output(const std::string_view text) {
+    if(thread_output != nullptr) {
+        thread_output->write(text.data(), static_cast<std::streamsize>(text.size()));
+        return;
+    }
+
+    stdout_writer().write(text);
+}
+
+void
+tak::flush_output() {
+    stdout_writer().flush();
+}
+
+void
+tak::write_panic(const std::string_view text) {
+
+    //
+    // A redirected thread's output is only written out once it's done, which a panic never is.
+    //
+
+    flush_output();
+    std::fwrite(text.data(), 1, text.size(), stderr);
+    std::fflush(stderr);
+}
+
+std::string&
+tak::format_buffer() {
+    static thread_local std::string buffer;
+    return buffer;
+}
+
+void
+tak::redirect_output(std::ostream* stream) {
+    thread_output = stream;
+}
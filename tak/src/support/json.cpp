@@ -0,0 +1,300 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <json.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+#define MAX_JSON_DEPTH 256
+
+using namespace tak;
+
+
+static const JsonValue null_value;
+
+const JsonValue&
+tak::JsonValue::operator[](const std::string_view key) const {
+    for(const auto& [name, value] : members) {
+        if(name == key) return value;
+    }
+
+    return null_value;
+}
+
+bool
+tak::JsonValue::has(const std::string_view key) const {
+    return std::ranges::any_of(members, [&](const auto& member) { return member.first == key; });
+}
+
+int64_t
+tak::JsonValue::as_integer(const int64_t otherwise) const {
+    return kind == JSON_NUMBER ? static_cast<int64_t>(number) : otherwise;
+}
+
+std::string_view
+tak::JsonValue::as_string() const {
+    return kind == JSON_STRING ? std::string_view(string) : std::string_view();
+}
+
+
+//
+// Reading
+//
+
+struct JsonReader {
+    std::string_view text;
+    size_t           pos = 0;
+
+    void skip_whitespace() {
+        while(pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r')) {
+            ++pos;
+        }
+    }
+
+    bool consume(const std::string_view word) {
+        if(text.substr(pos, word.size()) != word) return false;
+        pos += word.size();
+        return true;
+    }
+};
+
+static void
+append_utf8(std::string& out, const uint32_t codepoint) {
+    if(codepoint < 0x80) {
+        out += static_cast<char>(codepoint);
+    } else if(codepoint < 0x800) {
+        out += static_cast<char>(0xC0 | codepoint >> 6);
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if(codepoint < 0x10000) {
+        out += static_cast<char>(0xE0 | codepoint >> 12);
+        out += static_cast<char>(0x80 | (codepoint >> 6 & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | codepoint >> 18);
+        out += static_cast<char>(0x80 | (codepoint >> 12 & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint >> 6 & 0x3F));
+        out += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+}
+
+static bool
+read_hex4(JsonReader& reader, uint32_t& out) {
+    if(reader.text.size() - reader.pos < 4) {
+        return false;
+    }
+
+    const char* begin = reader.text.data() + reader.pos;
+    const auto  [ptr, error] = std::from_chars(begin, begin + 4, out, 16);
+
+    reader.pos += 4;
+    return error == std::errc() && ptr == begin + 4;
+}
+
+static bool
+read_string(JsonReader& reader, std::string& out) {
+
+    ++reader.pos; // opening quote
+    while(reader.pos < reader.text.size()) {
+        const char c = reader.text[reader.pos++];
+        if(c == '"') {
+            return true;
+        }
+
+        if(c != '\\') {
+            out += c;
+            continue;
+        }
+
+        if(reader.pos >= reader.text.size()) {
+            return false;
+        }
+
+        switch(reader.text[reader.pos++]) {
+            case '"':  out += '"';  break;
+            case '\\': out += '\\'; break;
+            case '/':  out += '/';  break;
+            case 'b':  out += '\b'; break;
+            case 'f':  out += '\f'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case 'u': {
+                uint32_t codepoint = 0;
+                if(!read_hex4(reader, codepoint)) {
+                    return false;
+                }
+
+                if(codepoint >= 0xD800 && codepoint < 0xDC00 && reader.consume("\\u")) {
+                    uint32_t low = 0;
+                    if(!read_hex4(reader, low) || low < 0xDC00 || low >= 0xE000) {
+                        return false;
+                    }
+
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+
+                append_utf8(out, codepoint);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    return false;
+}
+
+static bool
+read_value(JsonReader& reader, JsonValue& out, const uint32_t depth) {
+
+    if(depth > MAX_JSON_DEPTH) {
+        return false;
+    }
+
+    reader.skip_whitespace();
+    if(reader.pos >= reader.text.size()) {
+        return false;
+    }
+
+    const char c = reader.text[reader.pos];
+    if(c == '"') {
+        out.kind = JSON_STRING;
+        return read_string(reader, out.string);
+    }
+
+    if(c == '{') {
+        out.kind = JSON_OBJECT;
+        ++reader.pos;
+        reader.skip_whitespace();
+        if(reader.consume("}")) {
+            return true;
+        }
+
+        do {
+            reader.skip_whitespace();
+            auto& [name, value] = out.members.emplace_back();
+            if(reader.pos >= reader.text.size() || reader.text[reader.pos] != '"' || !read_string(reader, name)) {
+                return false;
+            }
+
+            reader.skip_whitespace();
+            if(!reader.consume(":") || !read_value(reader, value, depth + 1)) {
+                return false;
+            }
+
+            reader.skip_whitespace();
+        } while(reader.consume(","));
+
+        return reader.consume("}");
+    }
+
+    if(c == '[') {
+        out.kind = JSON_ARRAY;
+        ++reader.pos;
+        reader.skip_whitespace();
+        if(reader.consume("]")) {
+            return true;
+        }
+
+        do {
+            if(!read_value(reader, out.elements.emplace_back(), depth + 1)) {
+                return false;
+            }
+
+            reader.skip_whitespace();
+        } while(reader.consume(","));
+
+        return reader.consume("]");
+    }
+
+    if(reader.consume("true"))  { out.kind = JSON_BOOL; out.boolean = true;  return true; }
+    if(reader.consume("false")) { out.kind = JSON_BOOL; out.boolean = false; return true; }
+    if(reader.consume("null"))  { out.kind = JSON_NULL; return true; }
+
+    //
+    // Numbers. from_chars doesn't take a leading '+', which JSON doesn't allow either.
+    //
+
+    const char* begin = reader.text.data() + reader.pos;
+    const char* end   = reader.text.data() + reader.text.size();
+    const auto  [ptr, error] = std::from_chars(begin, end, out.number);
+
+    if(error != std::errc() || !std::isfinite(out.number)) {
+        return false;
+    }
+
+    out.kind    = JSON_NUMBER;
+    reader.pos += static_cast<size_t>(ptr - begin);
+    return true;
+}
+
+std::optional<JsonValue>
+tak::parse_json(const std::string_view text) {
+
+    JsonReader reader;
+    JsonValue  value;
+
+    reader.text = text;
+    if(!read_value(reader, value, 0)) {
+        return std::nullopt;
+    }
+
+    reader.skip_whitespace();
+    if(reader.pos != text.size()) {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+
+//
+// Writing
+//
+
+static void
+write_value(const JsonValue& value, std::string& out) {
+    switch(value.kind) {
+        case JSON_NULL:   out += "null"; break;
+        case JSON_BOOL:   out += value.boolean ? "true" : "false"; break;
+        case JSON_STRING: append_json_string(out, value.string); break;
+        case JSON_NUMBER:
+            if(value.number == std::floor(value.number) && std::abs(value.number) < 1e15) {
+                out += std::to_string(static_cast<int64_t>(value.number));
+            } else {
+                out += fmt("{}", value.number);
+            }
+            break;
+        case JSON_ARRAY:
+            out += '[';
+            for(size_t i = 0; i < value.elements.size(); ++i) {
+                if(i != 0) out += ',';
+                write_value(value.elements[i], out);
+            }
+            out += ']';
+            break;
+        case JSON_OBJECT:
+            out += '{';
+            for(size_t i = 0; i < value.members.size(); ++i) {
+                if(i != 0) out += ',';
+                append_json_string(out, value.members[i].first);
+                out += ':';
+                write_value(value.members[i].second, out);
+            }
+            out += '}';
+            break;
+        default:
+            break;
+    }
+}
+
+std::string
+tak::json_to_string(const JsonValue& value) {
+    std::string out;
+    write_value(value, out);
+    return out;
+}
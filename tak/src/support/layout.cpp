@@ -0,0 +1,204 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <layout.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <algorithm>
+
+using namespace tak;
+
+
+static uint64_t
+align_up(const uint64_t offset, const uint32_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+static const TypeLayout* compute_layout(const std::string& name, Parser& parser, std::vector<std::string>& in_progress);
+
+static std::optional<std::pair<uint64_t, uint32_t>>
+size_and_alignment_of(const TypeData& type, Parser& parser, std::vector<std::string>& in_progress) {
+
+    uint64_t size      = 0;
+    uint32_t alignment = 0;
+
+    if(type.pointer_depth > 0) {
+        size      = sizeof(void*);
+        alignment = alignof(void*);
+    }
+
+    else if(const auto* var_type = std::get_if<var_t>(&type.name); var_type != nullptr && type.kind == TYPE_KIND_VARIABLE) {
+        if(*var_type == VAR_NONE || *var_type == VAR_VOID) {
+            return std::nullopt;
+        }
+
+        size      = var_t_to_size_bytes(*var_type);
+        alignment = static_cast<uint32_t>(size);
+    }
+
+    else if(const auto* type_name = std::get_if<std::string>(&type.name); type_name != nullptr && type.kind == TYPE_KIND_STRUCT) {
+        const auto* layout = compute_layout(*type_name, parser, in_progress);
+        if(layout == nullptr) {
+            return std::nullopt;
+        }
+
+        size      = layout->size;
+        alignment = layout->alignment;
+    }
+
+    else {
+        return std::nullopt; // Procedures that aren't pointers.
+    }
+
+    for(const uint32_t length : type.array_lengths) {
+        if(length == 0) {
+            return std::nullopt;
+        }
+
+        size *= length;
+    }
+
+    return std::make_pair(size, alignment);
+}
+
+static const TypeLayout*
+compute_layout(const std::string& name, Parser& parser, std::vector<std::string>& in_progress) {
+
+    if(const auto cached = parser.type_layouts_.find(name); cached != parser.type_layouts_.end()) {
+        return &cached->second;
+    }
+
+    const auto* user_t = parser.type_exists(name) ? parser.lookup_type(name) : nullptr;
+    if(user_t == nullptr || user_t->is_placeholder || std::ranges::find(in_progress, name) != in_progress.end()) {
+        return nullptr;
+    }
+
+    in_progress.emplace_back(name);
+    defer([&] {
+        in_progress.pop_back();
+    });
+
+
+    TypeLayout layout;
+    uint64_t   offset = 0;
+
+    for(uint32_t i = 0; i < user_t->members.size(); ++i) {
+        const auto& member = user_t->members[i];
+        if(member.type.sym_ref != INVALID_SYMBOL_INDEX) {
+            continue;
+        }
+
+        const auto member_size = size_and_alignment_of(member.type, parser, in_progress);
+        if(!member_size) {
+            return nullptr;
+        }
+
+        const uint32_t member_alignment = user_t->is_packed ? 1 : member_size->second;
+        const uint64_t member_offset    = align_up(offset, member_alignment);
+
+        auto& member_layout   = layout.members.emplace_back();
+        member_layout.index   = i;
+        member_layout.padding = static_cast<uint32_t>(member_offset - offset);
+        member_layout.offset  = member_offset;
+        member_layout.size    = member_size->first;
+
+        layout.padding  += member_offset - offset;
+        layout.alignment = std::max(layout.alignment, member_alignment);
+        offset           = member_offset + member_size->first;
+    }
+
+    layout.alignment     = std::max(layout.alignment, user_t->alignment);
+    layout.size          = align_up(offset, layout.alignment);
+    layout.tail_padding  = layout.size - offset;
+    layout.padding      += layout.tail_padding;
+
+    return &parser.type_layouts_.emplace(name, std::move(layout)).first->second;
+}
+
+
+const TypeLayout*
+tak::get_type_layout(const std::string& name, Parser& parser) {
+    std::vector<std::string> in_progress;
+    return compute_layout(name, parser, in_progress);
+}
+
+std::optional<uint64_t>
+tak::get_type_size(const TypeData& type, Parser& parser) {
+    std::vector<std::string> in_progress;
+    if(const auto size = size_and_alignment_of(type, parser, in_progress)) {
+        return size->first;
+    }
+
+    return std::nullopt;
+}
+
+std::optional<uint32_t>
+tak::get_type_alignment(const TypeData& type, Parser& parser) {
+    std::vector<std::string> in_progress;
+    if(const auto size = size_and_alignment_of(type, parser, in_progress)) {
+        return size->second;
+    }
+
+    return std::nullopt;
+}
+
+void
+tak::compute_type_layouts(Parser& parser) {
+    for(const auto& [name, _] : parser.type_table_) {
+        get_type_layout(name, parser);
+    }
+}
+
+void
+tak::print_layout_report(Parser& parser) {
+
+    //
+    // Structs with the most padding come first, those are the ones worth reordering.
+    //
+
+    compute_type_layouts(parser);
+
+    std::vector<std::pair<const std::string*, const TypeLayout*>> layouts;
+    for(const auto& [name, layout] : parser.type_layouts_) {
+        layouts.emplace_back(&name, &layout);
+    }
+
+    std::ranges::sort(layouts, [](const auto& lhs, const auto& rhs) {
+        if(lhs.second->padding != rhs.second->padding) {
+            return lhs.second->padding > rhs.second->padding;
+        }
+
+        return *lhs.first < *rhs.first;
+    });
+
+    uint64_t total_padding = 0;
+    for(const auto& [name, layout] : layouts) {
+        const auto* user_t = parser.lookup_type(*name);
+        total_padding     += layout->padding;
+
+        print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("\nstruct {}: {} bytes, align {}, {} bytes of padding{}",
+            *name,
+            layout->size,
+            layout->alignment,
+            layout->padding,
+            user_t->is_packed ? " (packed)" : ""
+        );
+
+        print("{:>10} {:>10}  {}", "offset", "size", "member");
+        for(const auto& member : layout->members) {
+            if(member.padding > 0) {
+                print("{:>10} {:>10}  <padding>", member.offset - member.padding, member.padding);
+            }
+
+            const auto& data = user_t->members[member.index];
+            print("{:>10} {:>10}  {} : {}", member.offset, member.size, data.name, typedata_to_str_msg(data.type));
+        }
+
+        if(layout->tail_padding > 0) {
+            print("{:>10} {:>10}  <padding>", layout->size - layout->tail_padding, layout->tail_padding);
+        }
+    }
+
+    print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("\n{} structs, {} bytes of padding in total.", layouts.size(), total_padding);
+}
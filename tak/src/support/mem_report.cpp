@@ -0,0 +1,359 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <mem_report.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <unordered_set>
+
+using namespace tak;
+
+#define MEM_REPORT_OFFENDERS 3
+
+
+struct HeapCounter {
+    std::unordered_set<const void*> seen; // shared_ptr targets, counted for whoever reaches them first.
+};
+
+
+//
+// Heap usage of the types that show up in nodes and tables.
+//
+
+static size_t
+heap_of(const std::string& str) {
+    static const size_t inline_capacity = std::string().capacity();
+    return str.capacity() > inline_capacity ? str.capacity() + 1 : 0;
+}
+
+template<typename T>
+static size_t
+heap_of(const std::vector<T>& vec) {
+    return vec.capacity() * sizeof(T);
+}
+
+template<typename T, size_t N>
+static size_t
+heap_of(const SmallVector<T, N>& vec) {
+    return vec.is_inline() ? 0 : vec.capacity() * sizeof(T);
+}
+
+static size_t
+heap_of(const TypeData& type, HeapCounter& counter);
+
+static size_t
+heap_of(const std::vector<TypeData>& types, HeapCounter& counter) {
+    size_t bytes = types.capacity() * sizeof(TypeData);
+    for(const auto& type : types) {
+        bytes += heap_of(type, counter);
+    }
+
+    return bytes;
+}
+
+template<typename T>
+static size_t
+heap_of(const std::shared_ptr<T>& ptr, HeapCounter& counter) {
+    if(ptr == nullptr || !counter.seen.emplace(ptr.get()).second) {
+        return 0;
+    }
+
+    return sizeof(T) + 2 * sizeof(void*) + heap_of(*ptr, counter); // Object plus (roughly) the control block.
+}
+
+static size_t
+heap_of(const TypeData& type, HeapCounter& counter) {
+
+    size_t bytes = heap_of(type.array_lengths)
+        + heap_of(type.parameters, counter)
+        + heap_of(type.return_type, counter);
+
+    if(const auto* name = std::get_if<std::string>(&type.name)) {
+        bytes += heap_of(*name);
+    }
+
+    return bytes;
+}
+
+static size_t
+heap_of(const std::vector<MemberData>& members, HeapCounter& counter) {
+    size_t bytes = heap_of(members);
+    for(const auto& member : members) {
+        bytes += heap_of(member.name) + heap_of(member.type, counter);
+    }
+
+    return bytes;
+}
+
+static size_t
+heap_of(const std::vector<std::string>& strings) {
+    size_t bytes = strings.capacity() * sizeof(std::string);
+    for(const auto& str : strings) {
+        bytes += heap_of(str);
+    }
+
+    return bytes;
+}
+
+
+//
+// Nodes
+//
+
+static size_t
+node_shallow_size(const node_t type) {
+    switch(type) {
+        case NODE_VARDECL:           return sizeof(AstVardecl);
+        case NODE_PROCDECL:          return sizeof(AstProcdecl);
+        case NODE_BINEXPR:           return sizeof(AstBinexpr);
+        case NODE_UNARYEXPR:         return sizeof(AstUnaryexpr);
+        case NODE_IDENT:             return sizeof(AstIdentifier);
+        case NODE_BRANCH:            return sizeof(AstBranch);
+        case NODE_IF:                return sizeof(AstIf);
+        case NODE_ELSE:              return sizeof(AstElse);
+        case NODE_FOR:               return sizeof(AstFor);
+        case NODE_SWITCH:            return sizeof(AstSwitch);
+        case NODE_CASE:              return sizeof(AstCase);
+        case NODE_DEFAULT:           return sizeof(AstDefault);
+        case NODE_WHILE:             return sizeof(AstWhile);
+        case NODE_DOWHILE:           return sizeof(AstDoWhile);
+        case NODE_BLOCK:             return sizeof(AstBlock);
+        case NODE_CALL:              return sizeof(AstCall);
+        case NODE_BRK:               return sizeof(AstBrk);
+        case NODE_CONT:              return sizeof(AstCont);
+        case NODE_RET:               return sizeof(AstRet);
+        case NODE_DEFER:             return sizeof(AstDefer);
+        case NODE_DEFER_IF:          return sizeof(AstDeferIf);
+        case NODE_SIZEOF:            return sizeof(AstSizeof);
+        case NODE_SINGLETON_LITERAL: return sizeof(AstSingletonLiteral);
+        case NODE_BRACED_EXPRESSION: return sizeof(AstBracedExpression);
+        case NODE_STRUCT_DEFINITION: return sizeof(AstStructdef);
+        case NODE_ENUM_DEFINITION:   return sizeof(AstEnumdef);
+        case NODE_SUBSCRIPT:         return sizeof(AstSubscript);
+        case NODE_NAMESPACEDECL:     return sizeof(AstNamespaceDecl);
+        case NODE_COMPOSEDECL:       return sizeof(AstComposeDecl);
+        case NODE_CAST:              return sizeof(AstCast);
+        case NODE_TYPE_ALIAS:        return sizeof(AstTypeAlias);
+        case NODE_MEMBER_ACCESS:     return sizeof(AstMemberAccess);
+        default:                     return sizeof(AstNode);
+    }
+}
+
+static size_t
+node_heap_size(AstNode* node, HeapCounter& counter) {
+    switch(node->type) {
+        case NODE_PROCDECL: {
+            const auto* procdecl = dynamic_cast<AstProcdecl*>(node);
+            size_t bytes = heap_of(procdecl->parameters) + heap_of(procdecl->body);
+            if(procdecl->deferred_body.has_value()) {
+                bytes += heap_of(procdecl->deferred_body->namespaces);
+            }
+            return bytes;
+        }
+
+        case NODE_SIZEOF: {
+            const auto* type = std::get_if<TypeData>(&dynamic_cast<AstSizeof*>(node)->target);
+            return type != nullptr ? heap_of(*type, counter) : 0;
+        }
+
+        case NODE_NAMESPACEDECL: {
+            const auto* _namespace = dynamic_cast<AstNamespaceDecl*>(node);
+            return heap_of(_namespace->full_path) + heap_of(_namespace->children);
+        }
+
+        case NODE_COMPOSEDECL: {
+            const auto* compose = dynamic_cast<AstComposeDecl*>(node);
+            return heap_of(compose->type_name) + heap_of(compose->children);
+        }
+
+        case NODE_MEMBER_ACCESS: {
+            const auto* member_access = dynamic_cast<AstMemberAccess*>(node);
+            return heap_of(member_access->path);
+        }
+
+        case NODE_BRANCH:             return heap_of(dynamic_cast<AstBranch*>(node)->conditions);
+        case NODE_IF:                 return heap_of(dynamic_cast<AstIf*>(node)->body);
+        case NODE_ELSE:               return heap_of(dynamic_cast<AstElse*>(node)->body);
+        case NODE_FOR:                return heap_of(dynamic_cast<AstFor*>(node)->body);
+        case NODE_SWITCH:             return heap_of(dynamic_cast<AstSwitch*>(node)->cases);
+        case NODE_CASE:               return heap_of(dynamic_cast<AstCase*>(node)->body);
+        case NODE_DEFAULT:            return heap_of(dynamic_cast<AstDefault*>(node)->body);
+        case NODE_WHILE:              return heap_of(dynamic_cast<AstWhile*>(node)->body);
+        case NODE_DOWHILE:            return heap_of(dynamic_cast<AstDoWhile*>(node)->body);
+        case NODE_BLOCK:              return heap_of(dynamic_cast<AstBlock*>(node)->children);
+        case NODE_CALL:               return heap_of(dynamic_cast<AstCall*>(node)->arguments);
+        case NODE_SINGLETON_LITERAL:  return heap_of(dynamic_cast<AstSingletonLiteral*>(node)->value);
+        case NODE_BRACED_EXPRESSION:  return heap_of(dynamic_cast<AstBracedExpression*>(node)->members);
+        case NODE_STRUCT_DEFINITION:  return heap_of(dynamic_cast<AstStructdef*>(node)->name);
+        case NODE_CAST:               return heap_of(dynamic_cast<AstCast*>(node)->type, counter);
+        case NODE_TYPE_ALIAS:         return heap_of(dynamic_cast<AstTypeAlias*>(node)->name);
+        default:                      return 0;
+    }
+}
+
+
+//
+// Tables. An entry is counted as the key/value pair plus the next pointer, and the cached hash for string keys.
+//
+
+template<typename K, typename V>
+static size_t
+table_shallow_size(const std::unordered_map<K, V>& table) {
+    constexpr size_t entry_size = sizeof(std::pair<const K, V>) + sizeof(void*) + (std::is_same_v<K, std::string> ? sizeof(size_t) : 0);
+    return sizeof(table) + table.size() * entry_size + table.bucket_count() * sizeof(void*);
+}
+
+static MemReportRow
+sym_table_row(const Parser& parser, HeapCounter& counter) {
+
+    MemReportRow row = { "sym_table_", parser.sym_table_.size(), table_shallow_size(parser.sym_table_), 0 };
+    for(const auto& [_, sym] : parser.sym_table_) {
+        row.heap += heap_of(sym.name) + heap_of(sym.type, counter);
+    }
+
+    return row;
+}
+
+static MemReportRow
+type_table_row(const Parser& parser, HeapCounter& counter) {
+
+    MemReportRow row = { "type_table_", parser.type_table_.size(), table_shallow_size(parser.type_table_), 0 };
+    for(const auto& [name, type] : parser.type_table_) {
+        row.heap += heap_of(name) + heap_of(type.members, counter) + table_shallow_size(type.member_indices) - sizeof(type.member_indices);
+        for(const auto& [member_name, _] : type.member_indices) {
+            row.heap += heap_of(member_name);
+        }
+    }
+
+    return row;
+}
+
+static MemReportRow
+type_aliases_row(const Parser& parser, HeapCounter& counter) {
+
+    MemReportRow row = { "type_aliases_", parser.type_aliases_.size(), table_shallow_size(parser.type_aliases_), 0 };
+    for(const auto& [name, type] : parser.type_aliases_) {
+        row.heap += heap_of(name) + heap_of(type, counter);
+    }
+
+    return row;
+}
+
+static MemReportRow
+type_layouts_row(const Parser& parser) {
+
+    MemReportRow row = { "type_layouts_", parser.type_layouts_.size(), table_shallow_size(parser.type_layouts_), 0 };
+    for(const auto& [name, layout] : parser.type_layouts_) {
+        row.heap += heap_of(name) + heap_of(layout.members);
+    }
+
+    return row;
+}
+
+
+static MemReportRow
+node_types_row(const Parser& parser, HeapCounter& counter) {
+
+    MemReportRow row = { "node_types_", parser.node_types_.size(), sizeof(parser.node_types_), 0 };
+    row.heap = parser.node_types_.capacity() * sizeof(TypeData);
+    for(const auto& type : parser.node_types_) {
+        row.heap += heap_of(type, counter);
+    }
+
+    constexpr size_t entry_size = sizeof(std::pair<const uint64_t, uint32_t>) + sizeof(void*);
+    row.shallow += sizeof(parser.node_type_ids_) + parser.node_type_ids_.size() * entry_size + parser.node_type_ids_.bucket_count() * sizeof(void*);
+    return row;
+}
+
+static MemReportRow
+node_constants_row(const Parser& parser) {
+
+    MemReportRow row = { "node_constants_", parser.node_constants_.size(), sizeof(parser.node_constants_), 0 };
+    row.heap = parser.node_constants_.capacity() * sizeof(ConstantValue);
+    return row;
+}
+
+
+
+tak::MemReport
+tak::collect_memory_report(Parser& parser) {
+
+    MemReport   report;
+    HeapCounter counter;
+
+    std::vector<MemReportRow> by_type(NODE_MEMBER_ACCESS + 1);
+    for(size_t i = 0; i < by_type.size(); ++i) {
+        by_type[i].name = node_type_name(static_cast<node_t>(i));
+    }
+
+    for(AstNode* decl : parser.toplevel_decls_) {
+        walk_ast(decl, [&](AstNode* node) {
+            auto& row = by_type[node->type];
+            ++row.count;
+            row.shallow += node_shallow_size(node->type);
+            row.heap    += node_heap_size(node, counter);
+        });
+    }
+
+    for(auto& row : by_type) {
+        if(row.count > 0) {
+            report.nodes.emplace_back(std::move(row));
+        }
+    }
+
+    report.tables.emplace_back(sym_table_row(parser, counter));
+    report.tables.emplace_back(type_table_row(parser, counter));
+    report.tables.emplace_back(type_aliases_row(parser, counter));
+    report.tables.emplace_back(type_layouts_row(parser));
+    report.tables.emplace_back(node_types_row(parser, counter));
+    report.tables.emplace_back(node_constants_row(parser));
+    return report;
+}
+
+void
+tak::print_memory_report(const MemReport& report) {
+
+    size_t total = 0;
+    std::vector<const MemReportRow*> ranked;
+
+    for(const auto* rows : { &report.nodes, &report.tables }) {
+        for(const auto& row : *rows) {
+            total += row.shallow + row.heap;
+            ranked.emplace_back(&row);
+        }
+    }
+
+    std::ranges::sort(ranked, [](const MemReportRow* lhs, const MemReportRow* rhs) {
+        return lhs->shallow + lhs->heap > rhs->shallow + rhs->heap;
+    });
+
+    if(ranked.size() > MEM_REPORT_OFFENDERS) {
+        ranked.resize(MEM_REPORT_OFFENDERS);
+    }
+
+    const auto print_rows = [&](const std::string_view title, const std::vector<MemReportRow>& rows) {
+        print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("\n{:<20} {:>10} {:>12} {:>12} {:>12} {:>7}", title, "count", "shallow", "heap", "total", "%");
+        for(const auto& row : rows) {
+            const size_t row_total = row.shallow + row.heap;
+            const bool   offender  = std::ranges::find(ranked, &row) != ranked.end();
+            print("{:<20} {:>10} {:>12} {:>12} {:>12} {:>6.1f}%{}",
+                row.name,
+                row.count,
+                row.shallow,
+                row.heap,
+                row_total,
+                total > 0 ? 100.0 * static_cast<double>(row_total) / static_cast<double>(total) : 0.0,
+                offender ? "  <--" : ""
+            );
+        }
+    };
+
+    print_rows("node type", report.nodes);
+    print_rows("table", report.tables);
+
+    print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("\ntotal: {} bytes", total);
+    for(size_t i = 0; i < ranked.size(); ++i) {
+        print("  #{} {} ({} bytes)", i + 1, ranked[i]->name, ranked[i]->shallow + ranked[i]->heap);
+    }
+}
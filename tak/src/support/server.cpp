@@ -0,0 +1,498 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <server.hpp>
+#include <incremental.hpp>
+#include <image.hpp>
+#include <io.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+#ifndef TAK_WINDOWS
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+using namespace tak;
+
+
+bool
+tak::server_can_compile(const CompileOptions& options) {
+
+    //
+    // The server only keeps what incremental_build produces around, and always reports as text.
+    // -j doesn't matter, files are compiled one after the other either way.
+    //
+
+    return !options.lazy_proc_bodies
+        && !options.use_image_cache
+        && !options.mem_report
+        && !options.layout_report
+        && options.check_threads <= 1
+        && options.diagnostics_format == DIAG_FORMAT_TEXT
+        && options.diagnostics_path.empty()
+        && options.entry_points.empty()
+        && !options.warn_unreachable
+        && options.call_graph_dot.empty()
+        && options.call_graph_path.empty()
+        && !options.time_report
+        && options.dumps == DUMP_NONE;
+}
+
+std::string
+tak::default_server_socket_path() {
+#ifdef TAK_WINDOWS
+    return "";
+#else
+    const char* runtime_dir = std::getenv("XDG_RUNTIME_DIR");
+    if(runtime_dir != nullptr && runtime_dir[0] != '\0') {
+        return fmt("{}/tak-server.sock", runtime_dir);
+    }
+
+    return fmt("/tmp/tak-server-{}.sock", static_cast<uint32_t>(getuid()));
+#endif
+}
+
+#ifdef TAK_WINDOWS
+
+bool
+tak::run_compile_server(const std::string&) {
+    print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("--server is not supported on Windows.");
+    return false;
+}
+
+bool
+tak::stop_compile_server(const std::string&) {
+    print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("--stop-server is not supported on Windows.");
+    return false;
+}
+
+std::optional<bool>
+tak::compile_with_server(const std::string&, const std::vector<std::string>&) {
+    return std::nullopt;
+}
+
+#else
+
+//
+// Reading and writing messages.
+//
+
+static bool
+write_all(const int fd, const char* data, size_t size) {
+    while(size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if(written < 0 && errno == EINTR) continue;
+        if(written <= 0) return false;
+
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+
+    return true;
+}
+
+static bool
+read_all(const int fd, char* data, size_t size) {
+    while(size > 0) {
+        const ssize_t got = ::read(fd, data, size);
+        if(got < 0 && errno == EINTR) continue;
+        if(got <= 0) return false;
+
+        data += got;
+        size -= static_cast<size_t>(got);
+    }
+
+    return true;
+}
+
+static bool
+send_message(const int fd, const std::string& payload) {
+    const auto size = static_cast<uint32_t>(payload.size());
+    return write_all(fd, reinterpret_cast<const char*>(&size), sizeof(size)) && write_all(fd, payload.data(), payload.size());
+}
+
+static bool
+receive_message(const int fd, std::string& payload) {
+    uint32_t size = 0;
+    if(!read_all(fd, reinterpret_cast<char*>(&size), sizeof(size)) || size > MAX_SERVER_MESSAGE) {
+        return false;
+    }
+
+    payload.resize(size);
+    return read_all(fd, payload.data(), size);
+}
+
+template<typename T>
+static void
+append_value(std::string& out, const T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void
+append_string(std::string& out, const std::string_view str) {
+    append_value(out, static_cast<uint32_t>(str.size()));
+    out.append(str);
+}
+
+struct MessageReader {
+    std::string_view data;
+    size_t           offset = 0;
+
+    template<typename T>
+    bool value(T& out) {
+        if(data.size() - offset < sizeof(T)) return false;
+        std::memcpy(&out, data.data() + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool string(std::string& out) {
+        uint32_t size = 0;
+        if(!value(size) || data.size() - offset < size) return false;
+        out.assign(data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+};
+
+static bool
+make_socket_address(const std::string& socket_path, sockaddr_un& address) {
+    if(socket_path.empty() || socket_path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, socket_path.data(), socket_path.size());
+    return true;
+}
+
+static bool
+peer_is_current_user(const int fd) {
+
+    //
+    // The socket can sit in /tmp when XDG_RUNTIME_DIR isn't set, where any user could
+    // have bound it first. Neither side talks to a process owned by someone else.
+    //
+
+#ifdef SO_PEERCRED
+    ucred     credentials = {};
+    socklen_t length      = sizeof(credentials);
+    if(getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &length) != 0) {
+        return false;
+    }
+
+    return credentials.uid == getuid();
+#else
+    uid_t uid = 0;
+    gid_t gid = 0;
+    return getpeereid(fd, &uid, &gid) == 0 && uid == getuid();
+#endif
+}
+
+static int
+connect_to_server(const std::string& socket_path) {
+
+    sockaddr_un address = {};
+    if(!make_socket_address(socket_path, address)) {
+        return -1;
+    }
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0) {
+        return -1;
+    }
+
+    if(connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || !peer_is_current_user(fd)) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+static std::string
+make_request(const server_request_t kind, const std::vector<std::string>& source_file_names) {
+
+    std::string request;
+    append_value<uint32_t>(request, TAK_SERVER_MAGIC);
+    append_value<uint16_t>(request, TAK_SERVER_VERSION);
+    append_value<uint8_t>(request, kind);
+    append_value<uint8_t>(request, output_colors_enabled());
+    append_value<uint32_t>(request, static_cast<uint32_t>(source_file_names.size()));
+
+    for(const auto& name : source_file_names) {
+        std::error_code error;
+        const auto      absolute = std::filesystem::absolute(name, error);
+        append_string(request, name);
+        append_string(request, error ? name : absolute.lexically_normal().string());
+    }
+
+    return request;
+}
+
+
+//
+// Server side. Every file keeps its own IncrementalUnit, keyed by absolute path.
+//
+
+struct ResidentFile {
+    IncrementalUnit unit;
+    std::string     name;            // What the file was called in the request that built it.
+    std::string     output;          // Everything the build printed.
+    uint64_t        source_hash = 0;
+    bool            colored     = false;
+    bool            compiled    = false;
+};
+
+struct ServerStats {
+    uint32_t unchanged = 0;  // Content hash matched, output replayed.
+    uint32_t rebuilt   = 0;
+    uint32_t reused    = 0;  // Toplevel declarations kept by incremental_build.
+    uint32_t reparsed  = 0;  // Toplevel declarations parsed again, including invalidated ones.
+};
+
+using ResidentFiles = std::unordered_map<std::string, std::unique_ptr<ResidentFile>>;
+
+
+static bool
+compile_resident(ResidentFiles& files, const std::string& name, const std::string& path, const bool colored, std::string& output, ServerStats& stats) {
+
+    std::ostringstream captured;
+    Lexer              lexer;
+
+    redirect_output(&captured);
+    const bool read = lexer.init(path);
+    redirect_output(nullptr);
+
+    if(!read) {
+        files.erase(path);
+        output += captured.str();
+        return false;
+    }
+
+    lexer.source_file_name_ = name;
+    const uint64_t source_hash = hash_source({lexer.src_.data(), lexer.src_.size()});
+
+    auto& file = files[path];
+    if(file == nullptr) {
+        file = std::make_unique<ResidentFile>();
+    } else if(file->source_hash == source_hash && file->name == name && file->colored == colored) {
+        output += file->output;
+        ++stats.unchanged;
+        return file->compiled;
+    }
+
+    redirect_output(&captured);
+    file->compiled = incremental_build(file->unit, lexer);
+    redirect_output(nullptr);
+
+    file->name        = name;
+    file->output      = captured.str();
+    file->source_hash = source_hash;
+    file->colored     = colored;
+
+    ++stats.rebuilt;
+    stats.reused   += file->unit.stats_.reused;
+    stats.reparsed += file->unit.stats_.reparsed + file->unit.stats_.invalidated;
+
+    output += file->output;
+    return file->compiled;
+}
+
+static bool
+handle_request(ResidentFiles& files, const int client) {
+
+    std::string   payload;
+    MessageReader reader;
+
+    uint32_t magic   = 0;
+    uint16_t version = 0;
+    uint8_t  kind    = 0;
+    uint8_t  colored = 0;
+    uint32_t count   = 0;
+
+    if(!receive_message(client, payload)) {
+        return true;
+    }
+
+    reader.data = payload;
+    if(!reader.value(magic) || !reader.value(version) || !reader.value(kind) || !reader.value(colored) || !reader.value(count)
+        || magic != TAK_SERVER_MAGIC || version != TAK_SERVER_VERSION) {
+        print("dropped a malformed request.");
+        return true;
+    }
+
+    if(kind == SERVER_REQUEST_STOP) {
+        send_message(client, std::string(1, '\1'));
+        return false;
+    }
+
+    const auto  begin    = std::chrono::steady_clock::now();
+    std::string response = std::string(1, '\0');
+    ServerStats stats;
+    uint32_t    failed   = 0;
+
+    set_color_mode(colored ? COLOR_ALWAYS : COLOR_NEVER);
+    for(uint32_t i = 0; i < count; ++i) {
+        std::string name, path;
+        if(!reader.string(name) || !reader.string(path)) {
+            print("dropped a malformed request.");
+            return true;
+        }
+
+        failed += !compile_resident(files, name, path, colored != 0, response, stats);
+    }
+
+    //
+    // Same summary the driver prints for several files.
+    //
+
+    if(failed != 0 && count > 1) {
+        std::ostringstream summary;
+        redirect_output(&summary);
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("{} of {} files failed to compile.", failed, count);
+        redirect_output(nullptr);
+        response += summary.str();
+    }
+
+    response[0] = failed == 0 ? '\1' : '\0';
+    send_message(client, response);
+
+    print("{} file(s): {} unchanged, {} rebuilt ({} declarations reused, {} reparsed) in {:.3f} ms",
+        count,
+        stats.unchanged,
+        stats.rebuilt,
+        stats.reused,
+        stats.reparsed,
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count()
+    );
+
+    flush_output();
+    return true;
+}
+
+bool
+tak::run_compile_server(const std::string& socket_path) {
+
+    sockaddr_un address = {};
+    if(!make_socket_address(socket_path, address)) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("Invalid server socket path \"{}\".", socket_path);
+        return false;
+    }
+
+    //
+    // A socket file nobody is listening on is left over from a server that died, it can go.
+    //
+
+    if(const int existing = connect_to_server(socket_path); existing >= 0) {
+        close(existing);
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("A compile server is already listening on {}.", socket_path);
+        return false;
+    }
+
+    unlink(socket_path.c_str());
+    std::signal(SIGPIPE, SIG_IGN);
+
+    const int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0
+        || bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+        || listen(listener, 16) != 0) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("Could not listen on {}: {}.", socket_path, std::strerror(errno));
+        if(listener >= 0) close(listener);
+        return false;
+    }
+
+    ResidentFiles files;
+    bool          running = true;
+
+    print("compile server listening on {}", socket_path);
+    flush_output();
+
+    while(running) {
+        const int client = accept(listener, nullptr, nullptr);
+        if(client < 0) {
+            if(errno == EINTR || errno == ECONNABORTED) continue;
+            print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("accept failed: {}.", std::strerror(errno));
+            break;
+        }
+
+        //
+        // A client that connects and then stops sending would otherwise keep every other one waiting.
+        //
+
+        timeval timeout = {};
+        timeout.tv_sec  = SERVER_RECV_TIMEOUT;
+
+        if(!peer_is_current_user(client) || setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) != 0) {
+            close(client);
+            continue;
+        }
+
+        running = handle_request(files, client);
+        close(client);
+    }
+
+    close(listener);
+    unlink(socket_path.c_str());
+    print("compile server stopped.");
+    return !running;
+}
+
+bool
+tak::stop_compile_server(const std::string& socket_path) {
+
+    const int fd = connect_to_server(socket_path);
+    if(fd < 0) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("No compile server is listening on {}.", socket_path);
+        return false;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::string response;
+    const bool  stopped = send_message(fd, make_request(SERVER_REQUEST_STOP, {})) && receive_message(fd, response);
+
+    close(fd);
+    return stopped;
+}
+
+std::optional<bool>
+tak::compile_with_server(const std::string& socket_path, const std::vector<std::string>& source_file_names) {
+
+    //
+    // Nothing gets written until the whole response is in, so if the server
+    // is gone or dies halfway through, the caller can still compile locally.
+    //
+
+    const int fd = connect_to_server(socket_path);
+    if(fd < 0) {
+        return std::nullopt;
+    }
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::string response;
+    const bool  received = send_message(fd, make_request(SERVER_REQUEST_COMPILE, source_file_names)) && receive_message(fd, response);
+
+    close(fd);
+    if(!received || response.empty()) {
+        return std::nullopt;
+    }
+
+    write_output(std::string_view(response).substr(1));
+    return response[0] != '\0';
+}
+
+#endif
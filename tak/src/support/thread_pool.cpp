@@ -0,0 +1,129 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <thread_pool.hpp>
+#include <algorithm>
+#include <cassert>
+
+
+tak::ThreadPool::ThreadPool(const size_t num_threads) {
+
+    const size_t count = std::max<size_t>(num_threads, 1);
+    queues_.reserve(count);
+    workers_.reserve(count);
+
+    for(size_t i = 0; i < count; ++i) {
+        queues_.emplace_back(std::make_unique<WorkQueue>());
+    }
+
+    for(size_t i = 0; i < count; ++i) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+tak::ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(state_lock_);
+        stopping_ = true;
+    }
+
+    work_available_.notify_all();
+    for(auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+
+void
+tak::ThreadPool::submit(std::function<void()> task) {
+
+    //
+    // The counters go up before the task becomes visible, so a worker
+    // can never finish a task that hasn't been counted yet.
+    //
+
+    size_t index = 0;
+    {
+        std::lock_guard lock(state_lock_);
+        index = next_queue_++ % queues_.size();
+        ++queued_;
+        ++unfinished_;
+    }
+
+    {
+        std::lock_guard lock(queues_[index]->lock);
+        queues_[index]->tasks.emplace_back(std::move(task));
+    }
+
+    work_available_.notify_one();
+}
+
+void
+tak::ThreadPool::wait() {
+    std::unique_lock lock(state_lock_);
+    work_finished_.wait(lock, [&]{ return unfinished_ == 0; });
+}
+
+
+bool
+tak::ThreadPool::take_task(const size_t index, std::function<void()>& task) {
+
+    {
+        auto& own = *queues_[index];
+        std::lock_guard lock(own.lock);
+        if(!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    for(size_t i = 1; i < queues_.size(); ++i) {
+        auto& victim = *queues_[(index + i) % queues_.size()];
+        std::lock_guard lock(victim.lock);
+        if(!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+tak::ThreadPool::worker_loop(const size_t index) {
+
+    std::function<void()> task;
+    while(true) {
+        if(take_task(index, task)) {
+            {
+                std::lock_guard lock(state_lock_);
+                assert(queued_ > 0);
+                --queued_;
+            }
+
+            task();
+            task = nullptr;
+
+            std::lock_guard lock(state_lock_);
+            if(--unfinished_ == 0) {
+                work_finished_.notify_all();
+            }
+
+            continue;
+        }
+
+
+        //
+        // A task can be counted but not pushed yet, in which case we just go around again.
+        //
+
+        std::unique_lock lock(state_lock_);
+        work_available_.wait(lock, [&]{ return queued_ > 0 || stopping_; });
+        if(stopping_ && queued_ == 0) {
+            return;
+        }
+    }
+}
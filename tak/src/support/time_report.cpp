@@ -0,0 +1,144 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <time_report.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <ctime>
+
+#ifdef TAK_WINDOWS
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+tak::PhaseTimer::PhaseTimer(TimeReport* report, const std::string_view name) : report_(report), name_(name) {
+    if(report_ != nullptr) {
+        wall_begin_ = std::chrono::steady_clock::now();
+        cpu_begin_  = thread_cpu_ms();
+    }
+}
+
+tak::PhaseTimer::~PhaseTimer() {
+    if(report_ != nullptr) {
+        auto& phase   = report_->phases.emplace_back();
+        phase.name    = name_;
+        phase.wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wall_begin_).count();
+        phase.cpu_ms  = thread_cpu_ms() - cpu_begin_;
+    }
+}
+
+
+double
+tak::thread_cpu_ms() {
+#ifdef TAK_WINDOWS
+    FILETIME creation, exit, kernel, user;
+    if(!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+
+    const auto to_100ns = [](const FILETIME& time) {
+        return static_cast<uint64_t>(time.dwHighDateTime) << 32 | time.dwLowDateTime;
+    };
+
+    return static_cast<double>(to_100ns(kernel) + to_100ns(user)) / 10'000.0;
+#else
+    timespec now = {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return static_cast<double>(now.tv_sec) * 1'000.0 + static_cast<double>(now.tv_nsec) / 1'000'000.0;
+#endif
+}
+
+uint64_t
+tak::peak_rss_bytes() {
+#ifdef TAK_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters = {};
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return 0;
+    }
+
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage = {};
+    if(getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);         // Already in bytes.
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // In kilobytes.
+#endif
+#endif
+}
+
+
+void
+tak::print_time_report(const TimeReport& report) {
+
+    double total_wall = 0.0;
+    double total_cpu  = 0.0;
+
+    print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("\n{:<28} {:>12} {:>12} {:>7}", fmt("time report: {}", report.file), "wall (ms)", "cpu (ms)", "%");
+    for(const auto& phase : report.phases) {
+        if(!phase.nested) {
+            total_wall += phase.wall_ms;
+            total_cpu  += phase.cpu_ms;
+        }
+    }
+
+    for(const auto& phase : report.phases) {
+        print("{:<28} {:>12.3f} {:>12.3f} {:>6.1f}%",
+            phase.nested ? fmt("  {}", phase.name) : phase.name,
+            phase.wall_ms,
+            phase.cpu_ms,
+            total_wall > 0.0 ? 100.0 * phase.wall_ms / total_wall : 0.0
+        );
+    }
+
+    print("{:<28} {:>12.3f} {:>12.3f}", "total", total_wall, total_cpu);
+
+    const double seconds = total_wall / 1'000.0;
+    const auto   rate    = [&](const uint64_t count) { return seconds > 0.0 ? static_cast<double>(count) / seconds : 0.0; };
+
+    print<TFG_NONE, TBG_NONE, TSTYLE_BOLD>("\n{:<28} {:>12} {:>14}", "counter", "count", "per second");
+    print("{:<28} {:>12} {:>14.0f}", "bytes",       report.bytes,       rate(report.bytes));
+    print("{:<28} {:>12} {:>14.0f}", "tokens",      report.tokens,      rate(report.tokens));
+    print("{:<28} {:>12} {:>14.0f}", "ast nodes",   report.nodes,       rate(report.nodes));
+    print("{:<28} {:>12}",           "symbols",     report.symbols);
+    print("{:<28} {:>12}",           "types",       report.types);
+    print("{:<28} {:>12}",           "diagnostics", report.diagnostics);
+
+    if(report.peak_rss != 0) {
+        print("{:<28} {:>12}", "process peak rss (KiB)", report.peak_rss / 1024);
+    }
+}
+
+std::string
+tak::time_report_json(const TimeReport& report) {
+
+    std::string out = "{\n  \"file\": ";
+    append_json_string(out, report.file);
+    out += ",\n  \"phases\": [";
+
+    for(size_t i = 0; i < report.phases.size(); ++i) {
+        const auto& phase = report.phases[i];
+        out += i == 0 ? "\n    {\"name\": " : ",\n    {\"name\": ";
+        append_json_string(out, phase.name);
+        out += fmt(", \"wall_ms\": {:.3f}, \"cpu_ms\": {:.3f}, \"nested\": {}}}", phase.wall_ms, phase.cpu_ms, phase.nested ? "true" : "false");
+    }
+
+    out += report.phases.empty() ? "],\n" : "\n  ],\n";
+    out += fmt("  \"bytes\": {},\n  \"tokens\": {},\n  \"nodes\": {},\n  \"symbols\": {},\n  \"types\": {},\n  \"diagnostics\": {}",
+        report.bytes, report.tokens, report.nodes, report.symbols, report.types, report.diagnostics);
+
+    if(report.peak_rss != 0) {
+        out += fmt(",\n  \"process_peak_rss\": {}", report.peak_rss);
+    }
+
+    out += "\n}\n";
+
+    return out;
+}
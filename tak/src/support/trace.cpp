@@ -0,0 +1,142 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <trace.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+using trace_clock = std::chrono::steady_clock;
+
+struct TraceEvent {
+    std::string      name;
+    std::string_view category;
+    uint64_t         begin_us    = 0;
+    uint64_t         duration_us = 0;
+    uint32_t         thread      = 0;
+};
+
+static std::atomic_bool        trace_active = false;
+static trace_clock::time_point trace_epoch;
+static std::mutex              trace_lock;
+static std::vector<TraceEvent> trace_events;
+static std::atomic_uint32_t    next_trace_thread = 0;
+
+
+static uint32_t
+current_trace_thread() {
+    static thread_local const uint32_t thread = next_trace_thread++;
+    return thread;
+}
+
+static uint64_t
+micros_since_epoch(const trace_clock::time_point point) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(point - trace_epoch).count());
+}
+
+
+tak::TraceScope::TraceScope(const std::string_view category, const std::string_view name) {
+    if(trace_active.load(std::memory_order_relaxed)) {
+        active_   = true;
+        category_ = category;
+        name_     = name;
+        begin_    = trace_clock::now();
+    }
+}
+
+tak::TraceScope::~TraceScope() {
+
+    if(!active_) {
+        return;
+    }
+
+    TraceEvent event;
+    event.name        = std::move(name_);
+    event.category    = category_;
+    event.begin_us    = micros_since_epoch(begin_);
+    event.duration_us = micros_since_epoch(trace_clock::now()) - event.begin_us;
+    event.thread      = current_trace_thread();
+
+    std::lock_guard lock(trace_lock);
+    trace_events.emplace_back(std::move(event));
+}
+
+void
+tak::TraceScope::set_name(const std::string_view name) {
+    if(active_) {
+        name_ = name;
+    }
+}
+
+void
+tak::TraceScope::cancel() {
+    active_ = false;
+}
+
+
+void
+tak::start_tracing() {
+    std::lock_guard lock(trace_lock);
+    trace_events.clear();
+    trace_epoch = trace_clock::now();
+    trace_active.store(true);
+}
+
+bool
+tak::tracing_enabled() {
+    return trace_active.load(std::memory_order_relaxed);
+}
+
+bool
+tak::write_trace(const std::string& path) {
+
+    trace_active.store(false);
+    std::lock_guard lock(trace_lock);
+
+    //
+    // Parents before children, so viewers that expect sorted input nest them correctly.
+    //
+
+    std::ranges::sort(trace_events, [](const TraceEvent& lhs, const TraceEvent& rhs) {
+        if(lhs.thread != rhs.thread)     return lhs.thread < rhs.thread;
+        if(lhs.begin_us != rhs.begin_us) return lhs.begin_us < rhs.begin_us;
+        return lhs.duration_us > rhs.duration_us;
+    });
+
+    std::string out = "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    uint32_t    thread_count = 0;
+
+    for(const auto& event : trace_events) {
+        thread_count = std::max(thread_count, event.thread + 1);
+    }
+
+    for(uint32_t i = 0; i < thread_count; ++i) {
+        out += fmt("{}\n  {{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": {}, \"args\": {{\"name\": \"thread {}\"}}}}",
+            i == 0 ? "" : ",", i, i);
+    }
+
+    for(size_t i = 0; i < trace_events.size(); ++i) {
+        const auto& event = trace_events[i];
+        out += thread_count > 0 ? ",\n  {\"name\": " : "\n  {\"name\": ";
+        append_json_string(out, event.name);
+        out += ", \"cat\": ";
+        append_json_string(out, event.category);
+        out += fmt(", \"ph\": \"X\", \"ts\": {}, \"dur\": {}, \"pid\": 1, \"tid\": {}}}", event.begin_us, event.duration_us, event.thread);
+    }
+
+    out += "\n]}\n";
+    trace_events.clear();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file.is_open() || !file.write(out.data(), static_cast<std::streamsize>(out.size()))) {
+        print<TFG_RED, TBG_NONE, TSTYLE_BOLD>("Failed to write trace to {}.", path);
+        return false;
+    }
+
+    return true;
+}
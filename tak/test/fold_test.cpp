@@ -0,0 +1,154 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <driver.hpp>
+#include <checker.hpp>
+#include <support.hpp>
+#include <io.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+//
+// Checks the values constant folding gives character literals, escaped ones in particular.
+// Literals go through the parser like any program would, and are also folded straight from their
+// quoted source text, which is what a literal looks like before its escapes are resolved.
+//
+// usage: tak_fold_test
+//
+
+using namespace tak;
+
+
+static constexpr std::string_view source =
+    "NL :: i8 = '\\n';\n"
+    "TAB :: i8 = '\\t';\n"
+    "NUL :: i8 = '\\0';\n"
+    "BACKSLASH :: i8 = '\\\\';\n"
+    "QUOTE :: i8 = '\\'';\n"
+    "LETTER :: i8 = 'a';\n"
+    "SUM :: i32 = '\\n' + '\\t';\n"
+    "main :: proc() -> i32 {\n  ret 0;\n}\n";
+
+struct Expected {
+    std::string_view name;
+    int64_t          value;
+};
+
+static constexpr Expected expected[] = {
+    {"\\NL",        '\n'},
+    {"\\TAB",       '\t'},
+    {"\\NUL",       '\0'},
+    {"\\BACKSLASH", '\\'},
+    {"\\QUOTE",     '\''},
+    {"\\LETTER",    'a' },
+    {"\\SUM",       '\n' + '\t'},
+};
+
+
+static const Symbol*
+find_symbol(Parser& parser, const std::string_view name) {
+    for(const auto& [index, sym] : parser.sym_table_) {
+        if(sym.name == name) return &sym;
+    }
+
+    return nullptr;
+}
+
+static bool
+check_parsed_literals() {
+
+    const auto path = std::filesystem::temp_directory_path() / "tak_fold_test.tak";
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << source;
+    }
+
+    Parser parser;
+    Lexer  lexer;
+
+    const bool compiled = lexer.init(path.string()) && do_create_ast(parser, lexer);
+    std::filesystem::remove(path);
+    if(!compiled) {
+        print("FAILED: the test program did not compile.");
+        return false;
+    }
+
+    bool passed = true;
+    for(const auto& [name, value] : expected) {
+        const Symbol* sym = find_symbol(parser, name);
+        if(sym == nullptr || sym->constant.type == VAR_NONE) {
+            print("FAILED: {} was not folded.", name);
+            passed = false;
+        }
+        else if(static_cast<int64_t>(sym->constant.bits) != value) {
+            print("FAILED: {} folded to {}, expected {}.", name, static_cast<int64_t>(sym->constant.bits), value);
+            passed = false;
+        }
+    }
+
+    return passed;
+}
+
+static bool
+check_quoted_literals() {
+
+    struct Quoted {
+        std::string_view           text;
+        std::optional<int64_t>     value;
+    };
+
+    static constexpr Quoted quoted[] = {
+        {"'\\n'",  '\n'},
+        {"'\\t'",  '\t'},
+        {"'\\0'",  '\0'},
+        {"'\\\\'", '\\'},
+        {"'\\''",  '\''},
+        {"'a'",    'a' },
+        {"'\\q'",  std::nullopt},
+        {"''",     std::nullopt},
+    };
+
+    Parser         parser;
+    Lexer          lexer;
+    CheckerContext ctx(lexer, parser);
+
+    TypeData type;
+    type.kind = TYPE_KIND_VARIABLE;
+    type.name = VAR_I8;
+
+    bool passed = true;
+    for(const auto& [text, value] : quoted) {
+        AstSingletonLiteral literal;
+        literal.literal_type = TOKEN_CHARACTER_LITERAL;
+        literal.value        = std::string(text);
+
+        const auto folded = fold_constant(&literal, type, ctx);
+        if(folded.has_value() != value.has_value()) {
+            print("FAILED: {} should {}have been folded.", text, value ? "" : "not ");
+            passed = false;
+        }
+        else if(folded && static_cast<int64_t>(folded->bits) != *value) {
+            print("FAILED: {} folded to {}, expected {}.", text, static_cast<int64_t>(folded->bits), *value);
+            passed = false;
+        }
+    }
+
+    return passed;
+}
+
+
+int
+main() {
+
+    const bool parsed = check_parsed_literals();
+    const bool quoted = check_quoted_literals();
+    if(!parsed || !quoted) {
+        return EXIT_FAILURE;
+    }
+
+    print("character literals: OK");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "program_gen.hpp"
+#include <driver.hpp>
+#include <image.hpp>
+#include <io.hpp>
+#include <cstdlib>
+#include <filesystem>
+#include <sstream>
+
+//
+// Round-trips programs through the module image format: the image is written to a temporary file,
+// loaded back, and the loaded module has to serialize to the same bytes. An image written for other
+// source text must be rejected.
+//
+// usage: tak_image_test
+//
+
+using namespace tak;
+
+
+static bool
+round_trip(const std::string_view name, const std::string& source, const std::filesystem::path& image_path) {
+
+    Parser parser;
+    Lexer  lexer;
+
+    lexer.src_.assign(source.begin(), source.end());
+    lexer.source_file_name_ = "image_test.tak";
+
+    if(!do_create_ast(parser, lexer)) {
+        print("FAILED: {} did not compile.", name);
+        return false;
+    }
+
+    const uint64_t       source_hash = hash_source(source);
+    std::vector<uint8_t> image;
+
+    if(!write_image(parser, source_hash, image) || !write_image_file(parser, source_hash, image_path.string())) {
+        print("FAILED: could not write the image of {}.", name);
+        return false;
+    }
+
+    Parser               loaded;
+    Parser               stale;
+    std::vector<uint8_t> rewritten;
+
+    if(!load_image_file(image_path.string(), source_hash, loaded)) {
+        print("FAILED: could not load the image of {} back.", name);
+        return false;
+    }
+
+    if(!write_image(loaded, source_hash, rewritten) || rewritten != image) {
+        print("FAILED: the loaded image of {} does not serialize to the same bytes.", name);
+        return false;
+    }
+
+    if(load_image_file(image_path.string(), source_hash + 1, stale)) {
+        print("FAILED: the image of {} was loaded for different source text.", name);
+        return false;
+    }
+
+    return true;
+}
+
+
+int
+main() {
+
+    static constexpr std::string_view declarations =
+        "A :: i32 = 4;\n"
+        "B :: i32 = A * 2 + 1;\n"
+        "enum Color, u8 { Red, Green = 3, Blue }\n"
+        "struct P { x : i32; y : f64; }\n"
+        "compose P { get :: proc(self : P^) -> i32 { ret self.x; } }\n"
+        "main :: proc() -> i32 { p : P; ret p.get() + B; }\n";
+
+    const auto image_path = std::filesystem::temp_directory_path() / "tak_image_test.timg";
+
+    std::ostringstream discarded;
+    redirect_output(&discarded);
+
+    ProgramShape shape;
+    shape.lines = 5'000;
+
+    const bool passed = round_trip("a small program", std::string(declarations), image_path)
+        && round_trip("a generated program", generate_program(shape), image_path);
+
+    std::error_code ec;
+    std::filesystem::remove(image_path, ec);
+
+    redirect_output(nullptr);
+    if(!passed) {
+        print("{}", discarded.str());
+        return EXIT_FAILURE;
+    }
+
+    print("image round-trip: OK");
+    return EXIT_SUCCESS;
+}
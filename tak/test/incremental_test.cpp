@@ -0,0 +1,107 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include <incremental.hpp>
+#include <io.hpp>
+#include <cstdlib>
+#include <sstream>
+
+//
+// Checks that incremental builds don't reuse values folded from a constant that has since changed.
+// A program is built, a constant and an enum initializer are edited back and forth, and after every
+// rebuild each constant has to match what a fresh build of the same source folds it to. The table of
+// folded node constants must not keep growing while that goes on.
+//
+// usage: tak_incremental_test
+//
+
+using namespace tak;
+
+
+static std::string
+make_source(const uint32_t a, const uint32_t green) {
+    return fmt(
+        "A :: i32 = {};\n"
+        "B :: i32 = A + 1;\n"
+        "enum Color, u8 {{\n"
+        "  Red,\n"
+        "  Green = {},\n"
+        "  Blue\n"
+        "}}\n"
+        "C :: u8 = Color\\Blue * 2;\n"
+        "main :: proc() -> i32 {{\n"
+        "  ret B + A;\n"
+        "}}\n",
+        a, green
+    );
+}
+
+static bool
+build(IncrementalUnit& unit, const std::string& source) {
+    Lexer lexer;
+    lexer.src_.assign(source.begin(), source.end());
+    lexer.source_file_name_ = "incremental_test.tak";
+    return incremental_build(unit, lexer);
+}
+
+static bool
+same_constants(IncrementalUnit& unit, const std::string& source) {
+
+    IncrementalUnit fresh;
+    if(!build(fresh, source)) {
+        print("FAILED: a fresh build of the test program failed.");
+        return false;
+    }
+
+    for(const auto& [index, sym] : fresh.parser_.sym_table_) {
+        const auto* other = unit.parser_.lookup_unique_symbol(index);
+        if(other == nullptr || other->name != sym.name || other->constant != sym.constant) {
+            print("FAILED: {} is folded to {} incrementally and {} from scratch.", sym.name,
+                other != nullptr ? other->constant.bits : 0, sym.constant.bits);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int
+main() {
+
+    //
+    // The compiler's own output isn't part of the test.
+    //
+
+    std::ostringstream discarded;
+    redirect_output(&discarded);
+
+    IncrementalUnit unit;
+    bool            passed = build(unit, make_source(5, 5)) && same_constants(unit, make_source(5, 5));
+
+    for(uint32_t i = 1; i <= 400 && passed; ++i) {
+        const std::string source = make_source(5 + i % 7, 5 + i % 3);
+        if(!build(unit, source)) {
+            print("FAILED: rebuild {} failed.", i);
+            passed = false;
+        } else {
+            passed = same_constants(unit, source);
+        }
+    }
+
+    const size_t constants = unit.parser_.node_constants_.size();
+    if(passed && constants > 1024) {
+        print("FAILED: {} node constants are left after 400 rebuilds of a small program.", constants);
+        passed = false;
+    }
+
+    redirect_output(nullptr);
+    if(!passed) {
+        print("{}", discarded.str());
+        return EXIT_FAILURE;
+    }
+
+    print("incremental constants: OK");
+    return EXIT_SUCCESS;
+}
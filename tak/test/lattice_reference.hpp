@@ -0,0 +1,152 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#ifndef LATTICE_REFERENCE_HPP
+#define LATTICE_REFERENCE_HPP
+#include <checker.hpp>
+#include <support.hpp>
+#include <type_lattice.hpp>
+#include <optional>
+#include <vector>
+
+//
+// The primitive type rules as they were written before type_lattice.hpp, kept as the reference
+// the lattice is checked against (tak_lattice_test) and timed against (tak_lattice_bench).
+// Combinations that used to panic (asking for the size of void) come back as std::nullopt.
+//
+
+namespace tak::reference {
+
+    inline bool has_size(const var_t type) {
+        return type != VAR_NONE && type != VAR_VOID;
+    }
+
+    inline bool promote_non_concrete(TypeData& left, const TypeData& right) {
+
+        const auto* pleft_t  = std::get_if<var_t>(&left.name);
+        const auto* pright_t = std::get_if<var_t>(&right.name);
+        const bool is_signed = PRIMITIVE_IS_SIGNED(*pleft_t) || PRIMITIVE_IS_SIGNED(*pright_t);
+
+        if(var_t_to_size_bytes(*pright_t) > var_t_to_size_bytes(*pleft_t)) {
+            left = right;
+        }
+
+        if(is_signed) {
+            switch(std::get<var_t>(left.name)) {
+                case VAR_U8:   left.name = VAR_I8;  break;
+                case VAR_U16:  left.name = VAR_I16; break;
+                case VAR_U32:  left.name = VAR_I32; break;
+                case VAR_U64:  left.name = VAR_I64; break;
+                default: break;
+            }
+        }
+
+        return true;
+    }
+
+    inline std::optional<bool> coercion_permissible(TypeData& left, const TypeData& right) {
+
+        if(types_are_identical(left, right)) {
+            return true;
+        }
+
+        size_t      ptr_count = 0;
+        const auto* left_t    = std::get_if<var_t>(&left.name);
+        const auto* right_t   = std::get_if<var_t>(&right.name);
+
+        if(left.flags  & TYPE_POINTER) ++ptr_count;
+        if(right.flags & TYPE_POINTER) ++ptr_count;
+
+        if(ptr_count == 2) return (left_t != nullptr && *left_t == VAR_VOID && left.pointer_depth == 1) || right.flags & TYPE_NON_CONCRETE;
+        if(ptr_count != 0) return false;
+
+        if(PRIMITIVE_IS_FLOAT(*right_t) && !PRIMITIVE_IS_FLOAT(*left_t)) {
+            return false;
+        }
+
+        if(!has_size(*left_t) || !has_size(*right_t)) {
+            return std::nullopt;
+        }
+
+        if(left.flags & TYPE_NON_CONCRETE) {
+            return promote_non_concrete(left, right);
+        }
+
+        return var_t_to_size_bytes(*right_t) <= var_t_to_size_bytes(*left_t);
+    }
+
+    inline bool cast_permissible(const TypeData& from, const TypeData& to) {
+
+        if(types_are_identical(from, to)) {
+            return true;
+        }
+
+        const auto* primfrom_t = std::get_if<var_t>(&from.name);
+        const auto* primto_t   = std::get_if<var_t>(&to.name);
+        size_t      ptr_count  = 0;
+
+        if(from.flags & TYPE_POINTER) ++ptr_count;
+        if(to.flags & TYPE_POINTER)   ++ptr_count;
+
+        if(ptr_count == 2 || ptr_count == 0) {
+            return true;
+        }
+
+        if(from.flags & TYPE_POINTER) {
+            return primto_t != nullptr && *primto_t == VAR_U64;
+        }
+
+        return primfrom_t != nullptr && *primfrom_t == VAR_U64;
+    }
+
+    inline std::optional<bool> operator_applicable(const token_t _operator, const TypeData& type) {
+
+        const bool is_mutable = !(type.flags & TYPE_CONSTANT) && !(type.flags & TYPE_RVALUE);
+
+        if(_operator == TOKEN_VALUE_ASSIGNMENT)  return is_mutable;
+        if(TOKEN_OP_IS_ARITH_ASSIGN(_operator))  return is_type_arithmetic_eligible(type, _operator) && is_mutable;
+        if(TOKEN_OP_IS_ARITHMETIC(_operator))    return is_type_arithmetic_eligible(type, _operator);
+        if(TOKEN_OP_IS_BW_ASSIGN(_operator))     return is_type_bwop_eligible(type) && is_mutable;
+        if(TOKEN_OP_IS_BITWISE(_operator))       return is_type_bwop_eligible(type);
+        if(TOKEN_OP_IS_LOGICAL(_operator))       return is_type_lop_eligible(type);
+
+        return std::nullopt; // Used to panic.
+    }
+
+
+    //
+    // Every primitive as a plain value, a pointer, a constant, an rvalue and a non-concrete literal.
+    //
+
+    inline std::vector<TypeData> make_operands() {
+
+        static constexpr uint64_t flag_sets[] = {
+            TYPE_FLAGS_NONE,
+            TYPE_CONSTANT,
+            TYPE_RVALUE,
+            TYPE_RVALUE | TYPE_CONSTANT | TYPE_NON_CONCRETE,
+        };
+
+        std::vector<TypeData> operands;
+        for(uint16_t i = 0; i < VAR_T_COUNT; ++i) {
+            for(const uint64_t flags : flag_sets) {
+                for(uint16_t depth = 0; depth < 2; ++depth) {
+                    if(depth > 0 && flags & TYPE_NON_CONCRETE) {
+                        continue;
+                    }
+
+                    auto& operand         = operands.emplace_back();
+                    operand.kind          = TYPE_KIND_VARIABLE;
+                    operand.name          = static_cast<var_t>(i);
+                    operand.flags         = flags | (depth > 0 ? TYPE_POINTER : TYPE_FLAGS_NONE);
+                    operand.pointer_depth = depth;
+                }
+            }
+        }
+
+        return operands;
+    }
+}
+
+#endif //LATTICE_REFERENCE_HPP
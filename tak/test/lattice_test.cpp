@@ -0,0 +1,84 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "lattice_reference.hpp"
+#include <type_lattice.hpp>
+#include <io.hpp>
+#include <cstdlib>
+
+//
+// Checks the primitive type lattice against the branch logic it replaced, for every pair of
+// primitive types and every operator, with and without pointers, constness and non-concrete operands.
+// Combinations that used to panic are skipped, the lattice just rejects those.
+//
+// usage: tak_lattice_test
+//
+
+using namespace tak;
+
+
+static bool
+same_result(const TypeData& first, const TypeData& second) {
+    return types_are_identical(first, second) && first.flags == second.flags;
+}
+
+static uint32_t
+check_equivalence(const std::vector<TypeData>& operands, uint64_t& compared) {
+
+    uint32_t mismatches = 0;
+    const auto mismatch = [&](const std::string_view what, const TypeData& left, const TypeData* right) {
+        if(++mismatches <= 10) {
+            print("MISMATCH: {} for {}{}{}", what, typedata_to_str_msg(left), right ? " and " : "", right ? typedata_to_str_msg(*right) : "");
+        }
+    };
+
+    for(const auto& left : operands) {
+        for(const auto& right : operands) {
+            TypeData new_left = left;
+            TypeData old_left = left;
+
+            const bool new_coerce = is_type_coercion_permissible(new_left, right);
+            const auto old_coerce = reference::coercion_permissible(old_left, right);
+
+            if(old_coerce && (*old_coerce != new_coerce || (new_coerce && !same_result(new_left, old_left)))) {
+                mismatch("coercion", left, &right);
+            }
+
+            if(reference::cast_permissible(left, right) != is_type_cast_permissible(left, right)) {
+                mismatch("cast", left, &right);
+            }
+
+            compared += 2;
+        }
+
+        for(uint32_t tok = 0; tok < TOKEN_T_COUNT; ++tok) {
+            const auto old_applicable = reference::operator_applicable(static_cast<token_t>(tok), left);
+            if(old_applicable && *old_applicable != can_operator_be_applied_to(static_cast<token_t>(tok), left)) {
+                mismatch(token_to_string(static_cast<token_t>(tok)), left, nullptr);
+            }
+
+            compared += old_applicable.has_value();
+        }
+    }
+
+    return mismatches;
+}
+
+
+int
+main() {
+
+    const auto     operands   = reference::make_operands();
+    uint64_t       compared   = 0;
+    const uint32_t mismatches = check_equivalence(operands, compared);
+
+    print("compared: {} queries over {} operand types", compared, operands.size());
+    if(mismatches > 0) {
+        print("{} mismatches.", mismatches);
+        return EXIT_FAILURE;
+    }
+
+    print("consistency: OK");
+    return EXIT_SUCCESS;
+}
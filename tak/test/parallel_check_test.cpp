@@ -0,0 +1,115 @@
+//
+// Created by Diago on 2026-10-18.
+//
+
+#include "program_gen.hpp"
+#include <driver.hpp>
+#include <checker.hpp>
+#include <io.hpp>
+#include <cstdlib>
+#include <sstream>
+
+//
+// Checks programs with method calls serially and on 2 and 4 threads, and compares the type and
+// constant ID of every node along with the error and warning counts. Checking a method call replaces
+// nodes in the tree, which parallel checking has to cope with.
+//
+// usage: tak_parallel_check_test
+//
+
+using namespace tak;
+
+
+struct CheckOutcome {
+    bool                                       parsed   = false;
+    uint32_t                                   errors   = 0;
+    uint32_t                                   warnings = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> ids;     // type_id and const_id of every node, in walk order.
+};
+
+static CheckOutcome
+check_source(const std::string& source, const uint32_t num_threads) {
+
+    CheckOutcome outcome;
+    Parser       parser;
+    Lexer        lexer;
+
+    lexer.src_.assign(source.begin(), source.end());
+    lexer.source_file_name_ = "parallel_check_test.tak";
+
+    if(!do_parse(parser, lexer)) {
+        return outcome;
+    }
+
+    CheckerContext ctx(lexer, parser);
+    if(num_threads > 1) {
+        visit_toplevel_parallel(ctx, num_threads);
+    } else {
+        visit_toplevel(ctx);
+    }
+
+    outcome.parsed   = true;
+    outcome.errors   = ctx.error_count_;
+    outcome.warnings = ctx.warning_count_;
+
+    for(auto* decl : parser.toplevel_decls_) {
+        walk_ast(decl, [&](const AstNode* node) {
+            outcome.ids.emplace_back(node->type_id, node->const_id);
+        });
+    }
+
+    return outcome;
+}
+
+static bool
+check_program(const std::string_view name, const std::string& source) {
+
+    const CheckOutcome serial = check_source(source, 1);
+    if(!serial.parsed) {
+        print("FAILED: {} did not parse.", name);
+        return false;
+    }
+
+    for(const uint32_t num_threads : {2u, 4u}) {
+        const CheckOutcome parallel = check_source(source, num_threads);
+        if(!parallel.parsed
+            || parallel.errors != serial.errors
+            || parallel.warnings != serial.warnings
+            || parallel.ids != serial.ids) {
+            print("FAILED: {} checked on {} threads differs from checking it serially.", name, num_threads);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int
+main() {
+
+    static constexpr std::string_view method_call =
+        "struct P { x : i32; }\n"
+        "compose P { get :: proc(self : P^) -> i32 { ret self.x; } }\n"
+        "f :: proc() -> i32 { p : P; ret p.get(); }\n"
+        "g :: proc() -> i32 { p : P; ret p.get() + 1; }\n"
+        "main :: proc() -> i32 { ret f() + g(); }\n";
+
+    std::ostringstream discarded;
+    redirect_output(&discarded);
+
+    ProgramShape shape;
+    shape.lines = 5'000;
+
+    const bool passed = check_program("a method call", std::string(method_call))
+        && check_program("a generated program", generate_program(shape));
+
+    redirect_output(nullptr);
+    if(!passed) {
+        print("{}", discarded.str());
+        return EXIT_FAILURE;
+    }
+
+    print("parallel check: OK");
+    return EXIT_SUCCESS;
+}